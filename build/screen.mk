@@ -77,6 +77,10 @@ SCREEN_SOURCES += \
 	$(SCREEN_SRC_DIR)/OpenGL/Shapes.cpp \
 	$(SCREEN_SRC_DIR)/OpenGL/Surface.cpp \
 	$(SCREEN_SRC_DIR)/OpenGL/Triangulate.cpp
+ifeq ($(FREETYPE),y)
+SCREEN_SOURCES += \
+	$(SCREEN_SRC_DIR)/OpenGL/GlyphAtlas.cpp
+endif
 endif
 
 ifeq ($(ENABLE_SDL),y)
@@ -145,7 +149,16 @@ GDI_LDLIBS += -Wl,-subsystem,windows
 endif
 endif
 
-SCREEN_CPPFLAGS = $(SDL_CPPFLAGS) $(GDI_CPPFLAGS) $(OPENGL_CPPFLAGS) $(FREETYPE_CPPFLAGS) $(LIBPNG_CPPFLAGS) $(LIBJPEG_CPPFLAGS) $(EGL_CPPFLAGS)
+# Generate the terrain image on all CPU cores.  This is only useful
+# without OpenGL, where the image is the bulk of the software
+# rendering work.
+PARALLEL_RASTER ?= n
+
+ifeq ($(OPENGL)$(PARALLEL_RASTER),ny)
+PARALLEL_RASTER_CPPFLAGS = -DENABLE_PARALLEL_RASTER
+endif
+
+SCREEN_CPPFLAGS = $(SDL_CPPFLAGS) $(GDI_CPPFLAGS) $(OPENGL_CPPFLAGS) $(FREETYPE_CPPFLAGS) $(LIBPNG_CPPFLAGS) $(LIBJPEG_CPPFLAGS) $(EGL_CPPFLAGS) $(PARALLEL_RASTER_CPPFLAGS)
 SCREEN_LDLIBS = $(SDL_LDLIBS) $(GDI_LDLIBS) $(OPENGL_LDLIBS) $(FREETYPE_LDLIBS) $(LIBPNG_LDLIBS) $(LIBJPEG_LDLIBS) $(EGL_LDLIBS)
 
 $(eval $(call link-library,screen,SCREEN))
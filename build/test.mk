@@ -83,11 +83,13 @@ TEST_NAMES = \
 	TestMathTables \
 	TestAngle TestUnits TestEarth TestSunEphemeris \
 	TestValidity TestUTM TestProfile \
-	TestRadixTree TestGeoBounds TestGeoClip \
+	TestRadixTree TestGeoBounds TestGeoClip TestLabelBlock \
 	TestLogger TestDriver TestClimbAvCalc \
 	TestWaypointReader TestThermalBase \
-	TestFlarmNet \
+	TestFlarmNet TestTrafficPredictor \
+	TestLiveTrack24Queue \
 	TestColorRamp TestGeoPoint TestDiffFilter \
+	TestRasterWeatherCache TestTerrainIntersection TestTerrainXSProfile \
 	TestFileUtil TestPolars TestCSVLine TestGlidePolar \
 	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
 	TestMacCready TestOrderedTask TestAATPoint \
@@ -110,6 +112,10 @@ TEST_NAMES = \
 	TestIGCFilenameFormatter \
 	TestLXNToIGC
 
+ifeq ($(OPENGL),y)
+TEST_NAMES += TestPackedTopography
+endif
+
 TESTS = $(call name-to-bin,$(TEST_NAMES))
 
 TEST_CRC_SOURCES = \
@@ -345,12 +351,73 @@ TEST_FLARM_NET_SOURCES = \
 TEST_FLARM_NET_DEPENDS = IO OS MATH UTIL
 $(eval $(call link-program,TestFlarmNet,TEST_FLARM_NET))
 
+TEST_TRAFFIC_PREDICTOR_SOURCES = \
+	$(SRC)/FLARM/TrafficPredictor.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTrafficPredictor.cpp
+TEST_TRAFFIC_PREDICTOR_DEPENDS = MATH
+$(eval $(call link-program,TestTrafficPredictor,TEST_TRAFFIC_PREDICTOR))
+
+TEST_LIVETRACK24_QUEUE_SOURCES = \
+	$(SRC)/Tracking/LiveTrack24Queue.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestLiveTrack24Queue.cpp
+TEST_LIVETRACK24_QUEUE_DEPENDS = MATH
+$(eval $(call link-program,TestLiveTrack24Queue,TEST_LIVETRACK24_QUEUE))
+
+TEST_RASTER_WEATHER_CACHE_SOURCES = \
+	$(SRC)/Terrain/RasterWeatherCache.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestRasterWeatherCache.cpp
+$(eval $(call link-program,TestRasterWeatherCache,TEST_RASTER_WEATHER_CACHE))
+
+TEST_TERRAIN_INTERSECTION_SOURCES = \
+	$(SRC)/Operation/Operation.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTerrainIntersection.cpp
+TEST_TERRAIN_INTERSECTION_DEPENDS = TERRAIN GEO MATH IO OS ZZIP UTIL
+$(eval $(call link-program,TestTerrainIntersection,TEST_TERRAIN_INTERSECTION))
+
+TEST_TERRAIN_XS_PROFILE_SOURCES = \
+	$(SRC)/CrossSection/TerrainXSProfile.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTerrainXSProfile.cpp
+TEST_TERRAIN_XS_PROFILE_DEPENDS = TERRAIN GEO MATH IO OS ZZIP UTIL
+$(eval $(call link-program,TestTerrainXSProfile,TEST_TERRAIN_XS_PROFILE))
+
+ifeq ($(OPENGL),y)
+TEST_PACKED_TOPOGRAPHY_SOURCES = \
+	$(SRC)/Topography/TopographyStore.cpp \
+	$(SRC)/Topography/TopographyFile.cpp \
+	$(SRC)/Topography/XShape.cpp \
+	$(SRC)/Topography/PackedTopographyWriter.cpp \
+	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Projection/WindowProjection.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(SCREEN_SRC_DIR)/OpenGL/Triangulate.cpp \
+	$(SCREEN_SRC_DIR)/OpenGL/Buffer.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestPackedTopography.cpp
+TEST_PACKED_TOPOGRAPHY_LDLIBS = $(OPENGL_LDLIBS)
+TEST_PACKED_TOPOGRAPHY_DEPENDS = GEO MATH IO OS UTIL SHAPELIB ZZIP
+TEST_PACKED_TOPOGRAPHY_CPPFLAGS = $(SCREEN_CPPFLAGS)
+$(eval $(call link-program,TestPackedTopography,TEST_PACKED_TOPOGRAPHY))
+endif
+
 TEST_GEO_CLIP_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestGeoClip.cpp
 TEST_GEO_CLIP_DEPENDS = GEO MATH
 $(eval $(call link-program,TestGeoClip,TEST_GEO_CLIP))
 
+TEST_LABEL_BLOCK_SOURCES = \
+	$(SRC)/Renderer/LabelBlock.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestLabelBlock.cpp
+TEST_LABEL_BLOCK_CPPFLAGS = $(SCREEN_CPPFLAGS)
+$(eval $(call link-program,TestLabelBlock,TEST_LABEL_BLOCK))
+
 TEST_CLIMB_AV_CALC_SOURCES = \
 	$(SRC)/Computer/ClimbAverageCalculator.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -641,7 +708,11 @@ DEBUG_PROGRAM_NAMES = \
 	RunOLCAnalysis \
 	FlightPath \
 	BenchmarkProjection \
+	BenchmarkLabelBlock \
+	BenchmarkNearestWaypoints \
 	BenchmarkFAITriangleSector \
+	BenchmarkMacCready \
+	BenchmarkVarioLatency \
 	DumpTextFile DumpTextZip WriteTextFile RunTextWriter \
 	DumpHexColor \
 	RunXMLParser \
@@ -694,6 +765,10 @@ DEBUG_PROGRAM_NAMES = \
 	RunKalmanFilter1d \
 	ArcApprox
 
+ifeq ($(OPENGL),y)
+DEBUG_PROGRAM_NAMES += PackTopography
+endif
+
 ifeq ($(TARGET),UNIX)
 DEBUG_PROGRAM_NAMES += \
 	AnalyseFlight \
@@ -786,12 +861,62 @@ BENCHMARK_PROJECTION_DEPENDS = MATH
 BENCHMARK_PROJECTION_CPPFLAGS = $(SCREEN_CPPFLAGS)
 $(eval $(call link-program,BenchmarkProjection,BENCHMARK_PROJECTION))
 
+BENCHMARK_LABEL_BLOCK_SOURCES = \
+	$(SRC)/Waypoint/WaypointFileType.cpp \
+	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointReader.cpp \
+	$(SRC)/Waypoint/WaypointReaderWinPilot.cpp \
+	$(SRC)/Waypoint/WaypointReaderFS.cpp \
+	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
+	$(SRC)/Waypoint/WaypointReaderSeeYou.cpp \
+	$(SRC)/Waypoint/WaypointReaderZander.cpp \
+	$(SRC)/Waypoint/WaypointReaderCompeGPS.cpp \
+	$(SRC)/Waypoint/WaypointWriter.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Compatibility/fmode.c \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/Topography/TopographyStore.cpp \
+	$(SRC)/Topography/TopographyFile.cpp \
+	$(SRC)/Topography/XShape.cpp \
+	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Projection/WindowProjection.cpp \
+	$(SRC)/Renderer/LabelBlock.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/BenchmarkLabelBlock.cpp
+ifeq ($(OPENGL),y)
+BENCHMARK_LABEL_BLOCK_SOURCES += \
+	$(SCREEN_SRC_DIR)/OpenGL/Triangulate.cpp \
+	$(SCREEN_SRC_DIR)/OpenGL/Buffer.cpp
+BENCHMARK_LABEL_BLOCK_LDLIBS = $(OPENGL_LDLIBS)
+endif
+BENCHMARK_LABEL_BLOCK_LDADD = $(FAKE_LIBS)
+BENCHMARK_LABEL_BLOCK_DEPENDS = WAYPOINT IO OS THREAD ZZIP SHAPELIB GEO MATH UTIL
+BENCHMARK_LABEL_BLOCK_CPPFLAGS = $(SCREEN_CPPFLAGS)
+$(eval $(call link-program,BenchmarkLabelBlock,BENCHMARK_LABEL_BLOCK))
+
 BENCHMARK_FAI_TRIANGLE_SECTOR_SOURCES = \
 	$(ENGINE_SRC_DIR)/Task/Shapes/FAITriangleArea.cpp \
 	$(TEST_SRC_DIR)/BenchmarkFAITriangleSector.cpp
 BENCHMARK_FAI_TRIANGLE_SECTOR_DEPENDS = GEO MATH
 $(eval $(call link-program,BenchmarkFAITriangleSector,BENCHMARK_FAI_TRIANGLE_SECTOR))
 
+BENCHMARK_MAC_CREADY_SOURCES = \
+	$(SRC)/Engine/Navigation/Aircraft.cpp \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/NMEA/FlyingState.cpp \
+	$(TEST_SRC_DIR)/BenchmarkMacCready.cpp
+BENCHMARK_MAC_CREADY_DEPENDS = TASK ROUTE GLIDE WAYPOINT GEO MATH UTIL
+$(eval $(call link-program,BenchmarkMacCready,BENCHMARK_MAC_CREADY))
+
+BENCHMARK_VARIO_LATENCY_SOURCES = \
+	$(SRC)/Audio/ToneSynthesiser.cpp \
+	$(SRC)/Audio/VarioSynthesiser.cpp \
+	$(TEST_SRC_DIR)/BenchmarkVarioLatency.cpp
+BENCHMARK_VARIO_LATENCY_DEPENDS = THREAD OS MATH UTIL
+$(eval $(call link-program,BenchmarkVarioLatency,BENCHMARK_VARIO_LATENCY))
+
 DUMP_TEXT_FILE_SOURCES = \
 	$(TEST_SRC_DIR)/DumpTextFile.cpp
 DUMP_TEXT_FILE_DEPENDS = IO OS ZZIP UTIL
@@ -1005,12 +1130,32 @@ LOAD_TOPOGRAPHY_SOURCES = \
 	$(TEST_SRC_DIR)/LoadTopography.cpp
 ifeq ($(OPENGL),y)
 LOAD_TOPOGRAPHY_SOURCES += \
-	$(SCREEN_SRC_DIR)/OpenGL/Triangulate.cpp
+	$(SCREEN_SRC_DIR)/OpenGL/Triangulate.cpp \
+	$(SCREEN_SRC_DIR)/OpenGL/Buffer.cpp
+LOAD_TOPOGRAPHY_LDLIBS = $(OPENGL_LDLIBS)
 endif
-LOAD_TOPOGRAPHY_DEPENDS = GEO MATH IO UTIL SHAPELIB ZZIP
+LOAD_TOPOGRAPHY_DEPENDS = GEO MATH IO OS UTIL SHAPELIB ZZIP
 LOAD_TOPOGRAPHY_CPPFLAGS = $(SCREEN_CPPFLAGS)
 $(eval $(call link-program,LoadTopography,LOAD_TOPOGRAPHY))
 
+ifeq ($(OPENGL),y)
+PACK_TOPOGRAPHY_SOURCES = \
+	$(SRC)/Topography/TopographyStore.cpp \
+	$(SRC)/Topography/TopographyFile.cpp \
+	$(SRC)/Topography/XShape.cpp \
+	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Projection/WindowProjection.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(SCREEN_SRC_DIR)/OpenGL/Triangulate.cpp \
+	$(SCREEN_SRC_DIR)/OpenGL/Buffer.cpp \
+	$(SRC)/Topography/PackedTopographyWriter.cpp \
+	$(topdir)/tools/PackTopography.cpp
+PACK_TOPOGRAPHY_LDLIBS = $(OPENGL_LDLIBS)
+PACK_TOPOGRAPHY_DEPENDS = GEO MATH IO OS UTIL SHAPELIB ZZIP
+PACK_TOPOGRAPHY_CPPFLAGS = $(SCREEN_CPPFLAGS)
+$(eval $(call link-program,PackTopography,PACK_TOPOGRAPHY))
+endif
+
 LOAD_TERRAIN_SOURCES = \
 	$(SRC)/Operation/Operation.cpp \
 	$(TEST_SRC_DIR)/LoadTerrain.cpp
@@ -1081,6 +1226,28 @@ NEAREST_WAYPOINTS_LDADD = $(FAKE_LIBS)
 NEAREST_WAYPOINTS_DEPENDS = WAYPOINT IO OS THREAD ZZIP GEO MATH UTIL
 $(eval $(call link-program,NearestWaypoints,NEAREST_WAYPOINTS))
 
+BENCHMARK_NEAREST_WAYPOINTS_SOURCES = \
+	$(SRC)/Waypoint/WaypointFileType.cpp \
+	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointReader.cpp \
+	$(SRC)/Waypoint/WaypointReaderWinPilot.cpp \
+	$(SRC)/Waypoint/WaypointReaderFS.cpp \
+	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
+	$(SRC)/Waypoint/WaypointReaderSeeYou.cpp \
+	$(SRC)/Waypoint/WaypointReaderZander.cpp \
+	$(SRC)/Waypoint/WaypointReaderCompeGPS.cpp \
+	$(SRC)/Waypoint/WaypointWriter.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Compatibility/fmode.c \
+	$(SRC)/Operation/Operation.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/BenchmarkNearestWaypoints.cpp
+BENCHMARK_NEAREST_WAYPOINTS_LDADD = $(FAKE_LIBS)
+BENCHMARK_NEAREST_WAYPOINTS_DEPENDS = WAYPOINT IO OS THREAD ZZIP GEO MATH UTIL
+$(eval $(call link-program,BenchmarkNearestWaypoints,BENCHMARK_NEAREST_WAYPOINTS))
+
 RUN_AIRSPACE_PARSER_SOURCES = \
 	$(SRC)/Airspace/AirspaceParser.cpp \
 	$(SRC)/Units/Descriptor.cpp \
@@ -1570,6 +1737,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/FLARM/Friends.cpp \
 	$(SRC)/FLARM/FriendsGlue.cpp \
 	$(SRC)/FLARM/List.cpp \
+	$(SRC)/FLARM/TrafficPredictor.cpp \
 	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
 	$(SRC)/Airspace/AirspaceParser.cpp \
 	$(SRC)/Airspace/AirspaceVisibility.cpp \
@@ -1587,6 +1755,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/MapWindow/MapWindowGlideRange.cpp \
 	$(SRC)/Projection/MapWindowProjection.cpp \
 	$(SRC)/MapWindow/MapWindowRender.cpp \
+	$(SRC)/MapWindow/MapLayerCache.cpp \
 	$(SRC)/MapWindow/MapWindowSymbols.cpp \
 	$(SRC)/MapWindow/MapWindowContest.cpp \
 	$(SRC)/MapWindow/MapWindowTask.cpp \
@@ -1602,6 +1771,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Renderer/TaskPointRenderer.cpp \
 	$(SRC)/Renderer/AircraftRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRenderer.cpp \
+	$(SRC)/Renderer/AirspacePolygonCache.cpp \
 	$(SRC)/Renderer/BestCruiseArrowRenderer.cpp \
 	$(SRC)/Renderer/CompassRenderer.cpp \
 	$(SRC)/Renderer/FinalGlideBarRenderer.cpp \
@@ -1652,6 +1822,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Task/RoutePlannerGlue.cpp \
 	$(SRC)/Topography/TopographyFile.cpp \
 	$(SRC)/Topography/TopographyStore.cpp \
+	$(SRC)/Topography/TopographyThread.cpp \
 	$(SRC)/Topography/TopographyFileRenderer.cpp \
 	$(SRC)/Topography/TopographyRenderer.cpp \
 	$(SRC)/Topography/TopographyGlue.cpp \
@@ -2089,6 +2260,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Look/ButtonLook.cpp \
 	$(SRC)/CrossSection/AirspaceXSRenderer.cpp \
 	$(SRC)/CrossSection/TerrainXSRenderer.cpp \
+	$(SRC)/CrossSection/TerrainXSProfile.cpp \
 	$(SRC)/CrossSection/CrossSectionRenderer.cpp \
 	$(SRC)/CrossSection/CrossSectionWindow.cpp \
 	$(SRC)/FlightStatistics.cpp \
@@ -2110,6 +2282,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Computer/ContestComputer.cpp \
 	$(SRC)/Computer/TraceComputer.cpp \
 	$(SRC)/Computer/WarningComputer.cpp \
+	$(SRC)/Computer/AirspaceXSComputer.cpp \
 	$(SRC)/Computer/LiftDatabaseComputer.cpp \
 	$(SRC)/Computer/AverageVarioComputer.cpp \
 	$(SRC)/Computer/GlideRatioComputer.cpp \
@@ -264,7 +264,9 @@ PCMPlayer::Start(PCMSynthesiser &_synthesiser, unsigned _sample_rate)
   spec.freq = sample_rate;
   spec.format = AUDIO_S16SYS;
   spec.channels = 2;
-  spec.samples = 4096;
+  /* small buffers keep the latency of the audio vario low (see
+     BenchmarkVarioLatency) */
+  spec.samples = 1024;
   spec.callback = ::Synthesise;
   spec.userdata = this;
 
@@ -25,31 +25,43 @@ Copyright_License {
 #include "Math/FastTrig.hpp"
 #include "Util/Macros.hpp"
 
+/**
+ * The number of #ISINETABLE index bits.
+ */
+static constexpr unsigned TABLE_BITS = 12;
+static_assert(ARRAY_SIZE(ISINETABLE) == 1u << TABLE_BITS,
+              "Wrong ISINETABLE size");
+
 void
 ToneSynthesiser::SetTone(unsigned sample_rate, unsigned tone_hz)
 {
-  increment = ARRAY_SIZE(ISINETABLE) * tone_hz / sample_rate;
+  increment = (uint32_t)(((uint64_t)tone_hz << 32) / sample_rate);
 }
 
 void
 ToneSynthesiser::Synthesise(int16_t *buffer, size_t n)
 {
-  assert(angle < ARRAY_SIZE(ISINETABLE));
+  /* copy the attributes to local variables, so the compiler can keep
+     them in registers */
+  uint32_t _phase = phase;
+  const uint32_t _increment = increment;
+  const int scale = 32767 * (int)volume / 100;
 
   for (int16_t *end = buffer + n; buffer != end; ++buffer) {
-    *buffer = ISINETABLE[angle] * (32767 / 1024) * (int)volume / 100;
-    angle = (angle + increment) & (ARRAY_SIZE(ISINETABLE) - 1);
+    *buffer = ISINETABLE[_phase >> (32 - TABLE_BITS)] * scale / 1024;
+    _phase += _increment;
   }
+
+  phase = _phase;
 }
 
 unsigned
 ToneSynthesiser::ToZero() const
 {
-  assert(angle < ARRAY_SIZE(ISINETABLE));
-
-  if (angle < increment)
-    /* close enough */
+  if (phase < increment || increment == 0)
+    /* close enough (or no tone at all) */
     return 0;
 
-  return (ARRAY_SIZE(ISINETABLE) - angle) / increment;
+  /* the number of samples until the phase wraps around */
+  return (uint32_t)-phase / increment;
 }
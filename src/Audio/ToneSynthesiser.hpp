@@ -28,14 +28,28 @@ Copyright_License {
 #include "Compiler.h"
 
 /**
- * This class generates tones with a sine wave.
+ * This class generates tones with a sine wave.  It is a phase
+ * accumulator which reads the sine wave from #ISINETABLE.
  */
 class ToneSynthesiser : public PCMSynthesiser {
-  unsigned volume, angle, increment;
+  unsigned volume;
+
+  /**
+   * The current phase.  The full 32 bit range is one period of the
+   * sine wave; the upper bits are the #ISINETABLE index.  The
+   * fraction bits allow a frequency resolution of far less than
+   * 1 Hz.
+   */
+  uint32_t phase;
+
+  /**
+   * The phase increment per sample.
+   */
+  uint32_t increment;
 
 public:
   constexpr
-  ToneSynthesiser():volume(100), angle(0), increment(0) {}
+  ToneSynthesiser():volume(100), phase(0), increment(0) {}
 
   /**
    * Set the (software) volume of the generated tone.
@@ -47,6 +61,11 @@ public:
     volume = _volume;
   }
 
+  /**
+   * Change the tone frequency.  The phase is preserved, so the new
+   * frequency takes effect with the next sample, without a
+   * discontinuity in the wave.
+   */
   void SetTone(unsigned sample_rate, unsigned tone_hz);
 
   /* methods from class PCMSynthesiser */
@@ -64,7 +83,7 @@ protected:
    * Start a new period.
    */
   void Restart() {
-    angle = 0;
+    phase = 0;
   }
 };
 
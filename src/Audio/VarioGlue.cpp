@@ -64,7 +64,7 @@ AudioVarioGlue::Initialise()
 #endif
 
   player = new PCMPlayer();
-  synthesiser = new VarioSynthesiser();
+  synthesiser = new VarioSynthesiser(sample_rate);
 }
 
 void
@@ -108,7 +108,7 @@ AudioVarioGlue::SetValue(fixed vario)
   assert(player != NULL);
   assert(synthesiser != NULL);
 
-  synthesiser->SetVario(sample_rate, vario);
+  synthesiser->SetVario(vario);
 }
 
 void
@@ -42,15 +42,17 @@ VarioSynthesiser::VarioToFrequency(int ivario)
 }
 
 void
-VarioSynthesiser::SetVario(unsigned sample_rate, fixed vario)
+VarioSynthesiser::SetVario(fixed vario)
 {
-  const ScopeLock protect(mutex);
-
-  const int ivario = Clamp((int)(vario * 100), min_vario, max_vario);
+  pending_vario = Clamp((int)(vario * 100), min_vario, max_vario);
+}
 
+void
+VarioSynthesiser::ApplyVario(int ivario)
+{
   if (dead_band_enabled && InDeadBand(ivario)) {
     /* inside the "dead band" */
-    UnsafeSetSilence();
+    ApplySilence();
     return;
   }
 
@@ -85,14 +87,7 @@ VarioSynthesiser::SetVario(unsigned sample_rate, fixed vario)
 }
 
 void
-VarioSynthesiser::SetSilence()
-{
-  const ScopeLock protect(mutex);
-  UnsafeSetSilence();
-}
-
-void
-VarioSynthesiser::UnsafeSetSilence()
+VarioSynthesiser::ApplySilence()
 {
   audible_count = 0;
   silence_count = 1;
@@ -106,11 +101,21 @@ VarioSynthesiser::UnsafeSetSilence()
   silence_remaining = 0;
 }
 
-
 void
 VarioSynthesiser::Synthesise(int16_t *buffer, size_t n)
 {
-  const ScopeLock protect(mutex);
+  /* pick up the most recent vario value and settings; they take
+     effect with the first sample of this buffer */
+  const int vario = pending_vario;
+  const bool changed = settings_changed.exchange(false);
+  if (changed || vario != current_vario) {
+    current_vario = vario;
+
+    if (vario == SILENCE)
+      ApplySilence();
+    else
+      ApplyVario(vario);
+  }
 
   assert(audible_count > 0 || silence_count > 0);
 
@@ -149,7 +154,14 @@ VarioSynthesiser::Synthesise(int16_t *buffer, size_t n)
       std::fill(buffer, buffer + o, 0);
       buffer += o;
       n -= o;
-      silence_remaining -= o;
+
+      /* in the "no sound" state (audible_count==0), the whole buffer
+         is filled with silence, which may be more than
+         silence_remaining; don't let it wrap around, or the next
+         tone would be delayed by a full silence period */
+      silence_remaining = o < silence_remaining
+        ? silence_remaining - o
+        : 0;
     } else {
       /* period finished, begin next one */
 
@@ -25,19 +25,40 @@ Copyright_License {
 #define XCSOAR_AUDIO_VARIO_SYNTHESISER_HPP
 
 #include "ToneSynthesiser.hpp"
-#include "Thread/Mutex.hpp"
 #include "Math/fixed.hpp"
 #include "Compiler.h"
 
+#include <atomic>
+
+#include <limits.h>
+
 /**
  * This class generates vario sound.
  */
 class VarioSynthesiser gcc_final : public ToneSynthesiser {
   /**
-   * This mutex protects all atttributes below.  It is locked
-   * automatically by all public methods.
+   * Magic value for #pending_vario and #current_vario: produce
+   * silence.
+   */
+  static constexpr int SILENCE = INT_MIN;
+
+  const unsigned sample_rate;
+
+  /**
+   * The most recent vario value [cm/s] submitted by SetVario(), or
+   * #SILENCE.  This is the channel between the thread which submits
+   * new values and the PCMPlayer thread: it is written by SetVario()
+   * and SetSilence(), and read by Synthesise() at the beginning of
+   * each buffer.  Neither side ever blocks.
+   */
+  std::atomic<int> pending_vario;
+
+  /**
+   * The vario value the following attributes were calculated for.
+   * This attribute and the sample counters are only used by
+   * Synthesise().
    */
-  Mutex mutex;
+  int current_vario;
 
   /**
    * The number of audible samples in each period.
@@ -57,6 +78,16 @@ class VarioSynthesiser gcc_final : public ToneSynthesiser {
    */
   size_t audible_remaining, silence_remaining;
 
+  /**
+   * Set by the setters below after they have modified a setting, and
+   * cleared by Synthesise(), which then re-applies the current vario
+   * value even if it has not changed.
+   */
+  std::atomic<bool> settings_changed;
+
+  /* the following settings are evaluated by Synthesise() when the
+     next vario value arrives or when #settings_changed is set */
+
   bool dead_band_enabled;
 
   /**
@@ -91,32 +122,40 @@ class VarioSynthesiser gcc_final : public ToneSynthesiser {
   int min_dead, max_dead;
 
 public:
-  VarioSynthesiser()
-    :audible_count(0), silence_count(1),
+  explicit VarioSynthesiser(unsigned _sample_rate)
+    :sample_rate(_sample_rate),
+     pending_vario(SILENCE), current_vario(SILENCE),
+     audible_count(0), silence_count(1),
      audible_remaining(0), silence_remaining(0),
+     settings_changed(false),
      dead_band_enabled(false),
      min_frequency(200), zero_frequency(500), max_frequency(1500),
      min_period_ms(150), max_period_ms(600),
      min_dead(-30), max_dead(10) {}
 
   /**
-   * Update the vario value.  This calculates a new tone frequency and
-   * a new "silence" rate (for positive vario values).
+   * Update the vario value.  The new tone frequency and "silence"
+   * rate (for positive vario values) will be calculated by the
+   * PCMPlayer thread when it synthesises the next buffer.  This
+   * method does not block.
    *
    * @param vario the current vario value [m/s]
    */
-  void SetVario(unsigned sample_rate, fixed vario);
+  void SetVario(fixed vario);
 
   /**
-   * Produce silence from now on.
+   * Produce silence from now on.  This method does not block.
    */
-  void SetSilence();
+  void SetSilence() {
+    pending_vario = SILENCE;
+  }
 
   /**
    * Enable/disable the dead band silence
    */
   void SetDeadBand(bool enabled) {
     dead_band_enabled = enabled;
+    settings_changed = true;
   }
 
   /**
@@ -126,6 +165,7 @@ public:
     min_frequency = min;
     zero_frequency = zero;
     max_frequency = max;
+    settings_changed = true;
   }
 
   /**
@@ -134,6 +174,7 @@ public:
   void SetPeriods(unsigned min, unsigned max) {
     min_period_ms = min;
     max_period_ms = max;
+    settings_changed = true;
   }
 
   /**
@@ -142,6 +183,7 @@ public:
   void SetDeadBandRange(fixed min, fixed max) {
     min_dead = (int)(min * 100);
     max_dead = (int)(max * 100);
+    settings_changed = true;
   }
 
   /* methods from class PCMSynthesiser */
@@ -149,9 +191,15 @@ public:
 
 private:
   /**
-   * Same as SetSilence(), but doesn't lock the mutex.
+   * Calculate a new tone frequency and period for the specified
+   * vario value [cm/s].  Called by Synthesise().
+   */
+  void ApplyVario(int ivario);
+
+  /**
+   * Switch to silence.  Called by Synthesise().
    */
-  void UnsafeSetSilence();
+  void ApplySilence();
 
   /**
    * Convert a vario value to a tone frequency.
@@ -0,0 +1,171 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "AirspaceXSComputer.hpp"
+#include "NMEA/MoreData.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "Airspace/AirspaceIntersectionVisitor.hpp"
+#include "Geo/GeoVector.hpp"
+
+#include <algorithm>
+
+#include <assert.h>
+
+/**
+ * The maximum distance between the far end of the cross-section and
+ * the line [m].
+ */
+static constexpr unsigned TOLERANCE = AirspaceXSComputer::RANGE / 64;
+
+/**
+ * Local visitor class which collects the airspace intersections
+ * along the line
+ */
+class AirspaceIntersectionVisitorSlice gcc_final
+  : public AirspaceIntersectionVisitor
+{
+  std::vector<AirspaceXSComputer::Intersection> &result;
+
+  /** GeoPoint at the origin of the line */
+  const GeoPoint origin;
+
+  /** The length of the line */
+  const fixed length;
+
+public:
+  AirspaceIntersectionVisitorSlice(std::vector<AirspaceXSComputer::Intersection> &_result,
+                                   const GeoPoint &_origin, fixed _length)
+    :result(_result), origin(_origin), length(_length) {}
+
+  virtual void Visit(const AbstractAirspace &as) gcc_override {
+    if (as.GetType() <= 0)
+      return;
+
+    for (const auto &i : intersections) {
+      const GeoPoint &p_start = i.first;
+      const GeoPoint &p_end = i.second;
+
+      AirspaceXSComputer::Intersection item;
+      item.airspace = &as;
+      item.start = origin.Distance(p_start);
+
+      // only one edge found, next edge must be beyond the line
+      item.end = p_start == p_end
+        ? length
+        : origin.Distance(p_end);
+
+      result.push_back(item);
+    }
+  }
+};
+
+void
+AirspaceXSComputer::Reset()
+{
+  mutex.Lock();
+  result.length = fixed(0);
+  result.intersections.clear();
+  mutex.Unlock();
+}
+
+void
+AirspaceXSComputer::AddConsumer()
+{
+  mutex.Lock();
+  ++num_consumers;
+  mutex.Unlock();
+}
+
+void
+AirspaceXSComputer::RemoveConsumer()
+{
+  mutex.Lock();
+  assert(num_consumers > 0);
+  --num_consumers;
+  mutex.Unlock();
+}
+
+void
+AirspaceXSComputer::LockedCopyTo(Result &dest) const
+{
+  mutex.Lock();
+  dest = result;
+  mutex.Unlock();
+}
+
+bool
+AirspaceXSComputer::IsUsable(const GeoPoint &location, Angle track) const
+{
+  if (!positive(result.length))
+    return false;
+
+  const Angle delta = track - result.bearing;
+  if (!positive(delta.cos()) ||
+      fixed(RANGE) * fabs(delta.sin()) > fixed(TOLERANCE))
+    return false;
+
+  const GeoVector v = result.origin.DistanceBearing(location);
+  const Angle v_delta = v.bearing - result.bearing;
+  const fixed along = v.distance * v_delta.cos();
+  return !negative(along) && along + fixed(RANGE) <= result.length &&
+    v.distance * fabs(v_delta.sin()) <= fixed(TOLERANCE);
+}
+
+void
+AirspaceXSComputer::Update(const MoreData &basic)
+{
+  if (!basic.location_available || !basic.track_available)
+    return;
+
+  mutex.Lock();
+  const bool visible = num_consumers > 0;
+  mutex.Unlock();
+
+  if (!visible)
+    /* nobody looks at the cross-section */
+    return;
+
+  /* reading #result without the lock is allowed, because only this
+     thread modifies it */
+  if (airspaces.GetSerial() == result.serial &&
+      IsUsable(basic.location, basic.track))
+    return;
+
+  Result new_result;
+  new_result.serial = airspaces.GetSerial();
+  new_result.origin = basic.location;
+  new_result.bearing = basic.track;
+  new_result.length = fixed(RANGE * 3 / 2);
+
+  AirspaceIntersectionVisitorSlice visitor(new_result.intersections,
+                                           new_result.origin,
+                                           new_result.length);
+  const GeoVector vec(new_result.length, new_result.bearing);
+  airspaces.VisitIntersecting(new_result.origin,
+                              vec.EndPoint(new_result.origin), visitor);
+
+  mutex.Lock();
+  std::swap(result, new_result);
+  mutex.Unlock();
+}
@@ -0,0 +1,137 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_AIRSPACE_XS_COMPUTER_HPP
+#define XCSOAR_AIRSPACE_XS_COMPUTER_HPP
+
+#include "Thread/Mutex.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Math/Angle.hpp"
+#include "Util/Serial.hpp"
+#include "Compiler.h"
+
+#include <vector>
+
+class Airspaces;
+class AbstractAirspace;
+struct MoreData;
+
+/**
+ * Calculates the airspaces crossed by a line along the current track,
+ * for the cross-section.  This runs in the #CalculationThread, so the
+ * user interface doesn't need to query the airspace database.
+ *
+ * The line is longer than the cross-section, and is recalculated only
+ * when the aircraft has used up the extra length, when it leaves the
+ * line, or when the airspace database changes.  Nothing is
+ * calculated while no cross-section is visible; see AddConsumer().
+ */
+class AirspaceXSComputer {
+public:
+  /**
+   * The range of the cross-section [m].  The line is 1.5 times as
+   * long.
+   */
+  static constexpr unsigned RANGE = 50000;
+
+  /**
+   * One section of an airspace crossed by the line.  The distances
+   * are relative to the origin of the line.
+   */
+  struct Intersection {
+    const AbstractAirspace *airspace;
+    fixed start, end;
+  };
+
+  struct Result {
+    /**
+     * The Airspaces::GetSerial() value the intersections were
+     * calculated for.  The #Intersection::airspace pointers must not
+     * be used when the database has been modified since then.
+     */
+    Serial serial;
+
+    GeoPoint origin;
+    Angle bearing;
+
+    /**
+     * The length of the line; zero if there is no result.
+     */
+    fixed length;
+
+    std::vector<Intersection> intersections;
+
+    Result():length(fixed(0)) {}
+  };
+
+private:
+  const Airspaces &airspaces;
+
+  /**
+   * This mutex protects #result: it must be locked while modifying
+   * it, and while reading it from a thread other than the
+   * #CalculationThread.
+   */
+  mutable Mutex mutex;
+
+  Result result;
+
+  /**
+   * The number of visible cross-sections which use the result.
+   * Update() does nothing while this is zero.  Protected by #mutex.
+   */
+  unsigned num_consumers;
+
+public:
+  AirspaceXSComputer(const Airspaces &_airspaces)
+    :airspaces(_airspaces), num_consumers(0) {}
+
+  void Reset();
+
+  /**
+   * Register a cross-section which is about to be shown.  Each call
+   * must be balanced by RemoveConsumer() when it gets hidden.  The
+   * mutex is locked, and the method may be called from any thread.
+   */
+  void AddConsumer();
+
+  void RemoveConsumer();
+
+  /**
+   * Copy the result.  The mutex is locked, and the method may be
+   * called from any thread.
+   */
+  void LockedCopyTo(Result &dest) const;
+
+  void Update(const MoreData &basic);
+
+private:
+  /**
+   * Does the current line cover the cross-section from the
+   * specified location and track?
+   */
+  gcc_pure
+  bool IsUsable(const GeoPoint &location, Angle track) const;
+};
+
+#endif
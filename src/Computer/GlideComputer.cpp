@@ -45,6 +45,7 @@ GlideComputer::GlideComputer(const Waypoints &_way_points,
   air_data_computer(_way_points),
   task_computer(task, _airspace_database),
   warning_computer(_airspace_database),
+  airspace_xs_computer(_airspace_database),
   waypoints(_way_points),
   team_code_ref_id(-1)
 {
@@ -158,6 +159,8 @@ GlideComputer::ProcessIdle(bool exhaustive)
   if (time_advanced())
     warning_computer.Update(GetComputerSettings(), Basic(), LastBasic(),
                             Calculated(), SetCalculated().airspace_warnings);
+
+  airspace_xs_computer.Update(Basic());
 }
 
 bool
@@ -32,6 +32,7 @@ Copyright_License {
 #include "TaskComputer.hpp"
 #include "LogComputer.hpp"
 #include "WarningComputer.hpp"
+#include "AirspaceXSComputer.hpp"
 #include "CuComputer.hpp"
 #include "Compiler.h"
 
@@ -52,6 +53,7 @@ class GlideComputer : public GlideComputerBlackboard
   LogComputer log_computer;
   CuComputer cu_computer;
   WarningComputer warning_computer;
+  AirspaceXSComputer airspace_xs_computer;
 
   const Waypoints &waypoints;
 
@@ -117,12 +119,21 @@ public:
     return task_computer.GetTraceComputer();
   }
 
+  const AirspaceXSComputer &GetAirspaceXSComputer() const {
+    return airspace_xs_computer;
+  }
+
+  AirspaceXSComputer &GetAirspaceXSComputer() {
+    return airspace_xs_computer;
+  }
+
   const ProtectedRoutePlanner &GetProtectedRoutePlanner() const {
     return task_computer.GetProtectedRoutePlanner();
   }
 
   void ClearAirspaces() {
     task_computer.ClearAirspaces();
+    airspace_xs_computer.Reset();
   }
 
   const FlightStatistics &GetFlightStats() const {
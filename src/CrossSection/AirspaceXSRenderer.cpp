@@ -21,16 +21,16 @@
 }
 */
 
-#include "CrossSectionRenderer.hpp"
+#include "AirspaceXSRenderer.hpp"
 #include "Renderer/ChartRenderer.hpp"
 #include "Screen/Canvas.hpp"
 #include "Screen/Layout.hpp"
 #include "Look/AirspaceLook.hpp"
-#include "Airspace/AirspaceIntersectionVisitor.hpp"
 #include "Airspace/AirspaceCircle.hpp"
 #include "Airspace/AirspacePolygon.hpp"
 #include "Renderer/AirspacePreviewRenderer.hpp"
 #include "Engine/Airspace/Airspaces.hpp"
+#include "Geo/GeoVector.hpp"
 #include "Navigation/Aircraft.hpp"
 
 #ifdef ENABLE_OPENGL
@@ -38,106 +38,90 @@
 #endif
 
 /**
- * Local visitor class used for rendering airspaces in the CrossSectionRenderer
+ * Render an airspace box to the canvas
+ * @param rc On-screen coordinates of the box
+ * @param type Airspace class
  */
-class AirspaceIntersectionVisitorSlice gcc_final
-  : public AirspaceIntersectionVisitor
+static void
+RenderBox(Canvas &canvas, const PixelRect rc, AirspaceClass type,
+          const AirspaceLook &airspace_look,
+          const AirspaceRendererSettings &settings)
 {
-  /** Canvas to draw on */
-  Canvas &canvas;
-  /** ChartRenderer for scaling the airspace CrossSection */
-  const ChartRenderer &chart;
-  /** MapSettings for reading airspace colors, pen and brushes */
-  const AirspaceRendererSettings &settings;
-
-  const AirspaceLook &airspace_look;
-
-  /** GeoPoint at the left of the CrossSection */
-  const GeoPoint start;
-  /** AltitudeState instance used for AGL-based airspaces */
-  const AltitudeState& state;
-
-public:
-  /**
-   * Constructor of the AirspaceIntersectionVisitorSlice class
-   * @param _canvas The canvas to draw to
-   * @param _chart ChartRenderer instance for scaling coordinates
-   * @param _settings settings for colors, pens and brushes
-   * @param _start GeoPoint at the left of the CrossSection
-   * @param _state AltitudeState instance used for AGL-based airspaces
-   */
-  AirspaceIntersectionVisitorSlice(Canvas &_canvas,
-                                   const ChartRenderer &_chart,
-                                   const AirspaceRendererSettings &_settings,
-                                   const AirspaceLook &_airspace_look,
-                                   const GeoPoint _start,
-                                   const AltitudeState& _state) :
-    canvas(_canvas), chart(_chart), settings(_settings),
-    airspace_look(_airspace_look),
-    start(_start), state(_state) {}
-
-  /**
-   * Render an airspace box to the canvas
-   * @param rc On-screen coordinates of the box
-   * @param brush Brush to use
-   * @param black Use black pen?
-   * @param type Airspace class
-   */
-  void
-  RenderBox(const PixelRect rc, AirspaceClass type) const
-  {
-    if (AirspacePreviewRenderer::PrepareFill(
-        canvas, type, airspace_look, settings)) {
-
-      // Draw thick brushed outlines
-      PixelScalar border_width = Layout::Scale(10);
-      if ((rc.right - rc.left) > border_width * 2 &&
-          (rc.bottom - rc.top) > border_width * 2 &&
-          settings.classes[type].fill_mode ==
-          AirspaceClassRendererSettings::FillMode::PADDING) {
-        PixelRect border = rc;
-        border.left += border_width;
-        border.right -= border_width;
-        border.top += border_width;
-        border.bottom -= border_width;
-
-        // Left border
-        canvas.Rectangle(rc.left, rc.top, border.left, rc.bottom);
-
-        // Right border
-        canvas.Rectangle(border.right, rc.top, rc.right, rc.bottom);
-
-        // Bottom border
-        canvas.Rectangle(border.left, border.bottom, border.right, rc.bottom);
-
-        // Top border
-        canvas.Rectangle(border.left, rc.top, border.right, border.top);
-      } else {
-        // .. or fill the entire rect if the outlines would overlap
-        canvas.Rectangle(rc.left, rc.top, rc.right, rc.bottom);
-      }
-
-      AirspacePreviewRenderer::UnprepareFill(canvas);
+  if (AirspacePreviewRenderer::PrepareFill(
+      canvas, type, airspace_look, settings)) {
+
+    // Draw thick brushed outlines
+    PixelScalar border_width = Layout::Scale(10);
+    if ((rc.right - rc.left) > border_width * 2 &&
+        (rc.bottom - rc.top) > border_width * 2 &&
+        settings.classes[type].fill_mode ==
+        AirspaceClassRendererSettings::FillMode::PADDING) {
+      PixelRect border = rc;
+      border.left += border_width;
+      border.right -= border_width;
+      border.top += border_width;
+      border.bottom -= border_width;
+
+      // Left border
+      canvas.Rectangle(rc.left, rc.top, border.left, rc.bottom);
+
+      // Right border
+      canvas.Rectangle(border.right, rc.top, rc.right, rc.bottom);
+
+      // Bottom border
+      canvas.Rectangle(border.left, border.bottom, border.right, rc.bottom);
+
+      // Top border
+      canvas.Rectangle(border.left, rc.top, border.right, border.top);
+    } else {
+      // .. or fill the entire rect if the outlines would overlap
+      canvas.Rectangle(rc.left, rc.top, rc.right, rc.bottom);
     }
 
-    // Use transparent brush and type-dependent pen for the outlines
-    if (AirspacePreviewRenderer::PrepareOutline(
-        canvas, type, airspace_look, settings))
-      canvas.Rectangle(rc.left, rc.top, rc.right, rc.bottom);
+    AirspacePreviewRenderer::UnprepareFill(canvas);
   }
 
-  /**
-   * Renders the AbstractAirspace on the canvas
-   * @param as AbstractAirspace to render
-   */
-  void Render(const AbstractAirspace &as) const {
-    AirspaceClass type = as.GetType();
-    if (type <= 0)
-      return;
+  // Use transparent brush and type-dependent pen for the outlines
+  if (AirspacePreviewRenderer::PrepareOutline(
+      canvas, type, airspace_look, settings))
+    canvas.Rectangle(rc.left, rc.top, rc.right, rc.bottom);
+}
+
+void
+AirspaceXSRenderer::Update(const AirspaceXSComputer &computer,
+                           const GeoPoint &start)
+{
+  computer.LockedCopyTo(result);
+
+  if (!positive(result.length)) {
+    offset = fixed(0);
+    return;
+  }
+
+  /* the line may lag behind the aircraft by one calculation cycle;
+     project the start onto it */
+  const GeoVector v = result.origin.DistanceBearing(start);
+  offset = v.distance * (v.bearing - result.bearing).cos();
+}
+
+void
+AirspaceXSRenderer::Draw(Canvas &canvas, const ChartRenderer &chart,
+                         const Airspaces &database,
+                         const AircraftState &state) const
+{
+  if (database.GetSerial() != result.serial)
+    /* the airspaces have been reloaded; the pointers may be
+       dangling */
+    return;
+
+  const fixed max_distance = chart.GetXMax();
 
-    // No intersections for this airspace
-    if (intersections.empty())
-      return;
+  for (const auto &i : result.intersections) {
+    const fixed start = i.start - offset, end = i.end - offset;
+    if (!positive(end) || start >= max_distance)
+      continue;
+
+    const AbstractAirspace &as = *i.airspace;
 
     PixelRect rcd;
     // Calculate top and bottom coordinate
@@ -147,38 +131,10 @@ public:
     else
       rcd.bottom = chart.ScreenY(as.GetBaseAltitude(state));
 
-    // Iterate through the intersections
-    for (const auto &i : intersections) {
-      const GeoPoint &p_start = i.first;
-      const GeoPoint &p_end = i.second;
-
-      rcd.left = chart.ScreenX(start.Distance(p_start));
+    rcd.left = chart.ScreenX(std::max(start, fixed(0)));
+    rcd.right = chart.ScreenX(std::min(end, max_distance));
 
-      // only one edge found, next edge must be beyond screen
-      if (p_start == p_end)
-        rcd.right = chart.ScreenX(chart.GetXMax());
-      else
-        rcd.right = chart.ScreenX(start.Distance(p_end));
-
-      // Draw the airspace
-      RenderBox(rcd, type);
-    }
+    // Draw the airspace
+    RenderBox(canvas, rcd, as.GetType(), look, settings);
   }
-
-  virtual void Visit(const AbstractAirspace &as) gcc_override {
-    Render(as);
-  }
-};
-
-void
-AirspaceXSRenderer::Draw(Canvas &canvas, const ChartRenderer &chart,
-                         const Airspaces &database, const GeoPoint &start,
-                         const GeoVector &vec, const AircraftState &state) const
-{
-  // Create IntersectionVisitor to render to the canvas
-  AirspaceIntersectionVisitorSlice ivisitor(
-      canvas, chart, settings, look, start, state);
-
-  // Call visitor with intersecting airspaces
-  database.VisitIntersecting(start, vec.EndPoint(start), ivisitor);
 }
@@ -25,13 +25,14 @@
 #define AIRSPACE_CROSS_SECTION_RENDERER_HPP
 
 #include "Renderer/AirspaceRendererSettings.hpp"
+#include "Computer/AirspaceXSComputer.hpp"
+#include "Math/fixed.hpp"
 
 struct AirspaceLook;
 class Canvas;
 class ChartRenderer;
 class Airspaces;
 struct GeoPoint;
-struct GeoVector;
 struct AircraftState;
 
 /**
@@ -39,17 +40,47 @@ struct AircraftState;
  */
 class AirspaceXSRenderer
 {
+private:
   AirspaceRendererSettings settings;
 
   const AirspaceLook &look;
 
+  /**
+   * A copy of the intersections calculated by #AirspaceXSComputer.
+   */
+  AirspaceXSComputer::Result result;
+
+  /**
+   * The distance between the origin of the line and the left side of
+   * the chart.
+   */
+  fixed offset;
+
 public:
-  AirspaceXSRenderer(const AirspaceLook &_look): look(_look) {}
+  AirspaceXSRenderer(const AirspaceLook &_look)
+    :look(_look), offset(fixed(0)) {}
+
+  /**
+   * Copy the latest intersections from the #AirspaceXSComputer.
+   *
+   * @param start the left side of the chart
+   */
+  void Update(const AirspaceXSComputer &computer, const GeoPoint &start);
+
+  /**
+   * Forget all intersections.
+   */
+  void Clear() {
+    result.length = fixed(0);
+    result.intersections.clear();
+  }
 
+  /**
+   * Draw the intersections, unless the airspace database has been
+   * modified since they were calculated.
+   */
   void Draw(Canvas &canvas, const ChartRenderer &chart,
-            const Airspaces &database,
-            const GeoPoint &start, const GeoVector &vec,
-            const AircraftState &state) const;
+            const Airspaces &database, const AircraftState &state) const;
 
   void SetSettings(const AirspaceRendererSettings &_settings) {
     settings = _settings;
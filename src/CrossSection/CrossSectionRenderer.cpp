@@ -30,6 +30,7 @@
 #include "Units/Units.hpp"
 #include "NMEA/Aircraft.hpp"
 #include "Navigation/Aircraft.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
 
 #ifdef ENABLE_OPENGL
 #include "Screen/OpenGL/Scope.hpp"
@@ -40,6 +41,7 @@ CrossSectionRenderer::CrossSectionRenderer(const CrossSectionLook &_look,
                                        const ChartLook &_chart_look)
   :look(_look), chart_look(_chart_look), airspace_renderer(_airspace_look),
   terrain_renderer(look), terrain(NULL), airspace_database(NULL),
+  airspace_computer(NULL),
   start(Angle::Zero(), Angle::Zero()),
    vec(fixed(50000), Angle::Zero()) {}
 
@@ -53,6 +55,43 @@ CrossSectionRenderer::ReadBlackboard(const MoreData &_gps_info,
   airspace_renderer.SetSettings(ar_settings);
 }
 
+void
+CrossSectionRenderer::Update()
+{
+  if (!vec.IsValid() || !start.IsValid())
+    return;
+
+  terrain_profile.Move(start, vec);
+
+  UpdateTerrain();
+  UpdateAirspace();
+}
+
+void
+CrossSectionRenderer::UpdateTerrain()
+{
+  if (terrain == NULL) {
+    terrain_profile.Clear();
+    return;
+  }
+
+  RasterTerrain::Lease map(*terrain);
+  terrain_profile.Update(map);
+}
+
+void
+CrossSectionRenderer::UpdateAirspace()
+{
+  if (airspace_computer == NULL) {
+    airspace_renderer.Clear();
+    return;
+  }
+
+  /* the airspace database is queried by the calculation thread; just
+     copy its result */
+  airspace_renderer.Update(*airspace_computer, start);
+}
+
 void
 CrossSectionRenderer::Paint(Canvas &canvas, const PixelRect rc) const
 {
@@ -79,38 +118,15 @@ CrossSectionRenderer::Paint(Canvas &canvas, const PixelRect rc) const
   chart.ScaleYFromValue(hmin);
   chart.ScaleYFromValue(hmax);
 
-  short elevations[NUM_SLICES];
-  UpdateTerrain(elevations);
-
-  if (airspace_database)
-    airspace_renderer.Draw(canvas, chart, *airspace_database, start, vec,
+  if (airspace_database != NULL)
+    airspace_renderer.Draw(canvas, chart, *airspace_database,
                            ToAircraftState(Basic(), Calculated()));
-  terrain_renderer.Draw(canvas, chart, elevations);
+  terrain_renderer.Draw(canvas, chart, terrain_profile.GetElevations());
   PaintGlide(chart);
   PaintAircraft(canvas, chart, rc);
   PaintGrid(canvas, chart);
 }
 
-void
-CrossSectionRenderer::UpdateTerrain(short *elevations) const
-{
-  if (terrain == NULL) {
-    const auto invalid = RasterBuffer::TERRAIN_INVALID;
-    std::fill(elevations, elevations + NUM_SLICES, invalid);
-    return;
-  }
-
-  const GeoPoint point_diff = vec.EndPoint(start) - start;
-
-  RasterTerrain::Lease map(*terrain);
-  for (unsigned i = 0; i < NUM_SLICES; ++i) {
-    const fixed slice_distance_factor = fixed(i) / (NUM_SLICES - 1);
-    const GeoPoint slice_point = start + point_diff * slice_distance_factor;
-
-    elevations[i] = map->GetHeight(slice_point);
-  }
-}
-
 void
 CrossSectionRenderer::PaintGlide(ChartRenderer &chart) const
 {
@@ -27,6 +27,7 @@
 #include "Blackboard/BaseBlackboard.hpp"
 #include "TerrainXSRenderer.hpp"
 #include "AirspaceXSRenderer.hpp"
+#include "TerrainXSProfile.hpp"
 
 struct PixelRect;
 struct MoreData;
@@ -35,6 +36,7 @@ struct AirspaceLook;
 struct ChartLook;
 struct AirspaceRendererSettings;
 class Airspaces;
+class AirspaceXSComputer;
 class RasterTerrain;
 class ChartRenderer;
 class Canvas;
@@ -46,11 +48,7 @@ class CrossSectionRenderer :
   public BaseBlackboard
 {
 public:
-#ifdef _WIN32_WCE
-  static constexpr unsigned NUM_SLICES = 16;
-#else
-  static constexpr unsigned NUM_SLICES = 64;
-#endif
+  static constexpr unsigned NUM_SLICES = TerrainXSProfile::NUM_SLICES;
 
 protected:
   const CrossSectionLook &look;
@@ -65,11 +63,20 @@ protected:
   /** Pointer to an airspace database instance or NULL */
   const Airspaces *airspace_database;
 
+  /**
+   * Calculates the airspace intersections in the calculation thread;
+   * may be NULL
+   */
+  const AirspaceXSComputer *airspace_computer;
+
   /** Left side of the CrossSectionWindow */
   GeoPoint start;
   /** Range and direction of the CrossSection */
   GeoVector vec;
 
+  /** The terrain profile, passed to TerrainXSRenderer */
+  TerrainXSProfile terrain_profile;
+
 public:
   /**
    * Constructor. Initializes most class members.
@@ -82,6 +89,14 @@ public:
                       const DerivedInfo &_calculated_info,
                       const AirspaceRendererSettings &ar_settings);
 
+  /**
+   * Update the cached terrain profile and copy the airspace
+   * intersections after the start point, direction or range have
+   * been changed.  Call this before Paint(); the expensive part is
+   * skipped while the aircraft moves along the same track.
+   */
+  void Update();
+
   /**
    * Renders the CrossSection to the given canvas in the given PixelRect
    * @param canvas Canvas to draw on
@@ -95,6 +110,16 @@ public:
    */
   void SetAirspaces(const Airspaces *_airspace_database) {
     airspace_database = _airspace_database;
+    airspace_renderer.Clear();
+  }
+
+  /**
+   * Set the computer which provides the airspace intersections
+   * @param _computer Pointer to the computer or NULL
+   */
+  void SetAirspaceComputer(const AirspaceXSComputer *_computer) {
+    airspace_computer = _computer;
+    airspace_renderer.Clear();
   }
 
   /**
@@ -103,6 +128,7 @@ public:
    */
   void SetTerrain(const RasterTerrain *_terrain) {
     terrain = _terrain;
+    terrain_profile.Invalidate();
   }
 
   /**
@@ -135,7 +161,8 @@ public:
   }
 
 protected:
-  void UpdateTerrain(short *elevations) const;
+  void UpdateTerrain();
+  void UpdateAirspace();
 
   void PaintGlide(ChartRenderer &chart) const;
   void PaintAircraft(Canvas &canvas, const ChartRenderer &chart,
@@ -27,6 +27,7 @@
 #include "Look/Look.hpp"
 #include "Interface.hpp"
 #include "Components.hpp"
+#include "Computer/GlideComputer.hpp"
 
 void
 CrossSectionWidget::Prepare(ContainerWindow &parent, const PixelRect &rc)
@@ -39,6 +40,8 @@ CrossSectionWidget::Prepare(ContainerWindow &parent, const PixelRect &rc)
   CrossSectionWindow *w =
     new CrossSectionWindow(look.cross_section, look.map.airspace, look.chart);
   w->SetAirspaces(&airspace_database);
+  if (glide_computer != NULL)
+    w->SetAirspaceComputer(&glide_computer->GetAirspaceXSComputer());
   w->SetTerrain(terrain);
   w->Create(parent, rc, style);
 
@@ -54,6 +57,26 @@ CrossSectionWidget::Unprepare()
   DeleteWindow();
 }
 
+void
+CrossSectionWidget::Show(const PixelRect &rc)
+{
+  /* let the calculation thread query the airspaces while we're
+     visible */
+  if (glide_computer != NULL)
+    glide_computer->GetAirspaceXSComputer().AddConsumer();
+
+  WindowWidget::Show(rc);
+}
+
+void
+CrossSectionWidget::Hide()
+{
+  WindowWidget::Hide();
+
+  if (glide_computer != NULL)
+    glide_computer->GetAirspaceXSComputer().RemoveConsumer();
+}
+
 void
 CrossSectionWidget::OnCalculatedUpdate(const MoreData &basic,
                                        const DerivedInfo &calculated)
@@ -69,5 +92,6 @@ CrossSectionWidget::OnCalculatedUpdate(const MoreData &basic,
   } else
     w.SetInvalid();
 
+  w.Update();
   w.Invalidate();
 }
@@ -35,6 +35,8 @@ public:
   virtual void Prepare(ContainerWindow &parent,
                        const PixelRect &rc) gcc_override;
   virtual void Unprepare() gcc_override;
+  virtual void Show(const PixelRect &rc) gcc_override;
+  virtual void Hide() gcc_override;
 
 private:
   /* virtual methods from class BlackboardListener */
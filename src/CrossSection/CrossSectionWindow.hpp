@@ -34,6 +34,7 @@ struct MoreData;
 struct DerivedInfo;
 struct AirspaceRendererSettings;
 class Airspaces;
+class AirspaceXSComputer;
 class RasterTerrain;
 
 /**
@@ -68,6 +69,14 @@ public:
     renderer.SetAirspaces(airspace_database);
   }
 
+  /**
+   * Set the computer which provides the airspace intersections
+   * @param computer Pointer to the computer or NULL
+   */
+  void SetAirspaceComputer(const AirspaceXSComputer *computer) {
+    renderer.SetAirspaceComputer(computer);
+  }
+
   /**
    * Set RasterTerrain to use
    * @param _terrain Pointer to the RasterTerrain or NULL
@@ -104,6 +113,15 @@ public:
     renderer.SetInvalid();
   }
 
+  /**
+   * Update the cached terrain profile and airspace intersections.
+   * Call this after changing the start point, direction or range,
+   * before the window gets painted.
+   */
+  void Update() {
+    renderer.Update();
+  }
+
 protected:
   /**
    * OnPaint event called by the message loop
@@ -0,0 +1,138 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "TerrainXSProfile.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/RasterBuffer.hpp"
+
+#include <algorithm>
+
+#include <assert.h>
+
+TerrainXSProfile::TerrainXSProfile()
+  :origin(Angle::Zero(), Angle::Zero()), bearing(Angle::Zero()),
+   step(fixed(0)), offset(fixed(0)), profile_valid(0)
+{
+  Clear();
+}
+
+void
+TerrainXSProfile::Clear()
+{
+  const auto invalid = RasterBuffer::TERRAIN_INVALID;
+  std::fill(elevations, elevations + NUM_SLICES, invalid);
+  profile_valid = 0;
+}
+
+bool
+TerrainXSProfile::IsCacheUsable(const GeoPoint &start, const GeoVector &vec,
+                                fixed &along) const
+{
+  if (!positive(step) ||
+      step != vec.distance / (NUM_SLICES - 1))
+    return false;
+
+  /* the far end of the new line must not deviate from the cached
+     line by more than one sample */
+  const Angle delta = vec.bearing - bearing;
+  if (!positive(delta.cos()) ||
+      vec.distance * fabs(delta.sin()) > step)
+    return false;
+
+  const GeoVector v = origin.DistanceBearing(start);
+  const Angle v_delta = v.bearing - bearing;
+  along = v.distance * v_delta.cos();
+  return !negative(along) && along < vec.distance &&
+    v.distance * fabs(v_delta.sin()) <= Half(step);
+}
+
+void
+TerrainXSProfile::ShiftCache(unsigned n)
+{
+  /* the far end must remain ahead of the new origin */
+  assert(n > 0 && n < NUM_SLICES);
+
+  /* the bearing of a great circle changes along the way; aim at the
+     old far end, so the new samples stay on the same line */
+  const GeoPoint end = GeoVector(step * NUM_SLICES, bearing).EndPoint(origin);
+
+  const fixed distance = step * n;
+  origin = GeoVector(distance, bearing).EndPoint(origin);
+  bearing = origin.Bearing(end);
+  offset -= distance;
+
+  std::copy(profile + n, profile + NUM_SLICES + 1, profile);
+  profile_valid = profile_valid > n ? profile_valid - n : 0;
+}
+
+void
+TerrainXSProfile::Move(const GeoPoint &start, const GeoVector &vec)
+{
+  fixed along;
+  if (IsCacheUsable(start, vec, along)) {
+    offset = along;
+
+    const unsigned n = (unsigned)(offset / step);
+    if (n > 0)
+      ShiftCache(n);
+  } else {
+    origin = start;
+    bearing = vec.bearing;
+    step = vec.distance / (NUM_SLICES - 1);
+    offset = fixed(0);
+    profile_valid = 0;
+  }
+}
+
+void
+TerrainXSProfile::Update(const RasterMap &map)
+{
+  if (map.GetSerial() != terrain_serial) {
+    /* new terrain tiles have been loaded */
+    terrain_serial = map.GetSerial();
+    profile_valid = 0;
+  }
+
+  for (unsigned i = profile_valid; i <= NUM_SLICES; ++i) {
+    const GeoPoint slice_point =
+      GeoVector(step * i, bearing).EndPoint(origin);
+    profile[i] = map.GetHeight(slice_point);
+  }
+
+  profile_valid = NUM_SLICES + 1;
+
+  /* resample the profile at the cross-section start; all slices
+     have the same fractional offset */
+  const fixed ratio = offset / step;
+  const bool nearest_right = ratio >= fixed(0.5);
+  for (unsigned i = 0; i < NUM_SLICES; ++i) {
+    const short a = profile[i], b = profile[i + 1];
+    if (RasterBuffer::IsSpecial(a) || RasterBuffer::IsSpecial(b))
+      /* don't mix water or unknown terrain with real elevations */
+      elevations[i] = nearest_right ? b : a;
+    else
+      /* round, because #offset may be a tiny bit short of a whole
+         sample */
+      elevations[i] = a + (short)iround(fixed(b - a) * ratio);
+  }
+}
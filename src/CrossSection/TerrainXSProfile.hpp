@@ -0,0 +1,150 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_XS_PROFILE_HPP
+#define XCSOAR_TERRAIN_XS_PROFILE_HPP
+
+#include "Geo/GeoPoint.hpp"
+#include "Geo/GeoVector.hpp"
+#include "Util/Serial.hpp"
+#include "Compiler.h"
+
+class RasterMap;
+
+/**
+ * The terrain profile of the cross-section.  The samples are cached
+ * along a line which is shifted forward as the aircraft advances
+ * along the same track, so only the new samples at the far end need
+ * to be looked up in the terrain map.
+ */
+class TerrainXSProfile {
+public:
+#ifdef _WIN32_WCE
+  static constexpr unsigned NUM_SLICES = 16;
+#else
+  static constexpr unsigned NUM_SLICES = 64;
+#endif
+
+private:
+  /**
+   * The start of the track-aligned line the cached terrain profile
+   * refers to.
+   */
+  GeoPoint origin;
+  Angle bearing;
+
+  /** Distance between two terrain samples; zero if the cache is empty */
+  fixed step;
+
+  /** Distance between #origin and the cross-section start along the line */
+  fixed offset;
+
+  /**
+   * Terrain samples along the line, #step apart, beginning at
+   * #origin.  The last one is needed to interpolate at #offset.
+   */
+  short profile[NUM_SLICES + 1];
+
+  /** The number of leading #profile elements which are up to date */
+  unsigned profile_valid;
+
+  Serial terrain_serial;
+
+  /** The profile resampled at the cross-section start */
+  short elevations[NUM_SLICES];
+
+public:
+  TerrainXSProfile();
+
+  /**
+   * Discard the cached samples, e.g. because another terrain map is
+   * used.
+   */
+  void Invalidate() {
+    profile_valid = 0;
+  }
+
+  /**
+   * Mark all elevations invalid, because there is no terrain.
+   */
+  void Clear();
+
+  /**
+   * Move the cross-section.  The cached samples are reused if the
+   * new line lies on the cached one, and discarded otherwise.
+   *
+   * @param start the start point of the cross-section
+   * @param vec the range and direction of the cross-section
+   */
+  void Move(const GeoPoint &start, const GeoVector &vec);
+
+  /**
+   * Look up the missing samples in the terrain map and calculate the
+   * elevations.  Call this after Move().
+   */
+  void Update(const RasterMap &map);
+
+  const GeoPoint &GetOrigin() const {
+    return origin;
+  }
+
+  Angle GetBearing() const {
+    return bearing;
+  }
+
+  fixed GetStep() const {
+    return step;
+  }
+
+  /**
+   * Returns the #NUM_SLICES + 1 samples along the cached line,
+   * beginning at GetOrigin().
+   */
+  const short *GetProfile() const {
+    return profile;
+  }
+
+  /**
+   * Returns the #NUM_SLICES elevations along the cross-section.
+   */
+  const short *GetElevations() const {
+    return elevations;
+  }
+
+private:
+  /**
+   * Can the cached line be reused for the specified cross-section?
+   * If yes, the distance of #start along the line is returned in
+   * #along.
+   */
+  gcc_pure
+  bool IsCacheUsable(const GeoPoint &start, const GeoVector &vec,
+                     fixed &along) const;
+
+  /**
+   * Move #origin forward by the specified number of samples.
+   */
+  void ShiftCache(unsigned n);
+};
+
+#endif
@@ -90,6 +90,11 @@ static ChartControl *wGrid = NULL;
 static WndFrame *wInfo;
 static WndButton *wCalc = NULL;
 static CrossSectionWindow *csw = NULL;
+
+/**
+ * Is the cross-section registered with the #AirspaceXSComputer?
+ */
+static bool cross_section_visible = false;
 static GestureManager gestures;
 
 class CrossSectionControl: public CrossSectionWindow
@@ -264,6 +269,28 @@ UpdateCrossSection()
     csw->SetStart(basic.location);
   } else
     csw->SetInvalid();
+
+  csw->Update();
+}
+
+/**
+ * Register or unregister the cross-section with the
+ * #AirspaceXSComputer, which queries the airspaces only while a
+ * cross-section is visible.
+ */
+static void
+SetCrossSectionVisible(bool visible)
+{
+  if (visible == cross_section_visible)
+    return;
+
+  cross_section_visible = visible;
+
+  AirspaceXSComputer &computer = glide_computer->GetAirspaceXSComputer();
+  if (visible)
+    computer.AddConsumer();
+  else
+    computer.RemoveConsumer();
 }
 
 static void
@@ -377,6 +404,7 @@ Update()
 
   switch (page) {
   case AnalysisPage::AIRSPACE:
+    SetCrossSectionVisible(true);
     UpdateCrossSection();
     csw->Invalidate();
     csw->Show();
@@ -384,6 +412,7 @@ Update()
     break;
 
   default:
+    SetCrossSectionVisible(false);
     csw->Hide();
     wGrid->Show();
     wGrid->Invalidate();
@@ -545,6 +574,8 @@ OnCreateCrossSectionControl(ContainerWindow &parent, PixelRect rc,
                                 look->chart);
   csw->Create(parent, rc, style);
   csw->SetAirspaces(airspaces);
+  if (glide_computer != NULL)
+    csw->SetAirspaceComputer(&glide_computer->GetAirspaceXSComputer());
   csw->SetTerrain(terrain);
   UpdateCrossSection();
   return csw;
@@ -606,5 +637,7 @@ dlgAnalysisShowModal(SingleWindow &parent, const Look &_look,
   wf->ShowModal();
   update_timer.Cancel();
 
+  SetCrossSectionVisible(false);
+
   delete wf;
 }
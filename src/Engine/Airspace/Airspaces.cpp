@@ -251,6 +251,7 @@ Airspaces::Add(AbstractAirspace *airspace)
   }
 
   tmp_as.push_back(airspace);
+  ++serial;
 }
 
 void
@@ -275,6 +276,7 @@ Airspaces::clear()
 
   // then delete the tree
   airspace_tree.clear();
+  ++serial;
 }
 
 unsigned
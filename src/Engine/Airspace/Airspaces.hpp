@@ -26,6 +26,7 @@
 #include "AirspaceActivity.hpp"
 #include "Predicate/AirspacePredicate.hpp"
 #include "Util/NonCopyable.hpp"
+#include "Util/Serial.hpp"
 #include "Geo/Flat/TaskProjection.hpp"
 #include "Atmosphere/Pressure.hpp"
 #include "Compiler.h"
@@ -75,6 +76,11 @@ class Airspaces:
 
   std::deque< AbstractAirspace* > tmp_as;
 
+  /**
+   * Incremented whenever an airspace is added or deleted.
+   */
+  Serial serial;
+
 public:
   /** 
    * Constructor.
@@ -250,6 +256,10 @@ public:
     return task_projection;
   }
 
+  const Serial &GetSerial() const {
+    return serial;
+  }
+
   /**
    * Empty clearance polygons of all airspaces in this database
    */
@@ -263,68 +263,6 @@ GlidePolar::IsGlidePossible(const GlideState &task) const
   return true;
 }
 
-/**
- * Finds speed to fly for a given MacCready setting
- * Intended to be used temporarily.
- *
- * This finds the speed that maximises the glide angle over the ground
- */
-class GlidePolarSpeedToFly gcc_final : public ZeroFinder {
-  const GlidePolar &polar;
-  const fixed m_net_sink_rate;
-  const fixed m_head_wind;
-
-public:
-  /**
-   * Constructor.
-   *
-   * @param _polar Glide polar to optimise
-   * @param net_sink_rate Instantaneous netto sink rate (m/s), positive down
-   * @param head_wind Head wind component (m/s)
-   * @param vmin Minimum speed to search (m/s)
-   * @param vmax Maximum speed to search (m/s)
-   *
-   * @return Initialised object (no search yet)
-   */
-  GlidePolarSpeedToFly(const GlidePolar &_polar, const fixed net_sink_rate,
-                       const fixed head_wind, const fixed vmin,
-                       const fixed vmax) :
-    ZeroFinder(std::max(fixed(1), vmin - head_wind), vmax - head_wind,
-               fixed(TOLERANCE_POLAR_DOLPHIN)),
-    polar(_polar),
-    m_net_sink_rate(net_sink_rate),
-    m_head_wind(head_wind)
-  {
-  }
-
-  /**
-   * Glide ratio over ground function
-   *
-   * @param V Speed over ground (m/s)
-   *
-   * @return MacCready-adjusted inverse glide ratio over ground
-   */
-  fixed
-  f(const fixed V)
-  {
-    return (polar.MSinkRate(V + m_head_wind) + m_net_sink_rate) / V;
-  }
-
-  /**
-   * Find best speed to fly
-   *
-   * @param Vstart Initial search speed (m/s)
-   *
-   * @return Speed to fly (m/s)
-   */
-  fixed
-  solve(const fixed Vstart)
-  {
-    fixed Vopt = find_min(Vstart);
-    return Vopt + m_head_wind;
-  }
-};
-
 fixed
 GlidePolar::SpeedToFly(const AircraftState &state,
     const GlideResult &solution, const bool block_stf) const
@@ -341,13 +279,35 @@ GlidePolar::SpeedToFly(const AircraftState &state,
                           : fixed(0));
     const fixed stf_sink_rate (block_stf ? fixed(0) : -state.netto_vario);
 
-    GlidePolarSpeedToFly gp_stf(*this, stf_sink_rate, head_wind, Vmin, Vmax);
-    V_stf = gp_stf.solve(Vmax);
+    V_stf = CalcSpeedToFly(stf_sink_rate, head_wind);
   }
 
   return std::max(Vmin, V_stf * g_scaling);
 }
 
+fixed
+GlidePolar::CalcSpeedToFly(const fixed net_sink_rate,
+                           const fixed head_wind) const
+{
+  assert(polar.IsValid());
+
+  /* the speed V which minimises the MacCready-adjusted inverse glide
+     ratio over ground (S(V) + mc + net_sink_rate) / (V - head_wind);
+     for the parabolic polar, setting the derivative to zero gives
+
+       a.V^2 - 2.a.head_wind.V - (b.head_wind + c + mc + net_sink_rate) = 0
+  */
+  const fixed v_min = std::max(Vmin, head_wind + fixed(1));
+  const fixed s = sqr(head_wind) +
+    (mc + net_sink_rate + polar.c + polar.b * head_wind) / polar.a;
+  if (!positive(s))
+    /* strong lift: the glide ratio over ground improves as the speed
+       decreases */
+    return v_min;
+
+  return std::max(v_min, std::min(head_wind + sqrt(s), Vmax));
+}
+
 fixed
 GlidePolar::GetTotalMass() const
 {
@@ -425,12 +385,34 @@ GlidePolar::GetLDOverGround(Angle track, SpeedVector wind) const
     return bestLD;
 
   const fixed c_theta = (wind.bearing.Reciprocal() - track).cos();
+  return CalcLDOverGround(wind.norm, -wind.norm * c_theta);
+}
 
+fixed
+GlidePolar::GetLDOverGround(const AircraftState &state) const
+{
+  return GetLDOverGround(state.track, state.wind);
+}
+
+fixed
+GlidePolar::GetLDOverGround(const GlideState &task) const
+{
+  if (task.wind.IsZero())
+    return bestLD;
+
+  return CalcLDOverGround(task.wind.norm, task.head_wind);
+}
+
+fixed
+GlidePolar::CalcLDOverGround(const fixed wind_speed,
+                             const fixed head_wind) const
+{
   /* convert the wind speed into some sort of "virtual L/D" to put it
      in relation to the polar's best L/D */
-  const fixed wind_ld = wind.norm / GetSBestLD();
+  const fixed wind_ld = wind_speed / GetSBestLD();
+  const fixed head_wind_ld = head_wind / GetSBestLD();
 
-  Quadratic q(- Double(wind_ld * c_theta),
+  Quadratic q(Double(head_wind_ld),
               sqr(wind_ld) - sqr(bestLD));
 
   if (q.Check())
@@ -439,12 +421,6 @@ GlidePolar::GetLDOverGround(Angle track, SpeedVector wind) const
   return fixed(0);
 }
 
-fixed
-GlidePolar::GetLDOverGround(const AircraftState &state) const
-{
-  return GetLDOverGround(state.track, state.wind);
-}
-
 fixed
 GlidePolar::GetNextLegEqThermal(fixed current_wind, fixed next_wind) const
 {
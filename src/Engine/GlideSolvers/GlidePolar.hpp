@@ -461,6 +461,22 @@ public:
   fixed SpeedToFly(const AircraftState &state, const GlideResult &solution,
       const bool block_stf) const;
 
+private:
+  /**
+   * Back end for SpeedToFly(): solve the parabolic polar for the
+   * airspeed which maximises the MacCready-adjusted glide ratio over
+   * ground.
+   *
+   * @param net_sink_rate Instantaneous netto sink rate (m/s), positive down
+   * @param head_wind Head wind component (m/s)
+   *
+   * @return Speed to fly (true, m/s), limited to the polar's speed range
+   */
+  gcc_pure
+  fixed CalcSpeedToFly(fixed net_sink_rate, fixed head_wind) const;
+
+public:
+
   /**
    * Compute MacCready ring setting to adjust speeds to incorporate
    * risk as the aircraft gets low.
@@ -494,6 +510,28 @@ public:
   gcc_pure
   fixed GetLDOverGround(const AircraftState &state) const;
 
+  /**
+   * Find LD relative to ground along the task vector, using the head
+   * wind component precalculated by GlideState::CalcSpeedups().
+   *
+   * @param task the glide task
+   * @return LD ratio (distance travelled per unit height loss)
+   */
+  gcc_pure
+  fixed GetLDOverGround(const GlideState &task) const;
+
+private:
+  /**
+   * Back end for the GetLDOverGround() overloads.
+   *
+   * @param wind_speed the wind speed (m/s)
+   * @param head_wind the head wind component (m/s)
+   */
+  gcc_pure
+  fixed CalcLDOverGround(fixed wind_speed, fixed head_wind) const;
+
+public:
+
   /**
    * Calculates the thermal value of next leg that is equivalent (gives the
    * same average speed) to the current MacCready setting.
@@ -90,11 +90,15 @@ GlideState::CalcSpeedups(const SpeedVector _wind)
     wind = _wind;
     effective_wind_angle = wind.bearing.Reciprocal() - vector.bearing;
     wind_speed_squared = sqr(wind.norm);
-    head_wind = -wind.norm * effective_wind_angle.cos();
+
+    const auto sc = effective_wind_angle.SinCos();
+    head_wind = -wind.norm * sc.second;
+    cross_wind = wind.norm * sc.first;
   } else {
     wind = SpeedVector::Zero();
     effective_wind_angle = Angle::Zero();
     head_wind = fixed(0);
+    cross_wind = fixed(0);
     wind_speed_squared = fixed(0);
   }
 }
@@ -105,23 +109,11 @@ GlideState::DriftedDistance(const fixed time) const
   if (wind.IsZero())
     return vector.distance;
 
-  // Distance that the wine travels in the given #time
-  const fixed distance_wind = wind.norm * time;
-  // Direction of the wind
-  auto sc_wind = wind.bearing.Reciprocal().SinCos();
-  const fixed sin_wind = sc_wind.first, cos_wind = sc_wind.second;
-
-  // Distance to the target
-  const fixed distance_task = vector.distance;
-  // Direction to the target
-  auto sc_task = vector.bearing.SinCos();
-  const fixed sin_task = sc_task.first, cos_task = sc_task.second;
-
-  // X-/Y-Components of the resulting vector
-  const fixed dx = distance_task * sin_task - distance_wind * sin_wind;
-  const fixed dy = distance_task * cos_task - distance_wind * cos_wind;
-
-  return MediumHypot(dx, dy);
+  /* subtract the wind drift from the task vector, using the wind
+     components along and across the task direction which were
+     calculated by CalcSpeedups() */
+  const fixed along = vector.distance + head_wind * time;
+  const fixed across = cross_wind * time;
 
-  // ??   task.Bearing = RAD_TO_DEG*(atan2(dx,dy));
+  return MediumHypot(along, across);
 }
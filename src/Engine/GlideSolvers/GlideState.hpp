@@ -49,12 +49,19 @@ struct GlideState
   Angle effective_wind_angle;
   /** headwind component (m/s) in cruise */
   fixed head_wind;
+  /**
+   * crosswind component (m/s) in cruise; the sign is not
+   * meaningful
+   */
+  fixed cross_wind;
 
 private:
   /** (internal use) */
   fixed wind_speed_squared;
 
 public:
+  GlideState() = default;
+
   /**
    * Dummy task constructor.  Typically used for synthetic glide
    * tasks.  Where there are real targets, the other constructors should
@@ -106,9 +106,6 @@ GlideResult
 MacCready::Solve(const GlideSettings &settings, const GlidePolar &glide_polar,
                  const GlideState &task)
 {
-#ifdef INSTRUMENT_TASK
-  count_mc++;
-#endif
   const MacCready mac(settings, glide_polar);
   return mac.Solve(task);
 }
@@ -201,7 +198,7 @@ MacCready::SolveCruise(const GlideState &task) const
 
   result.validity = GlideResult::Validity::OK;
   result.pure_glide_height = task.vector.distance /
-    glide_polar.GetLDOverGround(task.vector.bearing, task.wind);
+    glide_polar.GetLDOverGround(task);
   result.pure_glide_altitude_difference -= result.pure_glide_height;
 
   return result;
@@ -289,7 +286,7 @@ MacCready::SolveStraight(const GlideState &task) const
 
   if (!positive(glide_polar.GetMC()))
     // whole task must be glide
-    return OptimiseGlide(task);
+    return OptimiseGlide(task, glide_polar.GetVMin());
 
   return SolveGlide(task, glide_polar.GetVBestLD());
 }
@@ -297,6 +294,16 @@ MacCready::SolveStraight(const GlideState &task) const
 GlideResult
 MacCready::Solve(const GlideState &task) const
 {
+  return Solve(task, glide_polar.GetVMin());
+}
+
+GlideResult
+MacCready::Solve(const GlideState &task, const fixed v_init) const
+{
+#ifdef INSTRUMENT_TASK
+  count_mc++;
+#endif
+
   if (!glide_polar.IsValid()) {
     /* can't solve without a valid GlidePolar() */
     GlideResult result;
@@ -309,7 +316,7 @@ MacCready::Solve(const GlideState &task) const
 
   if (!positive(glide_polar.GetMC()))
     // whole task must be glide
-    return OptimiseGlide(task, false);
+    return OptimiseGlide(task, v_init, false);
 
   if (negative(task.altitude_difference))
     // whole task climb-cruise
@@ -398,7 +405,8 @@ public:
 };
 
 GlideResult
-MacCready::OptimiseGlide(const GlideState &task, const bool allow_partial) const
+MacCready::OptimiseGlide(const GlideState &task, const fixed v_init,
+                         const bool allow_partial) const
 {
   assert(!positive(glide_polar.GetMC()));
 
@@ -406,7 +414,7 @@ MacCready::OptimiseGlide(const GlideState &task, const bool allow_partial) const
                        glide_polar.GetVMin(), glide_polar.GetVMax(),
                        allow_partial);
 
-  return mc_vopt.Result(glide_polar.GetVMin());
+  return mc_vopt.Result(v_init);
 }
 
 /*
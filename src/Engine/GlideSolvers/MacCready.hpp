@@ -100,6 +100,20 @@ public:
   gcc_pure
   GlideResult Solve(const GlideState &task) const;
 
+  /**
+   * Like Solve(), but start the search for the optimal glide speed
+   * (needed only for MacCready zero) at the specified speed instead
+   * of the polar's minimum speed.  The solution of the same glide
+   * in a previous call is a good guess, and makes the search
+   * converge much quicker.
+   *
+   * @param task The task for which a solution is desired
+   * @param v_init Initial guess of the optimal glide speed (m/s)
+   * @return Returns the glide result containing data about the optimal solution
+   */
+  gcc_pure
+  GlideResult Solve(const GlideState &task, const fixed v_init) const;
+
   gcc_pure
   static GlideResult Solve(const GlideSettings &settings,
                            const GlidePolar &glide_polar,
@@ -148,12 +162,13 @@ private:
    * seeking optimal speed to fly.
    *
    * @param task Task to solve for
+   * @param v_init Initial guess of the optimal speed
    * @param allow_partial Return after glide exhausted
    *
    * @return Solution
    */
   gcc_pure
-  GlideResult OptimiseGlide(const GlideState &task,
+  GlideResult OptimiseGlide(const GlideState &task, const fixed v_init,
                             const bool allow_partial = false) const;
 
   /**
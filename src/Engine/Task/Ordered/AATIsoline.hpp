@@ -49,6 +49,18 @@ public:
    * @param ap The AAT point for which to calculate the Isoline
    */
   AATIsoline(const AATPoint &ap, const TaskProjection &projection);
+
+  /**
+   * Constructor for an isoline which was previously calculated by
+   * the other constructor.
+   *
+   * @param previous Location of the previous task point
+   * @param next Location of the next task point
+   * @param target A point on the isoline
+   */
+  AATIsoline(const GeoPoint &previous, const GeoPoint &next,
+             const GeoPoint &target, const TaskProjection &projection)
+    :ell(previous, next, target, projection) {}
 };
 
 
@@ -21,6 +21,7 @@
  */
 
 #include "AATIsolineSegment.hpp"
+#include "Points/AATPoint.hpp"
 #include "Task/PathSolvers/IsolineCrossingFinder.hpp"
 #include "Util/Tolerances.hpp"
 
@@ -41,6 +42,18 @@ AATIsolineSegment::AATIsolineSegment(const AATPoint &ap,
   }
 }
 
+AATIsolineSegment::AATIsolineSegment(const AATIsolineCache &cache,
+                                     const TaskProjection &projection)
+  :AATIsoline(cache.previous, cache.next, cache.target, projection),
+   t_up(cache.t_up), t_down(cache.t_down) {}
+
+void
+AATIsolineSegment::SaveTo(AATIsolineCache &cache) const
+{
+  cache.t_up = t_up;
+  cache.t_down = t_down;
+}
+
 bool
 AATIsolineSegment::IsValid() const
 {
@@ -25,6 +25,8 @@
 
 #include "AATIsoline.hpp"
 
+struct AATIsolineCache;
+
 /**
  *  Specialisation of AATIsoline such that the segment of
  *  the isoline within the task point's observation zone is
@@ -50,6 +52,21 @@ public:
    */
   AATIsolineSegment(const AATPoint &ap, const TaskProjection &projection);
 
+  /**
+   * Constructor which restores a segment from the cache, without
+   * searching.
+   *
+   * @param cache The cache filled by SaveTo() on the same isoline
+   */
+  AATIsolineSegment(const AATIsolineCache &cache,
+                    const TaskProjection &projection);
+
+  /**
+   * Store the segment end points in the cache.  The caller is
+   * responsible for the locations which define the isoline.
+   */
+  void SaveTo(AATIsolineCache &cache) const;
+
   /**
    * Test whether segment is valid (nonzero length)
    *
@@ -26,6 +26,7 @@
 #include "Points/OrderedTaskPoint.hpp"
 #include "Points/StartPoint.hpp"
 #include "Points/FinishPoint.hpp"
+#include "Points/AATPoint.hpp"
 #include "Task/Solvers/TaskMacCreadyTravelled.hpp"
 #include "Task/Solvers/TaskMacCreadyRemaining.hpp"
 #include "Task/Solvers/TaskMacCreadyTotal.hpp"
@@ -53,6 +54,9 @@ OrderedTask::OrderedTask(const TaskBehaviour &tb)
   :AbstractTask(TaskType::ORDERED, tb),
    taskpoint_start(NULL),
    taskpoint_finish(NULL),
+   min_target_range(fixed(0)),
+   min_target_searched(false),
+   target_bearing_postponed(false),
    factory_mode(tb.task_type_default),
    active_factory(NULL),
    ordered_behaviour(tb.ordered_defaults),
@@ -463,12 +467,23 @@ OrderedTask::UpdateIdle(const AircraftState &state,
   if (HasStart() && task_behaviour.optimise_targets_range &&
       positive(GetOrderedTaskBehaviour().aat_min_time)) {
 
+    AATPoint *ap = task_behaviour.optimise_targets_bearing &&
+      task_points[active_task_point]->GetType() == TaskPointType::AAT
+      ? (AATPoint *)task_points[active_task_point]
+      : NULL;
+
     CalcMinTarget(state, glide_polar,
                   GetOrderedTaskBehaviour().aat_min_time + fixed(task_behaviour.optimise_targets_margin));
 
-    if (task_behaviour.optimise_targets_bearing) {
-      if (task_points[active_task_point]->GetType() == TaskPointType::AAT) {
-        AATPoint *ap = (AATPoint *)task_points[active_task_point];
+    if (ap != NULL) {
+      if (min_target_searched && !target_bearing_postponed) {
+        /* time slicing: the range search was expensive this time,
+           so keep the target it has just solved and optimise its
+           bearing in the next call */
+        target_bearing_postponed = true;
+      } else {
+        target_bearing_postponed = false;
+
         // very nasty hack
         TaskOptTarget tot(task_points, active_task_point, state,
                           task_behaviour.glide, glide_polar,
@@ -893,10 +908,12 @@ OrderedTask::CalcMinTarget(const AircraftState &aircraft,
     TaskMinTarget bmt(task_points, active_task_point, aircraft,
                       task_behaviour.glide, glide_polar,
                       t_rem, taskpoint_start);
-    fixed p = bmt.search(fixed(0));
-    return p;
+    min_target_range = bmt.search(min_target_range);
+    min_target_searched = !bmt.IsGuessConfirmed();
+    return min_target_range;
   }
 
+  min_target_searched = false;
   return fixed(0);
 }
 
@@ -78,6 +78,25 @@ private:
 
   GeoPoint last_min_location;
 
+  /**
+   * The result of the last CalcMinTarget() call, which is the
+   * initial guess for the next one.
+   */
+  fixed min_target_range;
+
+  /**
+   * Did the last CalcMinTarget() call perform a full search?  The
+   * target bearing optimisation is then postponed to the next
+   * UpdateIdle() call, so both searches don't add up in one call.
+   */
+  bool min_target_searched;
+
+  /**
+   * Was the target bearing optimisation postponed by the last
+   * UpdateIdle() call?  It is never postponed twice in a row.
+   */
+  bool target_bearing_postponed;
+
   TaskFactoryType factory_mode;
   AbstractTaskFactory* active_factory;
   OrderedTaskBehaviour ordered_behaviour;
@@ -81,6 +81,29 @@ AATPoint::IsCloseToTarget(const AircraftState& state, const fixed threshold) con
     - DoubleLegDistance(target_location) > -threshold;
 }
 
+const AATIsolineCache *
+AATPoint::GetIsolineCache() const
+{
+  if (!isoline_cache.defined ||
+      (target_location != isoline_cache.target &&
+       target_location != isoline_cache.optimised_target) ||
+      GetPrevious()->GetLocationRemaining() != isoline_cache.previous ||
+      GetNext()->GetLocationRemaining() != isoline_cache.next)
+    return NULL;
+
+  return &isoline_cache;
+}
+
+void
+AATPoint::UpdateOZ(const TaskProjection &projection)
+{
+  OrderedTaskPoint::UpdateOZ(projection);
+
+  /* the isoline segment depends on the observation zone and on the
+     task projection */
+  isoline_cache.defined = false;
+}
+
 bool
 AATPoint::CheckTargetInside(const AircraftState& state) 
 {
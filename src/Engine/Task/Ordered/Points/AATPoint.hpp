@@ -44,6 +44,28 @@ struct RangeAndRadial {
   }
 };
 
+/**
+ * The result of a target optimiser (TaskOptTarget) run on an
+ * AATPoint.  Searching the end points of the isoline segment is
+ * expensive, so they are reused as long as the isoline remains the
+ * same, i.e. until the target or the neighbouring task points move.
+ */
+struct AATIsolineCache {
+  /** The locations which define the isoline ellipse */
+  GeoPoint previous, next, target;
+
+  /** The target which was chosen by the optimiser on this isoline */
+  GeoPoint optimised_target;
+
+  /** Ellipse parameters of the isoline segment end points */
+  fixed t_up, t_down;
+
+  /** The isoline segment parameter [0,1] of #optimised_target */
+  fixed parameter;
+
+  bool defined;
+};
+
 /**
  * An AATPoint is an abstract IntermediatePoint,
  * can manage a target within the observation zone
@@ -61,6 +83,9 @@ class AATPoint gcc_final : public IntermediateTaskPoint
   /** Whether target can float */
   bool target_locked;
 
+  /** The last target optimiser result, see GetIsolineCache() */
+  AATIsolineCache isoline_cache;
+
 public:
   /**
    * Constructor.  Initialises to unlocked target, target is
@@ -80,6 +105,7 @@ public:
      target_save(wp.location),
      target_locked(false)
   {
+    isoline_cache.defined = false;
   }
 
   /**
@@ -141,6 +167,22 @@ public:
   bool IsCloseToTarget(const AircraftState& state,
                        const fixed threshold=fixed(0)) const;
 
+  /**
+   * Returns the result of the last target optimiser run, but only if
+   * its isoline still passes through the current target, i.e. the
+   * target is either where the isoline was constructed or where the
+   * optimiser left it, and the neighbouring task points have not
+   * moved.
+   *
+   * @return the cache or NULL if it cannot be used
+   */
+  gcc_pure
+  const AATIsolineCache *GetIsolineCache() const;
+
+  void SetIsolineCache(const AATIsolineCache &cache) {
+    isoline_cache = cache;
+  }
+
 private:
   /**
    * Check whether target needs to be moved and if so, to
@@ -195,6 +237,7 @@ public:
   }
 
   /* virtual methods from class SampledTaskPoint */
+  virtual void UpdateOZ(const TaskProjection &projection) gcc_override;
   virtual bool UpdateSampleNear(const AircraftState &state,
                                 const TaskProjection &projection) gcc_override;
   virtual bool UpdateSampleFar(const AircraftState &state,
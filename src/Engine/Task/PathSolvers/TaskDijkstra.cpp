@@ -25,7 +25,7 @@
 #include "Geo/SearchPointVector.hpp"
 
 TaskDijkstra::TaskDijkstra(bool _is_min)
-  :NavDijkstra(0),
+  :num_stages(0), valid_stage(0),
    is_min(_is_min)
 {
 }
@@ -37,13 +37,28 @@ TaskDijkstra::RefreshTask(const OrderedTask &task)
   if (task_size < 2 || task_size > MAX_STAGES)
     return false;
 
-  SetStageCount(task_size);
+  if (task_size != num_stages) {
+    /* the finish has moved to another stage: all tables are
+       obsolete */
+    num_stages = task_size;
+    valid_stage = num_stages;
+  }
 
   active_stage = task.GetActiveTaskPointIndex();
 
   for (unsigned stage = 0; stage != num_stages; ++stage)
     boundaries[stage] = &task.GetPointSearchPoints(stage);
 
+  /* a modified stage invalidates its own table and the tables of
+     all stages before it */
+  for (unsigned stage = num_stages; stage > valid_stage;) {
+    --stage;
+    if (IsStageModified(stage)) {
+      valid_stage = stage + 1;
+      break;
+    }
+  }
+
   return true;
 }
 
@@ -56,37 +71,120 @@ TaskDijkstra::GetStageSize(const unsigned stage) const
 }
 
 const SearchPoint &
-TaskDijkstra::GetPoint(const ScanTaskPoint sp) const
+TaskDijkstra::GetPoint(unsigned stage, unsigned index) const
 {
-  return (*boundaries[sp.GetStageNumber()])[sp.GetPointIndex()];
+  assert(index < GetStageSize(stage));
+
+  return (*boundaries[stage])[index];
 }
 
-void
-TaskDijkstra::AddEdges(const ScanTaskPoint curNode)
+bool
+TaskDijkstra::IsStageModified(unsigned stage) const
 {
-  ScanTaskPoint destination(curNode.GetStageNumber() + 1, 0);
-  const unsigned dsize = GetStageSize(destination.GetStageNumber());
+  const std::vector<FlatGeoPoint> &locations = stages[stage].locations;
+  const unsigned size = GetStageSize(stage);
+  if (size != locations.size())
+    return true;
 
-  for (const ScanTaskPoint end(destination.GetStageNumber(), dsize);
-       destination != end; destination.IncrementPointIndex())
-    Link(destination, curNode, CalcDistance(curNode, destination));
+  for (unsigned i = 0; i != size; ++i)
+    if (!(GetPoint(stage, i).GetFlatLocation() == locations[i]))
+      return true;
+
+  return false;
 }
 
-void 
-TaskDijkstra::AddStartEdges(const SearchPoint &currentLocation)
+bool
+TaskDijkstra::UpdateStage(unsigned stage)
 {
-  ScanTaskPoint destination(active_stage, 0);
-  const unsigned dsize = GetStageSize(active_stage);
+  const unsigned size = GetStageSize(stage);
+  const bool final = stage + 1 == num_stages;
+  const unsigned next_size = final ? 0 : GetStageSize(stage + 1);
+  if (!final && next_size == 0)
+    /* error, no way to reach final */
+    return false;
 
-  for (const ScanTaskPoint end(active_stage, dsize);
-       destination != end; destination.IncrementPointIndex())
-    LinkStart(destination, CalcDistance(destination, currentLocation));
+  Stage &s = stages[stage];
+  s.locations.resize(size);
+  s.distance.resize(size);
+  s.next.resize(size);
+
+  const Stage *next_stage = final ? NULL : &stages[stage + 1];
+
+  for (unsigned i = 0; i != size; ++i) {
+    const FlatGeoPoint &location = GetPoint(stage, i).GetFlatLocation();
+    s.locations[i] = location;
+
+    if (final) {
+      s.distance[i] = 0;
+      s.next[i] = 0;
+      continue;
+    }
+
+    /* on ties, the first point wins; see
+       ObservationZone::GetBoundary() */
+    unsigned best_index = 0, best_distance = 0;
+    for (unsigned j = 0; j != next_size; ++j) {
+      const unsigned distance = next_stage->distance[j] +
+        CalcDistance(location, GetPoint(stage + 1, j).GetFlatLocation());
+      if (j == 0 || IsBetter(distance, best_distance)) {
+        best_index = j;
+        best_distance = distance;
+      }
+    }
+
+    s.distance[i] = best_distance;
+    s.next[i] = best_index;
+  }
+
+  return true;
 }
 
 bool
-TaskDijkstra::Run()
+TaskDijkstra::Run(unsigned first_stage)
 {
-  const bool retval = DistanceGeneral() == SolverResult::VALID;
-  dijkstra.Clear();
-  return retval;
+  assert(first_stage < num_stages);
+
+  while (valid_stage > first_stage) {
+    if (!UpdateStage(valid_stage - 1))
+      return false;
+
+    --valid_stage;
+  }
+
+  return GetStageSize(first_stage) > 0;
+}
+
+void
+TaskDijkstra::FindSolution(unsigned stage, unsigned index)
+{
+  assert(stage >= valid_stage);
+
+  for (; stage != num_stages; ++stage) {
+    assert(index < stages[stage].next.size());
+
+    solution[stage] = index;
+    index = stages[stage].next[index];
+  }
+}
+
+bool
+TaskDijkstra::FindSolution(const SearchPoint &location)
+{
+  const Stage &s = stages[active_stage];
+  const unsigned size = GetStageSize(active_stage);
+  if (size == 0)
+    return false;
+
+  unsigned best_index = 0, best_distance = 0;
+  for (unsigned i = 0; i != size; ++i) {
+    const unsigned distance = s.distance[i] +
+      CalcDistance(s.locations[i], location.GetFlatLocation());
+    if (i == 0 || IsBetter(distance, best_distance)) {
+      best_index = i;
+      best_distance = distance;
+    }
+  }
+
+  FindSolution(active_stage, best_index);
+  return true;
 }
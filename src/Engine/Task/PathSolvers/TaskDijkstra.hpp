@@ -23,8 +23,12 @@
 #ifndef TASK_DIJKSTRA_HPP
 #define TASK_DIJKSTRA_HPP
 
-#include "PathSolvers/NavDijkstra.hpp"
+#include "Util/NonCopyable.hpp"
 #include "Geo/SearchPoint.hpp"
+#include "Geo/Flat/FlatGeoPoint.hpp"
+#include "Compiler.h"
+
+#include <vector>
 
 #include <assert.h>
 
@@ -46,16 +50,59 @@ class SearchPointVector;
  * before the active task point need only be searched for maximum achieved
  * distance rather than border search points. 
  *
- * This uses a Dijkstra search and so is O(N log(N)).
+ * Every edge of the search graph leads from one task point to the
+ * next one, so instead of a general Dijkstra search, the best
+ * distance from each search point to the finish is calculated stage
+ * by stage, backwards from the finish.  These tables are kept
+ * between runs: only the stages whose search points have changed
+ * since the last run (usually just the samples of the active task
+ * point) and the stages before them are recalculated.
  */
-class TaskDijkstra : protected NavDijkstra
+class TaskDijkstra : private NonCopyable
 {
 protected:
+  enum {
+    MAX_STAGES = 16,
+  };
+
+  /** Number of stages in search */
+  unsigned num_stages;
+
   unsigned active_stage;
 
 private:
   const SearchPointVector *boundaries[MAX_STAGES];
 
+  struct Stage {
+    /**
+     * The search point locations this stage's table was calculated
+     * for; used to detect modifications.
+     */
+    std::vector<FlatGeoPoint> locations;
+
+    /**
+     * The best distance from each search point to the finish.
+     */
+    std::vector<unsigned> distance;
+
+    /**
+     * The index of the best search point in the following stage.
+     */
+    std::vector<unsigned> next;
+  };
+
+  Stage stages[MAX_STAGES];
+
+  /**
+   * The tables of this stage and all following stages are valid.
+   */
+  unsigned valid_stage;
+
+  /**
+   * An array containing the point index for each of the solution's stages.
+   */
+  unsigned solution[MAX_STAGES];
+
   const bool is_min;
 
 public:
@@ -73,69 +120,80 @@ public:
   const SearchPoint &GetSolution(unsigned stage) const {
     assert(stage < num_stages);
 
-    return GetPoint(ScanTaskPoint(stage, solution[stage]));
+    return GetPoint(stage, solution[stage]);
   }
 
 protected:
   gcc_pure
-  const SearchPoint &GetPoint(ScanTaskPoint sp) const;
-
-  bool Run();
+  const SearchPoint &GetPoint(unsigned stage, unsigned index) const;
 
   /**
-   * Update internal details required from the task
+   * Update internal details required from the task, and invalidate
+   * the tables of modified stages.
    *
    * @param _task The task to find max/min distances for
    */
   bool RefreshTask(const OrderedTask &task);
 
-  bool Link(const ScanTaskPoint node, const ScanTaskPoint parent,
-            unsigned value) {
-    if (!is_min)
-      value = DIJKSTRA_MINMAX_OFFSET - value;
-
-    return NavDijkstra::Link(node, parent, value);
-  }
-
-  void AddStartEdges(const SearchPoint &loc);
+  /**
+   * Bring the tables of the specified stage and all following
+   * stages up to date.
+   *
+   * @return false if there is no path to the finish
+   */
+  bool Run(unsigned first_stage);
 
-  /** 
-   * Distance function for free point
-   * 
-   * @param curNode Destination node
-   * @param currentLocation Origin location
-   * 
-   * @return Distance (flat) from origin to destination
+  /**
+   * Find the solution starting at the specified search point.  Call
+   * this after Run() has returned true.
    */
-  gcc_pure
-  unsigned CalcDistance(const ScanTaskPoint curNode,
-                        const SearchPoint &currentLocation) const {
-    const FlatGeoPoint &a = GetPoint(curNode).GetFlatLocation();
-    const FlatGeoPoint &b = currentLocation.GetFlatLocation();
+  void FindSolution(unsigned stage, unsigned index);
 
-    return a.ShiftedDistance(b, 8);
-  }
+  /**
+   * Find the solution starting at the search point of the active
+   * stage which is best to fly to from the specified location.  Call
+   * this after Run() has returned true.
+   *
+   * @return false if the active stage has no search points
+   */
+  bool FindSolution(const SearchPoint &location);
 
-  /** 
+  /**
    * Distance function for edges
-   * 
-   * @param s1 Origin node
-   * @param s2 Destination node
-   * 
+   *
+   * @param a Origin location
+   * @param b Destination location
+   *
    * @return Distance (flat) from origin to destination
    */
   gcc_pure
-  unsigned CalcDistance(const ScanTaskPoint s1, const ScanTaskPoint s2) const {
-    return CalcDistance(s1, GetPoint(s2));
+  static unsigned CalcDistance(const FlatGeoPoint &a, const FlatGeoPoint &b) {
+    return a.ShiftedDistance(b, 8);
   }
 
 private:
   gcc_pure
   unsigned GetStageSize(const unsigned stage) const;
 
-protected:
-  /* methods from NavDijkstra */
-  virtual void AddEdges(ScanTaskPoint curNode) gcc_final;
+  gcc_pure
+  bool IsBetter(unsigned a, unsigned b) const {
+    return is_min ? a < b : a > b;
+  }
+
+  /**
+   * Has the specified stage been modified since its table was
+   * calculated?
+   */
+  gcc_pure
+  bool IsStageModified(unsigned stage) const;
+
+  /**
+   * Calculate the table of the specified stage.  The table of the
+   * following stage must be valid.
+   *
+   * @return false if there is no path to the finish
+   */
+  bool UpdateStage(unsigned stage);
 };
 
 #endif
@@ -28,8 +28,9 @@ TaskDijkstraMax::DistanceMax(const OrderedTask &task)
   if (!RefreshTask(task))
     return false;
 
-  dijkstra.Reserve(256);
-  dijkstra.Clear();
-  LinkStart(ScanTaskPoint(0, 0));
-  return Run();
+  if (!Run(0))
+    return false;
+
+  FindSolution(0, 0);
+  return true;
 }
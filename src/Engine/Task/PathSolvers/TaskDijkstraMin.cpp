@@ -29,15 +29,13 @@ TaskDijkstraMin::DistanceMin(const OrderedTask &task,
   if (!RefreshTask(task))
     return false;
 
-  dijkstra.Reserve(256);
-  dijkstra.Clear();
+  if (!Run(active_stage))
+    return false;
 
-  if (active_stage > 0) {
-    AddStartEdges(currentLocation);
-  } else {
-    LinkStart(ScanTaskPoint(0, 0));
-  }
+  if (active_stage > 0)
+    return FindSolution(currentLocation);
 
-  return Run();
+  FindSolution(0, 0);
+  return true;
 }
 
@@ -22,7 +22,9 @@
 
 #include "TaskMacCready.hpp"
 #include "TaskSolution.hpp"
+#include "GlideSolvers/MacCready.hpp"
 #include "Task/Ordered/Points/OrderedTaskPoint.hpp"
+#include "Navigation/Aircraft.hpp"
 
 #include <algorithm>
 
@@ -35,7 +37,10 @@ TaskMacCready::TaskMacCready(const std::vector<OrderedTaskPoint*> &_tps,
    start_index(0),
    end_index(std::max((int)_tps.size(), 1) - 1),
    settings(_settings),
-   glide_polar(gp) {}
+   glide_polar(gp)
+{
+  ResetLegStates();
+}
 
 TaskMacCready::TaskMacCready(TaskPoint* tp, const GlideSettings &_settings,
                              const GlidePolar &gp)
@@ -44,7 +49,10 @@ TaskMacCready::TaskMacCready(TaskPoint* tp, const GlideSettings &_settings,
    start_index(0),
    end_index(0),
    settings(_settings),
-   glide_polar(gp) {}
+   glide_polar(gp)
+{
+  ResetLegStates();
+}
 
 TaskMacCready::TaskMacCready(const std::vector<TaskPoint*> &_tps,
                              const GlideSettings &_settings,
@@ -54,7 +62,59 @@ TaskMacCready::TaskMacCready(const std::vector<TaskPoint*> &_tps,
    start_index(0),
    end_index(std::max((int)_tps.size(), 1) - 1),
    settings(_settings),
-   glide_polar(gp) {}
+   glide_polar(gp)
+{
+  ResetLegStates();
+}
+
+void
+TaskMacCready::ResetLegStates()
+{
+  for (auto it = leg_states.begin(), end = leg_states.end(); it != end; ++it)
+    it->vector.SetInvalid();
+}
+
+gcc_pure
+static bool
+IsSameGeometry(const GlideState &state, const GeoVector &vector,
+               const SpeedVector &wind)
+{
+  if (state.vector.distance != vector.distance ||
+      state.vector.bearing != vector.bearing)
+    return false;
+
+  /* GlideState::CalcSpeedups() normalises a calm wind */
+  if (wind.IsZero())
+    return state.wind.IsZero();
+
+  return state.wind.norm == wind.norm && state.wind.bearing == wind.bearing;
+}
+
+GlideResult
+TaskMacCready::tp_solution(const MacCready &mac, const unsigned i,
+                           const AircraftState &aircraft, fixed min_h)
+{
+  const GeoVector vector = get_leg_vector(i, aircraft);
+  const fixed min_arrival_altitude = std::max(min_h, points[i]->GetElevation());
+
+  fixed v_init = glide_polar.GetVMin();
+
+  GlideState &state = leg_states[i];
+  if (IsSameGeometry(state, vector, aircraft.wind)) {
+    /* only the altitudes have changed; reuse the wind speedups */
+    state.min_arrival_altitude = min_arrival_altitude;
+    state.altitude_difference = aircraft.altitude - min_arrival_altitude;
+
+    /* the optimal glide speed does not depend on the altitudes, so
+       the previous solution of this leg is a good initial guess */
+    if (leg_solutions[i].IsOk())
+      v_init = leg_solutions[i].v_opt;
+  } else
+    state = GlideState(vector, min_arrival_altitude, aircraft.altitude,
+                       aircraft.wind);
+
+  return mac.Solve(state, v_init);
+}
 
 GlideResult
 TaskMacCready::glide_solution(const AircraftState &aircraft)
@@ -62,13 +122,14 @@ TaskMacCready::glide_solution(const AircraftState &aircraft)
   const fixed aircraft_min_height = get_min_height(aircraft);
   GlideResult acc_gr;
   AircraftState aircraft_predict = get_aircraft_start(aircraft);
+  const MacCready mac(settings, glide_polar);
 
   for (int i = start_index; i <= end_index; ++i) {
     const fixed tp_min_height = std::max(aircraft_min_height,
                                          points[i]->GetElevation());
 
     // perform estimate, ensuring that alt is above previous taskpoint
-    GlideResult gr = tp_solution(i, aircraft_predict, tp_min_height);
+    GlideResult gr = tp_solution(mac, i, aircraft_predict, tp_min_height);
     leg_solutions[i] = gr;
 
     // update state
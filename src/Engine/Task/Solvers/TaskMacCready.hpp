@@ -25,6 +25,7 @@
 #include "Util/NonCopyable.hpp"
 #include "Util/StaticArray.hpp"
 #include "GlideSolvers/GlidePolar.hpp"
+#include "GlideSolvers/GlideState.hpp"
 #include "GlideSolvers/GlideResult.hpp"
 
 #include <vector>
@@ -32,6 +33,7 @@
 
 struct AircraftState;
 struct GlideSettings;
+class MacCready;
 class TaskPoint;
 class OrderedTaskPoint;
 
@@ -69,6 +71,14 @@ protected:
    */
   std::array<GlideResult, MAX_SIZE> leg_solutions;
 
+  /**
+   * Glide tasks for each leg.  They are kept between calls, so the
+   * solvers which iterate over the MacCready setting or the cruise
+   * efficiency need to recalculate the wind speedups only when the
+   * geometry of a leg changes.
+   */
+  std::array<GlideState, MAX_SIZE> leg_states;
+
   /**
    * Active task point (local copy for speed).
    */
@@ -188,6 +198,21 @@ protected:
                       const fixed S) const;
 
 private:
+  void ResetLegStates();
+
+  /**
+   * Calculate glide solution for specified index, given
+   * aircraft state and height constraint.
+   *
+   * @param mac the MacCready solver for the current glide polar
+   * @param index Index of task point
+   * @param state Aircraft state at origin
+   * @param min_h Minimum height at destination
+   *
+   * @return Glide result for segment
+   */
+  GlideResult tp_solution(const MacCready &mac, const unsigned index,
+                          const AircraftState &state, fixed min_h);
 
   /**
    * Pure virtual method to retrieve the absolute minimum height of
@@ -202,20 +227,18 @@ private:
   virtual fixed get_min_height(const AircraftState &state) const = 0;
 
   /**
-   * Pure virtual method to calculate glide solution for specified index, given
-   * aircraft state and height constraint.
+   * Pure virtual method to obtain the vector of the leg to the
+   * specified task point.
    * This is used to provide alternate methods for different perspectives
    * on the task, e.g. planned/remaining/travelled
    *
    * @param index Index of task point
    * @param state Aircraft state at origin
-   * @param minH Minimum height at destination
    *
-   * @return Glide result for segment
+   * @return Vector of the leg
    */
-  virtual GlideResult tp_solution(const unsigned index,
-                                  const AircraftState &state,
-                                  fixed minH) const = 0;
+  virtual GeoVector get_leg_vector(const unsigned index,
+                                   const AircraftState &state) const = 0;
 
   /**
    * Pure virtual method to obtain aircraft state at start of task.
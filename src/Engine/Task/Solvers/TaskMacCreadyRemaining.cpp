@@ -21,7 +21,7 @@
  */
 
 #include "TaskMacCreadyRemaining.hpp"
-#include "TaskSolution.hpp"
+#include "Navigation/Aircraft.hpp"
 #include "Task/Points/TaskPoint.hpp"
 
 TaskMacCreadyRemaining::TaskMacCreadyRemaining(const std::vector<OrderedTaskPoint*> &_tps,
@@ -40,13 +40,11 @@ TaskMacCreadyRemaining::TaskMacCreadyRemaining(TaskPoint* tp,
 {
 }
 
-GlideResult
-TaskMacCreadyRemaining::tp_solution(const unsigned i,
-                                    const AircraftState &aircraft,
-                                    fixed minH) const
+GeoVector
+TaskMacCreadyRemaining::get_leg_vector(const unsigned i,
+                                       const AircraftState &aircraft) const
 {
-  return TaskSolution::GlideSolutionRemaining(*points[i],aircraft,
-                                              settings, glide_polar, minH);
+  return points[i]->GetVectorRemaining(aircraft.location);
 }
 
 
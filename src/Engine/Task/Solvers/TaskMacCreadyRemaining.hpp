@@ -75,9 +75,8 @@ public:
 
 private:
 
-  virtual GlideResult tp_solution(const unsigned i,
-                                  const AircraftState &aircraft,
-                                  fixed minH) const;
+  virtual GeoVector get_leg_vector(const unsigned i,
+                                   const AircraftState &aircraft) const;
   virtual fixed get_min_height(const AircraftState &aircraft) const {
     return fixed(0);
   }
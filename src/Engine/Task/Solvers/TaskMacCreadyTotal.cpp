@@ -21,7 +21,6 @@
  */
 
 #include "TaskMacCreadyTotal.hpp"
-#include "TaskSolution.hpp"
 #include "Task/Points/TaskPoint.hpp"
 
 TaskMacCreadyTotal::TaskMacCreadyTotal(const std::vector<OrderedTaskPoint*> &_tps,
@@ -32,13 +31,11 @@ TaskMacCreadyTotal::TaskMacCreadyTotal(const std::vector<OrderedTaskPoint*> &_tp
 {
 }
 
-GlideResult
-TaskMacCreadyTotal::tp_solution(const unsigned i,
-                                const AircraftState &aircraft,
-                                fixed minH) const
+GeoVector
+TaskMacCreadyTotal::get_leg_vector(const unsigned i,
+                                   const AircraftState &aircraft) const
 {
-  return TaskSolution::GlideSolutionPlanned(*points[i], aircraft,
-                                            settings, glide_polar, minH);
+  return points[i]->GetVectorPlanned();
 }
 
 const AircraftState &
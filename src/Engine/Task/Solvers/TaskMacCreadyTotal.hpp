@@ -63,9 +63,8 @@ public:
   fixed effective_leg_distance(const fixed time_remaining) const;
 
 private:
-  virtual GlideResult tp_solution(const unsigned i,
-                                  const AircraftState &aircraft,
-                                  fixed minH) const;
+  virtual GeoVector get_leg_vector(const unsigned i,
+                                   const AircraftState &aircraft) const;
 
   virtual fixed get_min_height(const AircraftState &aircraft) const {
     return fixed(0);
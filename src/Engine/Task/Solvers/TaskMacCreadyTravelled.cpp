@@ -21,7 +21,6 @@
  */
 
 #include "TaskMacCreadyTravelled.hpp"
-#include "TaskSolution.hpp"
 #include "Task/Points/TaskPoint.hpp"
 #include "Navigation/Aircraft.hpp"
 
@@ -34,13 +33,11 @@ TaskMacCreadyTravelled::TaskMacCreadyTravelled(const std::vector<OrderedTaskPoin
   end_index = active_index;
 }
 
-GlideResult
-TaskMacCreadyTravelled::tp_solution(const unsigned i,
-                                    const AircraftState &aircraft,
-                                    fixed minH) const
+GeoVector
+TaskMacCreadyTravelled::get_leg_vector(const unsigned i,
+                                       const AircraftState &aircraft) const
 {
-  return TaskSolution::GlideSolutionTravelled(*points[i], aircraft,
-                                              settings, glide_polar, minH);
+  return points[i]->GetVectorTravelled();
 }
 
 const AircraftState &
@@ -42,9 +42,8 @@ public:
                          const GlideSettings &settings, const GlidePolar &_gp);
 
 private:
-  virtual GlideResult tp_solution(const unsigned i,
-                                  const AircraftState &aircraft,
-                                  fixed minH) const;
+  virtual GeoVector get_leg_vector(const unsigned i,
+                                   const AircraftState &aircraft) const;
   virtual fixed get_min_height(const AircraftState &aircraft) const;
 
   virtual const AircraftState &get_aircraft_start(const AircraftState &aircraft) const;
@@ -24,6 +24,8 @@
 #include "Task/Ordered/Points/StartPoint.hpp"
 #include "Util/Tolerances.hpp"
 
+#include <algorithm>
+
 
 TaskMinTarget::TaskMinTarget(const std::vector<OrderedTaskPoint*>& tps,
                              const unsigned activeTaskPoint,
@@ -36,7 +38,8 @@ TaskMinTarget::TaskMinTarget(const std::vector<OrderedTaskPoint*>& tps,
   aircraft(_aircraft),
   t_remaining(_t_remaining),
   tp_start(_ts),
-  force_current(false)
+  force_current(false),
+  guess_confirmed(false)
 {
 
 }
@@ -59,15 +62,46 @@ TaskMinTarget::valid(const fixed tp)
   return res.IsOk(); // && (ff>= -tolerance*fixed(2));
 }
 
+bool
+TaskMinTarget::IsSolution(const fixed p)
+{
+  if (p < xmin || p > xmax)
+    return false;
+
+  /* at the range limits, the error may have any sign: the task can't
+     be made any shorter or longer */
+  const fixed p_low = std::max(xmin, p - tolerance);
+  const fixed p_high = std::min(xmax, p + tolerance);
+
+  const fixed f_low = f(p_low);
+  if (!res.IsOk() || (p_low > xmin && positive(f_low)))
+    return false;
+
+  const fixed f_high = f(p_high);
+  if (!res.IsOk() || (p_high < xmax && negative(f_high)))
+    return false;
+
+  f(p);
+  return valid(p);
+}
+
 fixed 
 TaskMinTarget::search(const fixed tp) 
 {
+  guess_confirmed = false;
+
   if (!tm.has_targets()) {
     // don't bother if nothing to adjust
     return tp;
   }
 
   force_current = false;
+
+  if (IsSolution(tp)) {
+    guess_confirmed = true;
+    return tp;
+  }
+
   /// @todo if search fails, force current
   const fixed p = find_zero(tp);
   if (valid(p)) {
@@ -46,6 +46,8 @@ class TaskMinTarget gcc_final : private ZeroFinder
   const fixed t_remaining;
   StartPoint *tp_start;
   bool force_current;
+  /** Was the initial guess confirmed by the last search() call? */
+  bool guess_confirmed;
 
 public:
 /** 
@@ -78,6 +80,19 @@ private:
  */
   bool valid(const fixed p);
 
+/**
+ * Check whether the specified range (e.g. the previous solution) is
+ * still a solution within the search tolerance, i.e. whether the
+ * remaining time error changes its sign within the tolerance around
+ * it.  Costs two or three evaluations instead of a full search.
+ *
+ * @param p Range value to be checked (0-1)
+ *
+ * @return True if #p is a valid solution; the targets are then set
+ * to it
+ */
+  bool IsSolution(const fixed p);
+
 public:
 /** 
  * Search for target range to produce remaining time equal to
@@ -85,12 +100,21 @@ public:
  *
  * Running this adjusts the target values for AAT task points. 
  * 
- * @param p Default range (0-1)
+ * @param p Default range (0-1); if this is still a solution (e.g. the
+ * result of the previous call), no search is performed
  * 
  * @return Range value for solution
  */
   fixed search(const fixed p);
 
+  /**
+   * Was the initial guess passed to search() confirmed, i.e. was the
+   * search skipped?
+   */
+  bool IsGuessConfirmed() const {
+    return guess_confirmed;
+  }
+
 private:
   void set_range(const fixed p);
 };
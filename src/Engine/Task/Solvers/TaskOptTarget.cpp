@@ -26,6 +26,15 @@
 #include "Util/Tolerances.hpp"
 #include "Util/Clamp.hpp"
 
+static AATIsolineSegment
+MakeIsolineSegment(const AATPoint &ap, const AATIsolineCache *cache,
+                   const TaskProjection &projection)
+{
+  return cache != NULL
+    ? AATIsolineSegment(*cache, projection)
+    : AATIsolineSegment(ap, projection);
+}
+
 TaskOptTarget::TaskOptTarget(const std::vector<OrderedTaskPoint*>& tps,
                              const unsigned activeTaskPoint,
                              const AircraftState &_aircraft,
@@ -39,7 +48,8 @@ TaskOptTarget::TaskOptTarget(const std::vector<OrderedTaskPoint*>& tps,
    aircraft(_aircraft),
    tp_start(_ts),
    tp_current(_tp_current),
-   iso(_tp_current, projection)
+   cache(_tp_current.GetIsolineCache()),
+   iso(MakeIsolineSegment(_tp_current, cache, projection))
 {
 }
 
@@ -69,15 +79,35 @@ TaskOptTarget::search(const fixed tp)
     return fixed(-1);
   }
   if (iso.IsValid()) {
+    AATIsolineCache result;
+    if (cache != NULL) {
+      result = *cache;
+    } else {
+      result.previous = tp_current.GetPrevious()->GetLocationRemaining();
+      result.next = tp_current.GetNext()->GetLocationRemaining();
+      result.target = tp_current.GetTargetLocation();
+      iso.SaveTo(result);
+      result.defined = true;
+    }
+
+    /* start at the previous solution; if the situation hasn't changed
+       much, it is confirmed with only three evaluations */
+    const fixed p_start = cache != NULL ? cache->parameter : tp;
+
     tm.target_save();
-    const fixed t = find_min(tp);
+    fixed t = find_min(p_start);
     if (!valid(t)) {
       // invalid, so restore old value
       tm.target_restore();
-      return fixed(-1);
+      result.parameter = p_start;
+      t = fixed(-1);
     } else {
-      return t;
+      result.parameter = t;
     }
+
+    result.optimised_target = tp_current.GetTargetLocation();
+    tp_current.SetIsolineCache(result);
+    return t;
   } else {
     return fixed(-1);
   }
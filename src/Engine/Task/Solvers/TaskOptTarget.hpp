@@ -49,6 +49,11 @@ class TaskOptTarget gcc_final : public ZeroFinder
   StartPoint *tp_start;
   /** Active AATPoint */
   AATPoint &tp_current;
+  /**
+   * The previous result for the active AATPoint, or NULL if it is
+   * not applicable anymore
+   */
+  const AATIsolineCache *const cache;
   /** Isoline for active AATPoint target */
   AATIsolineSegment iso;
 
@@ -89,6 +94,9 @@ public:
    * to finish.
    *
    * Running this adjusts the target values for the active task point.
+   * The search starts at the previous solution if the isoline has not
+   * changed since then, and the result is stored in the AATPoint for
+   * the next call.
    *
    * @param p Default isoline value (0-1)
    *
@@ -136,6 +136,29 @@ IsReachable(const GlideResult &result, bool final_glide)
     : result.IsAchievable();
 }
 
+void
+AbortTask::SolveCandidates(const AircraftState &state,
+                           AlternateVector &approx_waypoints,
+                           const GlidePolar &polar) const
+{
+  /* the glide solution of a candidate does not depend on the
+     FillReachable() pass, therefore it is calculated only once here;
+     this is what TaskSolution::GlideSolutionRemaining() would
+     calculate for an UnorderedTaskPoint, without the overhead of
+     constructing one (and copying the Waypoint) for each candidate */
+  const fixed safety_height = task_behaviour.safety_height_arrival;
+
+  for (auto &v : approx_waypoints) {
+    const fixed elevation = std::max(fixed(0),
+                                     v.waypoint.elevation + safety_height);
+    v.solution =
+      TaskSolution::GlideSolutionRemaining(state.location,
+                                           v.waypoint.location, elevation,
+                                           state.altitude, state.wind,
+                                           task_behaviour.glide, polar);
+  }
+}
+
 bool
 AbortTask::FillReachable(const AircraftState &state,
                          AlternateVector &approx_waypoints,
@@ -145,46 +168,45 @@ AbortTask::FillReachable(const AircraftState &state,
   if (IsTaskFull() || approx_waypoints.empty())
     return false;
 
-  const AGeoPoint p_start(state.location, state.altitude);
-
   bool found_final_glide = false;
   reservable_priority_queue<Alternate, AlternateVector, AbortRank> q;
   q.reserve(32);
 
-  for (auto v = approx_waypoints.begin(); v != approx_waypoints.end();) {
-    if (only_airfield && !v->waypoint.IsAirport()) {
-      ++v;
-      continue;
-    }
-
-    UnorderedTaskPoint t(v->waypoint, task_behaviour);
-    GlideResult result =
-        TaskSolution::GlideSolutionRemaining(t, state,
-                                             task_behaviour.glide, polar);
+  /* move the accepted candidates to the queue, and compact the
+     remaining ones in place (instead of erasing each accepted one,
+     which would be quadratic) */
+  auto dest = approx_waypoints.begin();
+  for (auto v = approx_waypoints.begin(), end = approx_waypoints.end();
+       v != end; ++v) {
+    if (!only_airfield || v->waypoint.IsAirport()) {
+      const GlideResult &result = v->solution;
 
-    if (IsReachable(result, final_glide)) {
-      bool intersects = false;
-      const bool is_reachable_final = IsReachable(result, true);
+      if (IsReachable(result, final_glide)) {
+        bool intersects = false;
+        const bool is_reachable_final = IsReachable(result, true);
 
-      if (intersection_test && final_glide && is_reachable_final)
-        intersects = intersection_test->Intersects(
-            AGeoPoint(v->waypoint.location, result.min_arrival_altitude));
+        if (intersection_test && final_glide && is_reachable_final)
+          intersects = intersection_test->Intersects(
+              AGeoPoint(v->waypoint.location, result.min_arrival_altitude));
 
-      if (!intersects) {
-        q.push(Alternate(v->waypoint, result));
-        // remove it since it's already in the list now      
-        approx_waypoints.erase(v);
+        if (!intersects) {
+          q.push(std::move(*v));
 
-        if (is_reachable_final)
-          found_final_glide = true;
+          if (is_reachable_final)
+            found_final_glide = true;
 
-        continue; // skip incrementing v since we just erased it
+          continue; // don't keep it since it's already in the list now
+        }
       }
-    } 
+    }
 
-    ++v;
+    if (dest != v)
+      *dest = std::move(*v);
+    ++dest;
   }
 
+  approx_waypoints.erase(dest, approx_waypoints.end());
+
   while (!q.empty() && !IsTaskFull()) {
     const Alternate top = q.top();
     task_points.push_back(AlternateTaskPoint(top.waypoint, task_behaviour,
@@ -264,6 +286,8 @@ AbortTask::UpdateSample(const AircraftState &state,
     return false;
   }
 
+  SolveCandidates(state, approx_waypoints, glide_polar);
+
   // sort by arrival time
 
   // first try with final glide only
@@ -175,13 +175,26 @@ protected:
   fixed GetAbortRange(const AircraftState &state_now,
                       const GlidePolar &glide_polar) const;
 
+  /**
+   * Calculate the glide solution of each candidate waypoint and
+   * store it in Alternate::solution, for FillReachable().
+   *
+   * @param state Aircraft state
+   * @param approx_waypoints List of candidate waypoints
+   * @param polar Polar used for the solutions
+   */
+  void SolveCandidates(const AircraftState &state,
+                       AlternateVector &approx_waypoints,
+                       const GlidePolar &polar) const;
+
   /**
    * Fill abort task list with candidate waypoints given a list of
    * waypoints satisfying approximate range queries.  Can be used
    * to add airfields only, or landpoints.
    *
    * @param state Aircraft state
-   * @param approx_waypoints List of candidate waypoints
+   * @param approx_waypoints List of candidate waypoints, solved by
+   * SolveCandidates()
    * @param polar Polar used for tests
    * @param only_airfield If true, only add waypoints that are airfields.
    * @param final_glide Whether solution must be glide only or climb allowed
@@ -30,7 +30,6 @@
 
 #define TOLERANCE_POLAR_MINSINK 0.01
 #define TOLERANCE_POLAR_BESTLD 0.000001
-#define TOLERANCE_POLAR_DOLPHIN 0.0001
 
 #define TOLERANCE_GLIDE_REQUIRED 0.001
 #define TOLERANCE_MIN_TARGET 0.002
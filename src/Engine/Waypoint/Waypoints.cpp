@@ -208,6 +208,35 @@ Waypoints::GetNearestIf(const GeoPoint &loc, fixed range,
   return &*found.first;
 }
 
+static bool
+AlwaysTrue(const Waypoint &wp)
+{
+  return true;
+}
+
+unsigned
+Waypoints::GetNearest(const GeoPoint &loc, fixed range,
+                      const Waypoint **dest, unsigned max_results,
+                      bool (*predicate)(const Waypoint &)) const
+{
+  if (IsEmpty())
+    return 0;
+
+  Waypoint bb_target(loc);
+  bb_target.Project(task_projection);
+  const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
+  const unsigned n =
+    waypoint_tree.FindNearestIf(bb_target, mrange,
+                                predicate != NULL ? predicate : AlwaysTrue,
+                                dest, max_results);
+
+#ifdef INSTRUMENT_TASK
+  n_queries++;
+#endif
+
+  return n;
+}
+
 const Waypoint*
 Waypoints::LookupName(const TCHAR *name) const
 {
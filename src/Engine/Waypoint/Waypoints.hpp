@@ -325,6 +325,25 @@ public:
   const Waypoint *GetNearestIf(const GeoPoint &loc, fixed range,
                                bool (*predicate)(const Waypoint &)) const;
 
+  /**
+   * Looks up the waypoints nearest to the search location.
+   * Performs search according to flat-earth internal representation,
+   * so is approximate.
+   *
+   * @param loc Location from which to search
+   * @param range Distance in meters of search radius
+   * @param dest Array which receives the waypoints, sorted by
+   * distance (nearest first)
+   * @param max_results Size of the array
+   * @param predicate Optional callback that checks whether the
+   * waypoint is suitable for the request
+   *
+   * @return Number of waypoints which were found
+   */
+  unsigned GetNearest(const GeoPoint &loc, fixed range,
+                      const Waypoint **dest, unsigned max_results,
+                      bool (*predicate)(const Waypoint &)=NULL) const;
+
   /**
    * Access first waypoint in store, for use in iterators.
    *
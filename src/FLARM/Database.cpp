@@ -24,8 +24,41 @@ Copyright_License {
 #include "Database.hpp"
 #include "Util/StringUtil.hpp"
 
+#include <algorithm>
+
 #include <assert.h>
 
+unsigned
+FlarmDatabase::FindSlot(FlarmId id) const
+{
+  assert(!id_table.empty());
+
+  const unsigned mask = id_table.size() - 1;
+  const uint32_t hash = id.Hash();
+
+  /* linear probing; the table is never more than half full, so this
+     always finds an empty slot eventually */
+  for (unsigned i = (hash ^ (hash >> 16)) & mask;; i = (i + 1) & mask) {
+    const FlarmId slot_id = id_table[i].id;
+    if (!slot_id.IsDefined() || slot_id == id)
+      return i;
+  }
+}
+
+void
+FlarmDatabase::GrowIdTable()
+{
+  std::vector<IdSlot> old_table;
+  old_table.swap(id_table);
+
+  const IdSlot empty = { FlarmId::Undefined(), 0 };
+  id_table.assign(std::max<size_t>(64, old_table.size() * 2), empty);
+
+  for (const auto &slot : old_table)
+    if (slot.id.IsDefined())
+      id_table[FindSlot(slot.id)] = slot;
+}
+
 void
 FlarmDatabase::Insert(const FlarmRecord &record)
 {
@@ -34,19 +67,81 @@ FlarmDatabase::Insert(const FlarmRecord &record)
     /* ignore malformed records */
     return;
 
-  map.insert(std::make_pair(id, record));
+  if ((records.size() + 1) * 2 > id_table.size())
+    GrowIdTable();
+
+  IdSlot &slot = id_table[FindSlot(id)];
+  if (slot.id.IsDefined())
+    /* duplicate id: keep the first record */
+    return;
+
+  slot.id = id;
+  slot.index = records.size();
+  records.push_back(record);
+}
+
+void
+FlarmDatabase::Optimise()
+{
+  callsign_index.resize(records.size());
+  for (unsigned i = 0, n = records.size(); i < n; ++i)
+    callsign_index[i] = i;
+
+  /* stable: records with the same callsign remain in file order */
+  std::stable_sort(callsign_index.begin(), callsign_index.end(),
+                   [this](unsigned a, unsigned b) {
+                     return _tcscmp(records[a].callsign,
+                                    records[b].callsign) < 0;
+                   });
+}
+
+const FlarmRecord *
+FlarmDatabase::FindRecordById(FlarmId id) const
+{
+  if (id_table.empty())
+    return NULL;
+
+  const IdSlot &slot = id_table[FindSlot(id)];
+  return slot.id.IsDefined()
+    ? &records[slot.index]
+    : NULL;
+}
+
+std::pair<std::vector<unsigned>::const_iterator,
+          std::vector<unsigned>::const_iterator>
+FlarmDatabase::FindCallsignRange(const TCHAR *cn) const
+{
+  assert(IsCallsignIndexValid());
+
+  struct Compare {
+    const RecordVector &records;
+
+    bool operator()(unsigned a, const TCHAR *b) const {
+      return _tcscmp(records[a].callsign, b) < 0;
+    }
+
+    bool operator()(const TCHAR *a, unsigned b) const {
+      return _tcscmp(a, records[b].callsign) < 0;
+    }
+  };
+
+  return std::equal_range(callsign_index.begin(), callsign_index.end(),
+                          cn, Compare{records});
 }
 
 const FlarmRecord *
 FlarmDatabase::FindFirstRecordByCallSign(const TCHAR *cn) const
 {
-  for (const auto &i : map) {
-    assert(i.first.IsDefined());
+  if (IsCallsignIndexValid()) {
+    const auto range = FindCallsignRange(cn);
+    return range.first != range.second
+      ? &records[*range.first]
+      : NULL;
+  }
 
-    const FlarmRecord &record = i.second;
+  for (const auto &record : records)
     if (StringIsEqual(record.callsign, cn))
       return &record;
-  }
 
   return NULL;
 }
@@ -58,10 +153,17 @@ FlarmDatabase::FindRecordsByCallSign(const TCHAR *cn,
 {
   unsigned count = 0;
 
-  for (const auto &i : map) {
-    assert(i.first.IsDefined());
+  if (IsCallsignIndexValid()) {
+    const auto range = FindCallsignRange(cn);
+    for (auto i = range.first; i != range.second && count < size; ++i)
+      array[count++] = &records[*i];
+    return count;
+  }
+
+  for (const auto &record : records) {
+    if (count >= size)
+      break;
 
-    const FlarmRecord &record = i.second;
     if (StringIsEqual(record.callsign, cn))
       array[count++] = &record;
   }
@@ -75,12 +177,19 @@ FlarmDatabase::FindIdsByCallSign(const TCHAR *cn, FlarmId array[],
 {
   unsigned count = 0;
 
-  for (const auto &i : map) {
-    assert(i.first.IsDefined());
+  if (IsCallsignIndexValid()) {
+    const auto range = FindCallsignRange(cn);
+    for (auto i = range.first; i != range.second && count < size; ++i)
+      array[count++] = records[*i].GetId();
+    return count;
+  }
+
+  for (const auto &record : records) {
+    if (count >= size)
+      break;
 
-    const FlarmRecord &record = i.second;
     if (StringIsEqual(record.callsign, cn))
-      array[count++] = i.first;
+      array[count++] = record.GetId();
   }
 
   return count;
@@ -28,7 +28,7 @@ Copyright_License {
 #include "Record.hpp"
 #include "Compiler.h"
 
-#include <map>
+#include <vector>
 #include <tchar.h>
 
 class NLineReader;
@@ -36,34 +36,73 @@ class FlarmId;
 
 /**
  * An in-memory representation of the FlarmNet.org database.
+ *
+ * The records are stored in one contiguous array.  They are looked
+ * up by id in an open addressing hash table, and by callsign in a
+ * sorted index which is built by Optimise().  Pointers to records
+ * are invalidated by Insert() and Clear().
  */
 class FlarmDatabase {
-  typedef std::map<FlarmId, FlarmRecord> RecordMap;
-  RecordMap map;
+  typedef std::vector<FlarmRecord> RecordVector;
+  RecordVector records;
+
+  struct IdSlot {
+    /**
+     * The id of the record; FlarmId::Undefined() marks an empty
+     * slot.
+     */
+    FlarmId id;
+
+    /**
+     * Index into #records.
+     */
+    unsigned index;
+  };
+
+  /**
+   * Open addressing hash table keyed by FLARM id.  The size is
+   * always a power of two, and at most half of the slots are
+   * occupied.
+   */
+  std::vector<IdSlot> id_table;
+
+  /**
+   * Indices into #records, sorted by callsign.  This is built by
+   * Optimise(); as long as it is out of date, the callsign lookups
+   * fall back to a linear search.
+   */
+  std::vector<unsigned> callsign_index;
 
 public:
   bool IsEmpty() const {
-    return map.empty();
+    return records.empty();
   }
 
   void Clear() {
-    map.clear();
+    records.clear();
+    id_table.clear();
+    callsign_index.clear();
   }
 
+  /**
+   * Add a record.  Records with an invalid id and records whose id
+   * is already known are ignored.
+   */
   void Insert(const FlarmRecord &record);
 
+  /**
+   * Build the callsign index.  Call this after all records have been
+   * inserted.
+   */
+  void Optimise();
+
   /**
    * Finds a FLARMNetRecord object based on the given FLARM id
    * @param id FLARM id
    * @return FLARMNetRecord object
    */
   gcc_pure
-  const FlarmRecord *FindRecordById(FlarmId id) {
-    auto i = map.find(id);
-    return i != map.end()
-      ? &i->second
-      : NULL;
-  }
+  const FlarmRecord *FindRecordById(FlarmId id) const;
 
   /**
    * Finds a FLARMNetRecord object based on the given Callsign
@@ -78,13 +117,38 @@ public:
   unsigned FindIdsByCallSign(const TCHAR *cn, FlarmId array[],
                              unsigned size) const;
 
-  RecordMap::const_iterator begin() const {
-    return map.begin();
+  RecordVector::const_iterator begin() const {
+    return records.begin();
   }
 
-  RecordMap::const_iterator end() const {
-    return map.end();
+  RecordVector::const_iterator end() const {
+    return records.end();
   }
+
+private:
+  /**
+   * Returns the #id_table slot which contains the specified id, or
+   * the empty slot where it would be inserted.  Must not be called
+   * while the table is empty.
+   */
+  gcc_pure
+  unsigned FindSlot(FlarmId id) const;
+
+  void GrowIdTable();
+
+  gcc_pure
+  bool IsCallsignIndexValid() const {
+    return callsign_index.size() == records.size();
+  }
+
+  /**
+   * Returns the range of #callsign_index entries which refer to
+   * records with the specified callsign.
+   */
+  gcc_pure
+  std::pair<std::vector<unsigned>::const_iterator,
+            std::vector<unsigned>::const_iterator>
+  FindCallsignRange(const TCHAR *cn) const;
 };
 
 #endif
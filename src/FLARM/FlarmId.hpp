@@ -66,6 +66,16 @@ public:
     return value < other.value;
   }
 
+  /**
+   * Returns a hash code for this id, to be used for hash tables.
+   */
+  constexpr
+  uint32_t Hash() const {
+    /* multiplicative (Fibonacci) hashing, because FlarmNet ids are
+       often consecutive */
+    return value * 2654435761u;
+  }
+
   static FlarmId Parse(const char *input, char **endptr_r);
 #ifdef _UNICODE
   static FlarmId Parse(const TCHAR *input, TCHAR **endptr_r);
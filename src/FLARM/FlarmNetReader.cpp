@@ -36,6 +36,24 @@ Copyright_License {
 #include <stdio.h>
 #include <stdlib.h>
 
+/**
+ * Returns the value of the specified hexadecimal digit, or 0 if the
+ * character is not a hexadecimal digit.
+ */
+gcc_const
+static inline unsigned
+HexDigitValue(char ch)
+{
+  if (ch >= '0' && ch <= '9')
+    return ch - '0';
+  else if (ch >= 'A' && ch <= 'F')
+    return ch - 'A' + 10;
+  else if (ch >= 'a' && ch <= 'f')
+    return ch - 'a' + 10;
+  else
+    return 0;
+}
+
 /**
  * Decodes the FlarmNet.org file and puts the wanted
  * characters into the res pointer
@@ -54,16 +72,12 @@ LoadString(const char *bytes, size_t length, TCHAR *res, size_t res_size)
 
   TCHAR *p = res;
 
-  char tmp[3];
-  tmp[2] = 0;
-
   while (bytes < end) {
-    tmp[0] = *bytes++;
-    tmp[1] = *bytes++;
-
     /* FLARMNet files are ISO-Latin-1, which is kind of short-sighted */
 
-    const unsigned char ch = (unsigned char)strtoul(tmp, NULL, 16);
+    const unsigned char ch = (HexDigitValue(bytes[0]) << 4) |
+      HexDigitValue(bytes[1]);
+    bytes += 2;
 #ifdef _UNICODE
     /* Latin-1 can be converted to WIN32 wchar_t by casting */
     *p++ = ch;
@@ -139,6 +153,8 @@ FlarmNetReader::LoadFile(NLineReader &reader, FlarmDatabase &database)
     }
   }
 
+  database.Optimise();
+
   return itemCount;
 }
 
@@ -35,7 +35,11 @@ Copyright_License {
  * FLARM.
  */
 struct TrafficList {
-  static constexpr size_t MAX_COUNT = 25;
+  /**
+   * The maximum number of targets.  Large enough for the crowded
+   * launch grid of a competition.
+   */
+  static constexpr size_t MAX_COUNT = 50;
 
   /**
    * When was the last new traffic received?
@@ -0,0 +1,138 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "TrafficPredictor.hpp"
+#include "Math/Angle.hpp"
+
+#include <algorithm>
+
+#include <math.h>
+
+void
+TrafficPredictor::Update(const TrafficList &traffic, Angle own_track,
+                         fixed own_speed, fixed _own_climb_rate)
+{
+  count = 0;
+
+  for (const auto &t : traffic.list) {
+    if (!t.IsDefined())
+      continue;
+
+    const unsigned i = count++;
+    ids[i] = t.id;
+    north[i] = (float)t.relative_north;
+    east[i] = (float)t.relative_east;
+    altitude[i] = (float)(fixed)t.relative_altitude;
+
+    /* FLARM does not always send track, speed, turn rate and climb
+       rate (e.g. for stealth targets); the missing components are
+       assumed to be zero */
+    const bool moving = t.track_received && t.speed_received;
+    track[i] = moving ? (float)((Angle)t.track).Radians() : 0.f;
+    speed[i] = moving ? (float)(fixed)t.speed : 0.f;
+    turn_rate[i] = moving && t.turn_rate_received
+      ? (float)Angle::Degrees(t.turn_rate).Radians()
+      : 0.f;
+    climb_rate[i] = t.climb_rate_received ? (float)t.climb_rate : 0.f;
+  }
+
+  own_north_speed = (float)(own_speed * own_track.cos());
+  own_east_speed = (float)(own_speed * own_track.sin());
+  own_climb_rate = (float)_own_climb_rate;
+
+  Predict(fixed(0));
+
+  std::fill(cpa_time, cpa_time + count, 0.f);
+  std::fill(cpa_distance, cpa_distance + count, 0.f);
+}
+
+void
+TrafficPredictor::Predict(fixed _dt)
+{
+  const float dt = (float)_dt;
+  const float own_north = own_north_speed * dt;
+  const float own_east = own_east_speed * dt;
+  const float own_altitude = own_climb_rate * dt;
+
+  for (unsigned i = 0; i < count; ++i) {
+    /* integrate the velocity along a circular arc: the track changes
+       by "turn_rate * dt"; the chord is the straight-line distance
+       scaled by sin(x)/x of half that angle */
+    const float half_turn = 0.5f * turn_rate[i] * dt;
+    const float heading = track[i] + half_turn;
+    const float chord_factor = fabsf(half_turn) > 1e-4f
+      ? sinf(half_turn) / half_turn
+      : 1.f;
+    const float distance = speed[i] * dt * chord_factor;
+
+    predicted_north[i] = north[i] + distance * cosf(heading) - own_north;
+    predicted_east[i] = east[i] + distance * sinf(heading) - own_east;
+    predicted_altitude[i] = altitude[i] + climb_rate[i] * dt - own_altitude;
+
+    const float new_track = track[i] + 2 * half_turn;
+    predicted_north_speed[i] = speed[i] * cosf(new_track);
+    predicted_east_speed[i] = speed[i] * sinf(new_track);
+  }
+}
+
+void
+TrafficPredictor::UpdateClosestApproach(fixed _max_time)
+{
+  const float max_time = (float)_max_time;
+
+  /* no branches and no library calls in this loop, so the compiler
+     can vectorise it */
+  for (unsigned i = 0; i < count; ++i) {
+    const float vn = predicted_north_speed[i] - own_north_speed;
+    const float ve = predicted_east_speed[i] - own_east_speed;
+    const float vu = climb_rate[i] - own_climb_rate;
+
+    const float pn = predicted_north[i];
+    const float pe = predicted_east[i];
+    const float pu = predicted_altitude[i];
+
+    /* minimise |p + v*t|; the derivative is zero at t = -p.v / v.v */
+    const float v2 = vn * vn + ve * ve + vu * vu;
+    const float pv = pn * vn + pe * ve + pu * vu;
+    const float t = std::min(std::max(-pv / std::max(v2, 1e-6f), 0.f),
+                             max_time);
+
+    const float dn = pn + vn * t, de = pe + ve * t, du = pu + vu * t;
+    cpa_time[i] = t;
+    cpa_distance[i] = sqrtf(dn * dn + de * de + du * du);
+  }
+}
+
+int
+TrafficPredictor::FindMostCritical(fixed _max_distance) const
+{
+  const float max_distance = (float)_max_distance;
+
+  int result = -1;
+  for (unsigned i = 0; i < count; ++i)
+    if (cpa_distance[i] <= max_distance &&
+        (result < 0 || cpa_time[i] < cpa_time[result]))
+      result = i;
+
+  return result;
+}
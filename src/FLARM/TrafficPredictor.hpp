@@ -0,0 +1,192 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_FLARM_TRAFFIC_PREDICTOR_HPP
+#define XCSOAR_FLARM_TRAFFIC_PREDICTOR_HPP
+
+#include "List.hpp"
+#include "FlarmId.hpp"
+#include "Math/fixed.hpp"
+#include "Compiler.h"
+
+#include <assert.h>
+
+class Angle;
+
+/**
+ * Extrapolates the positions of FLARM targets between two traffic
+ * updates, and calculates the closest point of approach of each
+ * target.
+ *
+ * The target states are stored as a structure of arrays of plain
+ * floats, which allows the compiler to vectorise the loops which
+ * process all targets at once.  All positions are relative to our
+ * own aircraft, in metres north/east/up.
+ */
+class TrafficPredictor {
+public:
+  static constexpr unsigned MAX_COUNT = TrafficList::MAX_COUNT;
+
+  /**
+   * The look-ahead time for the conflict screening in the user
+   * interface [s].
+   */
+  static constexpr unsigned CONFLICT_TIME = 30;
+
+  /**
+   * A target whose closest approach is nearer than this is a
+   * conflict [m].
+   */
+  static constexpr unsigned CONFLICT_DISTANCE = 300;
+
+private:
+  unsigned count;
+
+  FlarmId ids[MAX_COUNT];
+
+  /**
+   * The relative position at the time of the last Update() [m].
+   */
+  float north[MAX_COUNT], east[MAX_COUNT], altitude[MAX_COUNT];
+
+  /**
+   * The track [rad], ground speed [m/s], turn rate [rad/s] and climb
+   * rate [m/s] of each target.
+   */
+  float track[MAX_COUNT], speed[MAX_COUNT];
+  float turn_rate[MAX_COUNT], climb_rate[MAX_COUNT];
+
+  /**
+   * Our own velocity [m/s].
+   */
+  float own_north_speed, own_east_speed, own_climb_rate;
+
+  /**
+   * The relative positions calculated by Predict() [m].
+   */
+  float predicted_north[MAX_COUNT], predicted_east[MAX_COUNT];
+  float predicted_altitude[MAX_COUNT];
+
+  /**
+   * The velocity of each target at the time passed to Predict()
+   * [m/s].
+   */
+  float predicted_north_speed[MAX_COUNT], predicted_east_speed[MAX_COUNT];
+
+  /**
+   * The time until the closest approach [s] and the distance at that
+   * time [m], calculated by UpdateClosestApproach().
+   */
+  float cpa_time[MAX_COUNT], cpa_distance[MAX_COUNT];
+
+public:
+  TrafficPredictor():count(0) {}
+
+  unsigned size() const {
+    return count;
+  }
+
+  bool empty() const {
+    return count == 0;
+  }
+
+  FlarmId GetId(unsigned i) const {
+    assert(i < count);
+
+    return ids[i];
+  }
+
+  /**
+   * Load the state of all valid targets.  The predicted positions
+   * are initialised with the current ones, and the closest approach
+   * values are reset.  Targets without track or speed are assumed
+   * to be stationary; a missing turn rate or climb rate is assumed
+   * to be zero.
+   *
+   * @param own_track our own track
+   * @param own_speed our own ground speed [m/s]
+   * @param own_climb_rate our own climb rate [m/s]
+   */
+  void Update(const TrafficList &traffic, Angle own_track, fixed own_speed,
+              fixed own_climb_rate);
+
+  /**
+   * Dead-reckon all targets (and our own aircraft) from their track,
+   * speed, turn rate and climb rate.  The results are available from
+   * GetPredictedNorth() etc.
+   *
+   * @param dt the time since the last Update() [s]
+   */
+  void Predict(fixed dt);
+
+  /**
+   * Calculate the time and distance of the closest approach for all
+   * targets, assuming both aircraft fly straight from the predicted
+   * positions.
+   *
+   * @param max_time the maximum time to look ahead [s]; targets
+   * which are closest later than this get the distance at this time
+   */
+  void UpdateClosestApproach(fixed max_time);
+
+  fixed GetPredictedNorth(unsigned i) const {
+    assert(i < count);
+
+    return fixed(predicted_north[i]);
+  }
+
+  fixed GetPredictedEast(unsigned i) const {
+    assert(i < count);
+
+    return fixed(predicted_east[i]);
+  }
+
+  fixed GetPredictedAltitude(unsigned i) const {
+    assert(i < count);
+
+    return fixed(predicted_altitude[i]);
+  }
+
+  fixed GetClosestApproachTime(unsigned i) const {
+    assert(i < count);
+
+    return fixed(cpa_time[i]);
+  }
+
+  fixed GetClosestApproachDistance(unsigned i) const {
+    assert(i < count);
+
+    return fixed(cpa_distance[i]);
+  }
+
+  /**
+   * Find the target with the earliest closest approach which passes
+   * within the specified distance.
+   *
+   * @return the index of the target or -1 if there is none
+   */
+  gcc_pure
+  int FindMostCritical(fixed max_distance) const;
+};
+
+#endif
@@ -28,12 +28,15 @@
 #include "Screen/Canvas.hpp"
 #include "Screen/Layout.hpp"
 #include "Screen/Key.h"
+#include "Screen/Timer.hpp"
 #include "Form/SymbolButton.hpp"
 #include "UIGlobals.hpp"
 #include "Look/Look.hpp"
 #include "Profile/Profile.hpp"
 #include "Compiler.h"
 #include "FLARM/Friends.hpp"
+#include "FLARM/TrafficPredictor.hpp"
+#include "Time/PeriodClock.hpp"
 #include "Look/FlarmTrafficLook.hpp"
 #include "Gauge/FlarmTrafficWindow.hpp"
 #include "Language/Language.hpp"
@@ -54,19 +57,42 @@ protected:
   Angle task_direction;
   GestureManager gestures;
 
+  /**
+   * Moves the targets between two traffic updates.
+   */
+  TrafficPredictor predictor;
+
+  /**
+   * Measures the time since the last Update().
+   */
+  PeriodClock update_clock;
+
+  /**
+   * Repaints the predicted positions.  It is active while there is
+   * traffic.
+   */
+  WindowTimer predict_timer;
+
 public:
   FlarmTrafficControl(const FlarmTrafficLook &look)
     :FlarmTrafficWindow(look, Layout::Scale(10),
                         Layout::GetMinimumControlHeight() + Layout::Scale(2)),
      enable_auto_zoom(true),
      zoom(2),
-     task_direction(Angle::Degrees(-1)) {}
+     task_direction(Angle::Degrees(-1)),
+     predict_timer(*this) {}
 
 protected:
   void CalcAutoZoom();
 
+  /**
+   * Replace the positions in #data with the predicted ones.
+   */
+  void Predict();
+
 public:
-  void Update(Angle new_direction, const TrafficList &new_data,
+  void Update(Angle new_direction, fixed ground_speed, fixed climb_rate,
+              const TrafficList &new_data,
               const TeamCodeSettings &new_settings);
   void UpdateTaskDirection(bool show_task_direction, Angle bearing);
 
@@ -122,6 +148,8 @@ protected:
 
 protected:
   virtual void OnCreate();
+  virtual void OnDestroy();
+  virtual bool OnTimer(WindowTimer &timer);
   virtual void OnPaint(Canvas &canvas);
   virtual bool OnMouseMove(PixelScalar x, PixelScalar y, unsigned keys);
   virtual bool OnMouseDown(PixelScalar x, PixelScalar y);
@@ -143,6 +171,14 @@ FlarmTrafficControl::OnCreate()
   enable_north_up = settings.north_up;
 }
 
+void
+FlarmTrafficControl::OnDestroy()
+{
+  predict_timer.Cancel();
+
+  FlarmTrafficWindow::OnDestroy();
+}
+
 unsigned
 FlarmTrafficControl::GetZoomDistance(unsigned zoom)
 {
@@ -203,15 +239,66 @@ FlarmTrafficControl::CalcAutoZoom()
 }
 
 void
-FlarmTrafficControl::Update(Angle new_direction, const TrafficList &new_data,
+FlarmTrafficControl::Predict()
+{
+  /* don't extrapolate forever when the traffic updates stop */
+  const int elapsed = std::min(update_clock.Elapsed(), 3000);
+  predictor.Predict(fixed(elapsed) / 1000);
+
+  for (unsigned i = 0; i < predictor.size(); ++i) {
+    FlarmTraffic *traffic = data.FindTraffic(predictor.GetId(i));
+    if (traffic == NULL)
+      continue;
+
+    traffic->relative_north = predictor.GetPredictedNorth(i);
+    traffic->relative_east = predictor.GetPredictedEast(i);
+    traffic->relative_altitude = predictor.GetPredictedAltitude(i);
+    traffic->distance = hypot(traffic->relative_north,
+                              traffic->relative_east);
+  }
+}
+
+void
+FlarmTrafficControl::Update(Angle new_direction, fixed ground_speed,
+                            fixed climb_rate, const TrafficList &new_data,
                             const TeamCodeSettings &new_settings)
 {
   FlarmTrafficWindow::Update(new_direction, new_data, new_settings);
 
+  predictor.Update(data, new_direction, ground_speed, climb_rate);
+  update_clock.Update();
+
+  /* mark the target which will pass closest, unless FLARM already
+     warns */
+  predictor.UpdateClosestApproach(fixed(TrafficPredictor::CONFLICT_TIME));
+  const int critical =
+    predictor.FindMostCritical(fixed(TrafficPredictor::CONFLICT_DISTANCE));
+  if (critical >= 0 && !WarningMode()) {
+    const FlarmTraffic *traffic = data.FindTraffic(predictor.GetId(critical));
+    if (traffic != NULL)
+      conflict = data.TrafficIndex(traffic);
+  }
+
+  if (predictor.empty())
+    predict_timer.Cancel();
+  else if (!predict_timer.IsActive())
+    predict_timer.Schedule(250);
+
   if (enable_auto_zoom || WarningMode())
     CalcAutoZoom();
 }
 
+bool
+FlarmTrafficControl::OnTimer(WindowTimer &timer)
+{
+  if (timer != predict_timer)
+    return FlarmTrafficWindow::OnTimer(timer);
+
+  Predict();
+  Invalidate();
+  return true;
+}
+
 void
 FlarmTrafficControl::UpdateTaskDirection(bool show_task_direction, Angle bearing)
 {
@@ -643,7 +730,7 @@ TrafficWidget::ToggleNorthUp()
 void
 TrafficWidget::Update()
 {
-  const NMEAInfo &basic = CommonInterface::Basic();
+  const MoreData &basic = CommonInterface::Basic();
   const DerivedInfo &calculated = CommonInterface::Calculated();
 
   if (CommonInterface::GetUISettings().traffic.auto_close_dialog &&
@@ -656,6 +743,8 @@ TrafficWidget::Update()
   }
 
   view->Update(basic.track,
+               basic.ground_speed_available ? basic.ground_speed : fixed(0),
+               basic.brutto_vario,
                basic.flarm.traffic,
                CommonInterface::GetComputerSettings().team_code);
 
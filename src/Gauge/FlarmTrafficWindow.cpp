@@ -44,7 +44,7 @@ FlarmTrafficWindow::FlarmTrafficWindow(const FlarmTrafficLook &_look,
                                        bool _small)
   :look(_look),
    distance(2000),
-   selection(-1), warning(-1),
+   selection(-1), warning(-1), conflict(-1),
    h_padding(_h_padding), v_padding(_v_padding),
    small(_small),
    enable_north_up(false),
@@ -194,6 +194,7 @@ FlarmTrafficWindow::Update(Angle new_direction, const TrafficList &new_data,
   fir.SetAngle(heading);
   data = new_data;
   settings = new_settings;
+  conflict = -1;
 
   UpdateWarnings();
   UpdateSelector(selection_id, pt);
@@ -325,6 +326,12 @@ FlarmTrafficWindow::PaintRadarTarget(Canvas &canvas,
         circles = 1;
       }
 
+      // Mark a target which will pass close
+      if (static_cast<unsigned> (conflict) == i) {
+        circle_pen = &look.warning_pen;
+        circles = 1;
+      }
+
       if (!small && static_cast<unsigned> (selection) == i) {
         text_color = &look.selection_color;
         target_brush = arrow_brush = &look.selection_brush;
@@ -48,6 +48,13 @@ protected:
 
   int selection;
   int warning;
+
+  /**
+   * The index of a target which will pass close, but has no FLARM
+   * alarm yet; -1 if there is none.  This is not calculated by this
+   * class; it is reset by Update().
+   */
+  int conflict;
   RasterPoint radar_mid;
 
   /**
@@ -41,6 +41,7 @@ TrafficLook::Initialise()
   team_pen_blue.Set(width, Color(0, 0x90, 0xFF));
   team_pen_yellow.Set(width, Color(0xFF, 0xE8, 0));
   team_pen_magenta.Set(width, Color(0xFF, 0, 0xCB));
+  conflict_pen.Set(width, warning_color);
 
   teammate_icon.Load(IDB_TEAMMATE_POS, IDB_TEAMMATE_POS_HD);
 }
@@ -43,6 +43,12 @@ struct TrafficLook {
   Pen team_pen_yellow;
   Pen team_pen_magenta;
 
+  /**
+   * Marks a target which will pass close, before FLARM raises an
+   * alarm.
+   */
+  Pen conflict_pen;
+
   MaskedIcon teammate_icon;
 
   void Initialise();
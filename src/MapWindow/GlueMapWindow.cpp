@@ -174,6 +174,19 @@ GlueMapWindow::QuickRedraw()
 #endif
 }
 
+#ifndef ENABLE_OPENGL
+
+void
+GlueMapWindow::OnTopographyLoaded()
+{
+  /* the new shapes must be published by the DrawThread, which is the
+     one reading them; Idle() does that after the next frame */
+  if (draw_thread != NULL)
+    draw_thread->TriggerRedraw();
+}
+
+#endif
+
 /**
  * This idle function allows progressive scanning of visibility etc
  */
@@ -203,7 +216,7 @@ GlueMapWindow::Idle()
     idle_robin = (idle_robin + 1) % 3;
     switch (idle_robin) {
     case 0:
-      topography_dirty = UpdateTopography(1) > 0;
+      topography_dirty = UpdateTopography() > 0;
       break;
 
     case 1:
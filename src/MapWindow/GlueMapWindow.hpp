@@ -182,6 +182,9 @@ protected:
   virtual void DrawThermalEstimate(Canvas &canvas) const gcc_override;
   virtual void RenderTrail(Canvas &canvas,
                            const RasterPoint aircraft_pos) gcc_override;
+#ifndef ENABLE_OPENGL
+  virtual void OnTopographyLoaded() gcc_override;
+#endif
 
   /* virtual methods from class Window */
   virtual bool OnMouseDouble(PixelScalar x, PixelScalar y) gcc_override;
@@ -24,6 +24,7 @@ Copyright_License {
 #include "MapItemListBuilder.hpp"
 
 #include "Util/StaticArray.hpp"
+#include "Util/Macros.hpp"
 #include "Engine/Airspace/AirspaceVisitor.hpp"
 #include "Engine/Airspace/AirspaceWarning.hpp"
 #include "Engine/Airspace/AbstractAirspace.hpp"
@@ -32,7 +33,6 @@ Copyright_License {
 #include "Engine/Task/Ordered/Points/OrderedTaskPoint.hpp"
 #include "Airspace/AirspaceVisibility.hpp"
 #include "Airspace/ProtectedAirspaceWarningManager.hpp"
-#include "Engine/Waypoint/WaypointVisitor.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
 #include "NMEA/Aircraft.hpp"
 #include "Task/ProtectedTaskManager.hpp"
@@ -52,6 +52,8 @@ Copyright_License {
 #include "Weather/NOAAStore.hpp"
 #endif
 
+#include <algorithm>
+
 class AirspaceWarningList
 {
   StaticArray<const AbstractAirspace *,64> list;
@@ -118,20 +120,6 @@ public:
   }
 };
 
-class WaypointListBuilderVisitor:
-  public WaypointVisitor
-{
-  MapItemList &list;
-
-public:
-  WaypointListBuilderVisitor(MapItemList &_list):list(_list) {}
-
-  void Visit(const Waypoint &waypoint) {
-    if (!list.full())
-      list.append(new WaypointMapItem(waypoint));
-  }
-};
-
 void
 MapItemListBuilder::AddLocation(const NMEAInfo &basic,
                                 const RasterTerrain *terrain)
@@ -199,8 +187,16 @@ MapItemListBuilder::AddSelfIfNear(const GeoPoint &self, Angle bearing)
 void
 MapItemListBuilder::AddWaypoints(const Waypoints &waypoints)
 {
-  WaypointListBuilderVisitor waypoint_list_builder(list);
-  waypoints.VisitWithinRange(location, range, waypoint_list_builder);
+  /* if there are more waypoints in range than the list can hold,
+     keep the ones nearest to the location */
+  const Waypoint *nearest[32];
+  const unsigned max_results = std::min(list.capacity() - list.size(),
+                                        (unsigned)ARRAY_SIZE(nearest));
+
+  const unsigned n = waypoints.GetNearest(location, range,
+                                          nearest, max_results);
+  for (unsigned i = 0; i < n; ++i)
+    list.append(new WaypointMapItem(*nearest[i]));
 }
 
 void
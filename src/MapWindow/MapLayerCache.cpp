@@ -0,0 +1,101 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "MapLayerCache.hpp"
+#include "Projection/WindowProjection.hpp"
+
+#include <assert.h>
+
+bool
+MapLayerCache::IsValid(const WindowProjection &projection) const
+{
+  /* the buffer may have been discarded by the OpenGL surface
+     listener */
+  return valid && buffer.IsDefined() &&
+    projection.GetGeoLocation() == location &&
+    projection.GetScreenOrigin().x == origin.x &&
+    projection.GetScreenOrigin().y == origin.y &&
+    projection.GetScreenAngle() == angle &&
+    projection.GetScale() == scale &&
+    projection.GetScreenWidth() == width &&
+    projection.GetScreenHeight() == height;
+}
+
+Canvas &
+MapLayerCache::Begin(Canvas &canvas, const WindowProjection &projection)
+{
+  location = projection.GetGeoLocation();
+  origin = projection.GetScreenOrigin();
+  angle = projection.GetScreenAngle();
+  scale = projection.GetScale();
+  width = projection.GetScreenWidth();
+  height = projection.GetScreenHeight();
+  valid = false;
+
+#ifdef ENABLE_OPENGL
+  if (!buffer.IsDefined())
+    buffer.Create(canvas);
+
+  buffer.Begin(canvas);
+#else
+  if (!buffer.IsDefined())
+    buffer.Create(canvas);
+  else
+    buffer.Resize(canvas.GetWidth(), canvas.GetHeight());
+#endif
+
+  return buffer;
+}
+
+void
+MapLayerCache::Commit(Canvas &canvas)
+{
+#ifdef ENABLE_OPENGL
+  buffer.Commit(canvas);
+#else
+  canvas.Copy(buffer);
+#endif
+
+  valid = true;
+}
+
+void
+MapLayerCache::CopyTo(Canvas &canvas)
+{
+  assert(valid);
+
+#ifdef ENABLE_OPENGL
+  buffer.CopyTo(canvas);
+#else
+  canvas.Copy(buffer);
+#endif
+}
+
+void
+MapLayerCache::Destroy()
+{
+  valid = false;
+
+  if (buffer.IsDefined())
+    buffer.Destroy();
+}
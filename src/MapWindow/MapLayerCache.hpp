@@ -0,0 +1,100 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_MAP_LAYER_CACHE_HPP
+#define XCSOAR_MAP_LAYER_CACHE_HPP
+
+#include "Screen/BufferCanvas.hpp"
+#include "Screen/Point.hpp"
+#include "Math/Angle.hpp"
+#include "Geo/GeoPoint.hpp"
+
+class Canvas;
+class WindowProjection;
+
+/**
+ * Keeps a rendered map layer in an off-screen buffer (a frame buffer
+ * object on OpenGL), so it can be copied to the screen instead of
+ * being rendered again while neither the projection nor the layer's
+ * data have changed.
+ *
+ * This class only checks the projection; the caller is responsible
+ * for checking the data and calling Invalidate() when it changes.
+ * Only opaque layers can be cached, because the buffer replaces
+ * everything which was painted before.
+ */
+class MapLayerCache {
+  BufferCanvas buffer;
+
+  /**
+   * The attributes of the projection the buffer was rendered with.
+   * Unlike #CompareProjection, the comparison is exact, because
+   * even a one-pixel offset would be visible.
+   */
+  GeoPoint location;
+  RasterPoint origin;
+  Angle angle;
+  fixed scale;
+  unsigned width, height;
+
+  bool valid;
+
+public:
+  MapLayerCache():valid(false) {}
+
+  void Invalidate() {
+    valid = false;
+  }
+
+  /**
+   * Does the buffer contain the layer for the specified projection?
+   */
+  gcc_pure
+  bool IsValid(const WindowProjection &projection) const;
+
+  /**
+   * Begin rendering the layer into the buffer.  The caller must paint
+   * the whole layer into the returned #Canvas and then call Commit().
+   *
+   * @param canvas the on-screen #Canvas
+   */
+  Canvas &Begin(Canvas &canvas, const WindowProjection &projection);
+
+  /**
+   * Finish rendering, and copy the buffer to the on-screen #Canvas.
+   */
+  void Commit(Canvas &canvas);
+
+  /**
+   * Copy the buffer to the on-screen #Canvas.  IsValid() must have
+   * returned true.
+   */
+  void CopyTo(Canvas &canvas);
+
+  /**
+   * Free the buffer.
+   */
+  void Destroy();
+};
+
+#endif
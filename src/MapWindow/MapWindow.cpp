@@ -26,6 +26,7 @@ Copyright_License {
 #include "Screen/Layout.hpp"
 #include "Topography/TopographyStore.hpp"
 #include "Topography/TopographyRenderer.hpp"
+#include "Topography/TopographyThread.hpp"
 #include "Terrain/RasterTerrain.hpp"
 #include "Terrain/RasterWeather.hpp"
 #include "Computer/GlideComputer.hpp"
@@ -42,7 +43,7 @@ MapWindow::MapWindow(const MapLook &_look,
   :look(_look),
    follow_mode(FOLLOW_SELF),
    waypoints(NULL),
-   topography(NULL), topography_renderer(NULL),
+   topography(NULL), topography_renderer(NULL), topography_thread(NULL),
    terrain(NULL),
    terrain_radius(fixed(0)),
    weather(NULL),
@@ -67,6 +68,7 @@ MapWindow::MapWindow(const MapLook &_look,
 
 MapWindow::~MapWindow()
 {
+  delete topography_thread;
   delete topography_renderer;
 }
 
@@ -116,13 +118,52 @@ MapWindow::ReadBlackboard(const MoreData &nmea_info,
   ReadMapSettings(settings_map);
 }
 
+GeoBounds
+MapWindow::GetTopographyArea() const
+{
+  GeoBounds area = visible_projection.GetScreenBounds();
+
+  const NMEAInfo &basic = Basic();
+  if (!IsNearSelf() || !basic.location_available)
+    return area;
+
+  /* prefetch the shapes which will scroll into view soon: include the
+     point the aircraft will reach within the next two minutes, and
+     the active turn point, where the map is going to rotate; both are
+     limited to one screen size, so the cache doesn't grow too large
+     (TopographyFile::LoadShapes() doubles the area) */
+  const fixed max_distance = visible_projection.GetScreenDistanceMeters();
+
+  if (basic.track_available && basic.MovementDetected()) {
+    const fixed distance = std::min(basic.ground_speed * 120, max_distance);
+    area.Extend(GeoVector(distance, basic.track).EndPoint(basic.location));
+  }
+
+  const GeoPoint &target =
+    Calculated().task_stats.current_leg.location_remaining;
+  if (target.IsValid() && basic.location.Distance(target) <= max_distance)
+    area.Extend(target);
+
+  return area;
+}
+
 unsigned
-MapWindow::UpdateTopography(unsigned max_update)
+MapWindow::UpdateTopography()
 {
-  if (topography != NULL && GetMapSettings().topography_enabled)
-    return topography->ScanVisibility(visible_projection, max_update);
-  else
+  if (topography_thread == NULL || !GetMapSettings().topography_enabled)
     return 0;
+
+  const unsigned num_updated = topography_thread->Publish();
+  topography_thread->Trigger(visible_projection.GetMapScale(),
+                             GetTopographyArea());
+  return num_updated;
+}
+
+void
+MapWindow::OnTopographyLoaded()
+{
+  if (topography_thread != NULL && topography_thread->Publish() > 0)
+    Invalidate();
 }
 
 bool
@@ -192,12 +233,22 @@ MapWindow::OnPaintBuffer(Canvas &canvas)
 void
 MapWindow::SetTopography(TopographyStore *_topography)
 {
+  /* stop the thread before the old store may be modified or
+     deleted */
+  delete topography_thread;
+  topography_thread = NULL;
+
   topography = _topography;
 
   delete topography_renderer;
   topography_renderer = topography != NULL
     ? new TopographyRenderer(*topography)
     : NULL;
+
+  if (topography != NULL)
+    topography_thread = new TopographyThread(*topography, [this]() {
+        OnTopographyLoaded();
+      });
 }
 
 void
@@ -30,12 +30,15 @@ Copyright_License {
 #ifndef ENABLE_OPENGL
 #include "Screen/BufferCanvas.hpp"
 #endif
+#include "MapLayerCache.hpp"
 #include "Renderer/LabelBlock.hpp"
 #include "Screen/StopWatch.hpp"
 #include "MapWindowBlackboard.hpp"
 #include "Renderer/BackgroundRenderer.hpp"
 #include "Renderer/WaypointRenderer.hpp"
 #include "Renderer/TrailRenderer.hpp"
+#include "Terrain/TerrainSettings.hpp"
+#include "Util/Serial.hpp"
 #include "Compiler.h"
 #include "Weather/Features.hpp"
 #include "Tracking/SkyLines/Features.hpp"
@@ -44,8 +47,10 @@ struct MapLook;
 struct TrafficLook;
 class TopographyStore;
 class TopographyRenderer;
+class TopographyThread;
 class RasterTerrain;
 class RasterWeather;
+class RasterMap;
 class ProtectedMarkers;
 class Waypoints;
 struct Waypoint;
@@ -119,6 +124,12 @@ protected:
   TopographyStore *topography;
   TopographyRenderer *topography_renderer;
 
+  /**
+   * Reads the topography shapes in background.  Exists whenever
+   * #topography is set.
+   */
+  TopographyThread *topography_thread;
+
   RasterTerrain *terrain;
   GeoPoint terrain_center;
   fixed terrain_radius;
@@ -128,6 +139,42 @@ protected:
   const TrafficLook &traffic_look;
 
   BackgroundRenderer background;
+
+  /**
+   * Everything besides the projection which affects the rendering of
+   * terrain and topography.
+   */
+  struct BackgroundState {
+    const RasterTerrain *terrain;
+    Serial terrain_serial;
+    TerrainRendererSettings terrain_settings;
+    Angle shading_angle;
+
+    const RasterMap *weather_map;
+    Serial weather_serial;
+    unsigned weather_parameter;
+
+    const TopographyStore *topography;
+    Serial topography_serial;
+    bool topography_enabled;
+
+    bool operator==(const BackgroundState &other) const;
+
+    bool operator!=(const BackgroundState &other) const {
+      return !(*this == other);
+    }
+  };
+
+  /**
+   * Terrain and topography, rendered with #background_state.  These
+   * are the most expensive layers, and they change less often than
+   * the others, e.g. not on a FLARM update.  The layers above are
+   * cheap, change often or are translucent, and are rendered on
+   * every frame.
+   */
+  MapLayerCache background_cache;
+  BackgroundState background_state;
+
   WaypointRenderer waypoint_renderer;
 
   AirspaceRenderer airspace_renderer;
@@ -288,7 +335,14 @@ protected:
    */
   virtual void Render(Canvas &canvas, const PixelRect &rc);
 
-  unsigned UpdateTopography(unsigned max_update=1024);
+  /**
+   * Publish the topography shapes which were loaded by the
+   * #TopographyThread, and ask it to load the ones which will be
+   * needed next.  This does not block on shapefile I/O.
+   *
+   * @return the number of topography files which were updated
+   */
+  unsigned UpdateTopography();
 
   /**
    * @return true if UpdateTerrain() should be called again
@@ -316,7 +370,31 @@ protected:
   /* virtual methods from class DoubleBufferWindow */
   virtual void OnPaintBuffer(Canvas& canvas) gcc_override;
 
+  /**
+   * Called in the main thread after the #TopographyThread has loaded
+   * new shapes.  The default implementation publishes them and
+   * redraws the map.
+   */
+  virtual void OnTopographyLoaded();
+
 private:
+  /**
+   * Calculate the area which shall be covered by the topography
+   * cache: the visible screen, extended in the direction the aircraft
+   * is heading.
+   */
+  gcc_pure
+  GeoBounds GetTopographyArea() const;
+
+  gcc_pure
+  BackgroundState GetBackgroundState() const;
+
+  /**
+   * Renders the terrain and the topography, or copies them from
+   * #background_cache if nothing has changed
+   * @param canvas The drawing canvas
+   */
+  void RenderBackground(Canvas &canvas);
   /**
    * Renders the terrain background
    * @param canvas The drawing canvas
@@ -80,6 +80,8 @@ MapWindow::OnDestroy()
   SetTerrain(NULL);
   SetWeather(NULL);
 
+  background_cache.Destroy();
+
 #ifndef ENABLE_OPENGL
   buffer_canvas.Destroy();
 
@@ -24,21 +24,105 @@ Copyright_License {
 #include "MapWindow.hpp"
 #include "Look/MapLook.hpp"
 #include "Markers/ProtectedMarkers.hpp"
+#include "Topography/TopographyStore.hpp"
 #include "Topography/TopographyRenderer.hpp"
+#include "Terrain/RasterTerrain.hpp"
+#include "Terrain/RasterWeather.hpp"
+#include "Terrain/RasterMap.hpp"
 #include "Task/ProtectedTaskManager.hpp"
 #include "Units/Units.hpp"
 #include "Renderer/AircraftRenderer.hpp"
 #include "Renderer/MarkerRenderer.hpp"
+#include "Asset.hpp"
 
 #ifdef HAVE_NOAA
 #include "Weather/NOAAStore.hpp"
 #endif
 
+bool
+MapWindow::BackgroundState::operator==(const BackgroundState &other) const
+{
+  return terrain == other.terrain &&
+    terrain_serial == other.terrain_serial &&
+    terrain_settings == other.terrain_settings &&
+    /* the TerrainRenderer ignores small changes, too */
+    shading_angle.CompareRoughly(other.shading_angle) &&
+    weather_map == other.weather_map &&
+    weather_serial == other.weather_serial &&
+    weather_parameter == other.weather_parameter &&
+    topography == other.topography &&
+    topography_serial == other.topography_serial &&
+    topography_enabled == other.topography_enabled;
+}
+
+MapWindow::BackgroundState
+MapWindow::GetBackgroundState() const
+{
+  BackgroundState state;
+
+  state.terrain = terrain;
+  if (terrain != NULL)
+    state.terrain_serial = terrain->GetSerial();
+
+  state.terrain_settings = GetMapSettings().terrain;
+  state.shading_angle = background.GetShadingAngle();
+
+  state.weather_map = NULL;
+  state.weather_parameter = 0;
+  if (weather != NULL) {
+    state.weather_map = weather->GetMap();
+    if (state.weather_map != NULL)
+      state.weather_serial = state.weather_map->GetSerial();
+    state.weather_parameter = weather->GetParameter();
+  }
+
+  state.topography = topography;
+  if (topography != NULL)
+    state.topography_serial = topography->GetSerial();
+  state.topography_enabled = GetMapSettings().topography_enabled;
+
+  return state;
+}
+
 void
-MapWindow::RenderTerrain(Canvas &canvas)
+MapWindow::RenderBackground(Canvas &canvas)
 {
   background.SetShadingAngle(render_projection, GetMapSettings().terrain,
                              Calculated());
+
+  if (IsAncientHardware()) {
+    /* not enough memory for another screen buffer */
+    draw_sw.Mark("RenderTerrain");
+    RenderTerrain(canvas);
+
+    draw_sw.Mark("RenderTopography");
+    RenderTopography(canvas);
+    return;
+  }
+
+  const BackgroundState state = GetBackgroundState();
+  if (background_cache.IsValid(render_projection) &&
+      state == background_state) {
+    draw_sw.Mark("CopyBackground");
+    background_cache.CopyTo(canvas);
+    return;
+  }
+
+  Canvas &buffer = background_cache.Begin(canvas, render_projection);
+
+  draw_sw.Mark("RenderTerrain");
+  RenderTerrain(buffer);
+
+  draw_sw.Mark("RenderTopography");
+  RenderTopography(buffer);
+
+  background_cache.Commit(canvas);
+  background_state = state;
+}
+
+void
+MapWindow::RenderTerrain(Canvas &canvas)
+{
   background.Draw(canvas, render_projection, GetMapSettings().terrain);
 }
 
@@ -125,11 +209,7 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
   label_block.reset();
 
   // Render terrain, groundline and topography
-  draw_sw.Mark("RenderTerrain");
-  RenderTerrain(canvas);
-
-  draw_sw.Mark("RenderTopography");
-  RenderTopography(canvas);
+  RenderBackground(canvas);
 
   draw_sw.Mark("RenderFinalGlideShading");
   RenderFinalGlideShading(canvas);
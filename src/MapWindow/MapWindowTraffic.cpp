@@ -32,6 +32,7 @@ Copyright_License {
 #include "Renderer/TextInBox.hpp"
 #include "Renderer/TrafficRenderer.hpp"
 #include "FLARM/FriendsGlue.hpp"
+#include "FLARM/TrafficPredictor.hpp"
 #include "Look/Fonts.hpp"
 #include "Tracking/SkyLines/Data.hpp"
 
@@ -64,6 +65,20 @@ MapWindow::DrawFLARMTraffic(Canvas &canvas,
 
   canvas.Select(Fonts::map);
 
+  // Find the target which will pass closest, before FLARM warns
+  const MoreData &basic = Basic();
+  TrafficPredictor predictor;
+  predictor.Update(flarm,
+                   basic.track_available ? basic.track : Angle::Zero(),
+                   basic.ground_speed_available ? basic.ground_speed : fixed(0),
+                   basic.brutto_vario);
+  predictor.UpdateClosestApproach(fixed(TrafficPredictor::CONFLICT_TIME));
+  const int conflict =
+    predictor.FindMostCritical(fixed(TrafficPredictor::CONFLICT_DISTANCE));
+  const FlarmTraffic *conflict_traffic = conflict >= 0
+    ? flarm.FindTraffic(predictor.GetId(conflict))
+    : NULL;
+
   // Circle through the FLARM targets
   for (auto it = flarm.list.begin(), end = flarm.list.end();
       it != end; ++it) {
@@ -119,6 +134,12 @@ MapWindow::DrawFLARMTraffic(Canvas &canvas,
     TrafficRenderer::Draw(canvas, traffic_look, traffic,
                           traffic.track - projection.GetScreenAngle(),
                           color, sc);
+
+    if (&traffic == conflict_traffic && !traffic.HasAlarm()) {
+      canvas.SelectHollowBrush();
+      canvas.Select(traffic_look.conflict_pen);
+      canvas.DrawCircle(sc.x, sc.y, Layout::FastScale(14));
+    }
   }
 }
 
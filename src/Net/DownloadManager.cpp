@@ -104,7 +104,13 @@ Net::DownloadManager::Cancel(const TCHAR *relative_path)
 
 #include "ToFile.hpp"
 #include "Session.hpp"
-#include "Thread/StandbyThread.hpp"
+#include "Thread/Thread.hpp"
+#include "Thread/Mutex.hpp"
+#ifdef HAVE_POSIX
+#include "Thread/Cond.hpp"
+#else
+#include "Thread/Trigger.hpp"
+#endif
 #include "Util/tstring.hpp"
 #include "Operation/Operation.hpp"
 #include "LocalPath.hpp"
@@ -116,20 +122,47 @@ Net::DownloadManager::Cancel(const TCHAR *relative_path)
 #include <string.h>
 #include <windef.h> /* for MAX_PATH */
 
-class DownloadManagerThread gcc_final
-  : protected StandbyThread, private QuietOperationEnvironment {
+class DownloadWorker;
+
+/**
+ * The download queue, shared by several #DownloadWorker threads.
+ * Each worker picks the oldest download which is not being handled
+ * yet, so a large file does not block the ones queued after it.
+ */
+class DownloadQueue {
+  friend class DownloadWorker;
+
+  /**
+   * The maximum number of concurrent transfers.
+   */
+  static constexpr unsigned NUM_WORKERS = 3;
+
   struct Item {
     std::string uri;
     tstring path_relative;
 
-    Item(const Item &other) = delete;
+    /**
+     * Information about the download if it is running; -1 if
+     * unknown or if the download has not been started yet.
+     */
+    int64_t size, position;
+
+    /**
+     * Is a worker currently downloading this item?
+     */
+    bool running;
 
-    Item(Item &&other)
-      :uri(std::move(other.uri)),
-       path_relative(std::move(other.path_relative)) {}
+    /**
+     * Was this download cancelled while it was running?  The worker
+     * removes it from the queue when it notices.
+     */
+    bool cancelled;
+
+    Item(const Item &other) = delete;
 
     Item(const char *_uri, const TCHAR *_path_relative)
-      :uri(_uri), path_relative(_path_relative) {}
+      :uri(_uri), path_relative(_path_relative),
+       size(-1), position(-1), running(false), cancelled(false) {}
 
     Item &operator=(const Item &other) = delete;
 
@@ -140,27 +173,36 @@ class DownloadManagerThread gcc_final
   };
 
   /**
-   * Information about the current download, i.e. queue.front().
-   * Protected by StandbyThread::mutex.
+   * Protects all attributes of this object and of its workers.
    */
-  int64_t current_size, current_position;
+  Mutex mutex;
+
+  /**
+   * Signalled when a new item was added, or when a worker shall
+   * stop.
+   */
+#ifdef HAVE_POSIX
+  Cond cond;
+#else
+  Trigger trigger;
+#endif
+
+  bool stop;
 
   std::list<Item> queue;
 
   std::list<Net::DownloadListener *> listeners;
 
-public:
-  DownloadManagerThread()
-    :current_size(-1), current_position(-1) {}
+  DownloadWorker *workers[NUM_WORKERS];
 
-  void StopAsync() {
-    ScopeLock protect(mutex);
-    StandbyThread::StopAsync();
-  }
+public:
+  DownloadQueue();
+  ~DownloadQueue();
 
-  void WaitStopped() {
+  void BeginStop() {
     ScopeLock protect(mutex);
-    StandbyThread::WaitStopped();
+    stop = true;
+    WakeUp();
   }
 
   void AddListener(Net::DownloadListener &listener) {
@@ -183,143 +225,266 @@ public:
   void Enumerate(Net::DownloadListener &listener) {
     ScopeLock protect(mutex);
 
-    for (auto i = queue.begin(), end = queue.end(); i != end; ++i) {
-      const Item &item = *i;
-
-      int64_t size = -1, position = -1;
-      if (i == queue.begin()) {
-        size = current_size;
-        position = current_position;
-      }
-
-      listener.OnDownloadAdded(item.path_relative.c_str(), size, position);
-    }
+    for (const auto &item : queue)
+      if (!item.cancelled)
+        listener.OnDownloadAdded(item.path_relative.c_str(),
+                                 item.size, item.position);
   }
 
   void Enqueue(const char *uri, const TCHAR *path_relative) {
     ScopeLock protect(mutex);
-    queue.push_back(Item(uri, path_relative));
+    queue.emplace_back(uri, path_relative);
 
     for (auto i = listeners.begin(), end = listeners.end(); i != end; ++i)
       (*i)->OnDownloadAdded(path_relative, -1, -1);
 
-    if (!IsBusy())
-      Trigger();
+    WakeUp();
   }
 
   void Cancel(const TCHAR *relative_path) {
     ScopeLock protect(mutex);
 
-    auto i = std::find(queue.begin(), queue.end(), relative_path);
+    auto i = std::find_if(queue.begin(), queue.end(),
+                          [relative_path](const Item &item) {
+                            return !item.cancelled && item == relative_path;
+                          });
     if (i == queue.end())
       return;
 
-    if (i == queue.begin()) {
-      /* current download; stop the thread to cancel the current file
-         and restart the thread to continue downloading the following
-         files */
-
-      StandbyThread::StopAsync();
-      StandbyThread::WaitStopped();
-
-      if (!queue.empty())
-        Trigger();
-    } else {
+    if (i->running)
+      /* current download; the worker will notice this flag, abort
+         the transfer and remove the item */
+      i->cancelled = true;
+    else
       /* queued download; simply remove it from the list */
       queue.erase(i);
-    }
 
     for (auto i = listeners.begin(), end = listeners.end(); i != end; ++i)
       (*i)->OnDownloadComplete(relative_path, false);
   }
 
+private:
+  /**
+   * Wake up all idle workers.
+   *
+   * Caller must lock the mutex.
+   */
+  void WakeUp() {
+#ifdef HAVE_POSIX
+    cond.Broadcast();
+#else
+    trigger.Signal();
+#endif
+  }
+
+  /**
+   * Wait for WakeUp().
+   *
+   * Caller must lock the mutex.
+   */
+  void Wait() {
+#ifdef HAVE_POSIX
+    cond.Wait(mutex);
+#else
+    trigger.Reset();
+    mutex.Unlock();
+    trigger.Wait();
+    mutex.Lock();
+#endif
+  }
+
+  /**
+   * Find the oldest item which is not being downloaded yet, skipping
+   * items whose file is being written by another worker.
+   *
+   * Caller must lock the mutex.
+   */
+  gcc_pure
+  Item *FindNext();
+};
+
+/**
+ * A thread which takes items from the #DownloadQueue and downloads
+ * them, one at a time.
+ */
+class DownloadWorker gcc_final
+  : public Thread, private QuietOperationEnvironment {
+  DownloadQueue &queue;
+
+  /**
+   * The item being downloaded by this worker.  Protected by
+   * DownloadQueue::mutex.
+   */
+  DownloadQueue::Item *current;
+
+public:
+  DownloadWorker(DownloadQueue &_queue)
+    :queue(_queue), current(NULL) {}
+
 protected:
-  /* methods from class StandbyThread */
-  virtual void Tick();
+  /* virtual methods from class Thread */
+  virtual void Run() gcc_override;
 
 private:
-  /* methods from class OperationEnvironment */
-  virtual bool IsCancelled() const {
-    ScopeLock protect(const_cast<Mutex &>(mutex));
-    return StandbyThread::IsStopped();
+  bool Download(Net::Session &session, const DownloadQueue::Item &item);
+
+  /* virtual methods from class OperationEnvironment */
+  virtual bool IsCancelled() const gcc_override {
+    ScopeLock protect(queue.mutex);
+    return queue.stop || (current != NULL && current->cancelled);
   }
 
   virtual void SetProgressRange(unsigned range) gcc_override {
-    ScopeLock protect(mutex);
-    current_size = range;
+    ScopeLock protect(queue.mutex);
+    if (current != NULL)
+      current->size = range;
   }
 
   virtual void SetProgressPosition(unsigned position) gcc_override {
-    ScopeLock protect(mutex);
-    current_position = position;
+    ScopeLock protect(queue.mutex);
+    if (current != NULL)
+      current->position = position;
   }
 };
 
-void
-DownloadManagerThread::Tick()
+DownloadQueue::DownloadQueue()
+  :stop(false)
 {
-  Net::Session session;
+  for (unsigned i = 0; i < NUM_WORKERS; ++i) {
+    workers[i] = new DownloadWorker(*this);
+    workers[i]->Start();
+  }
+}
 
-  while (!queue.empty() && !StandbyThread::IsStopped()) {
-    assert(current_size == -1);
-    assert(current_position == -1);
+DownloadQueue::~DownloadQueue()
+{
+  BeginStop();
 
-    const Item &item = queue.front();
-    current_position = 0;
-    mutex.Unlock();
+  for (unsigned i = 0; i < NUM_WORKERS; ++i) {
+    workers[i]->Join();
+    delete workers[i];
+  }
+}
 
-    TCHAR path[MAX_PATH];
-    LocalPath(path, item.path_relative.c_str());
+DownloadQueue::Item *
+DownloadQueue::FindNext()
+{
+  for (auto &item : queue) {
+    if (item.running)
+      continue;
+
+    const bool busy =
+      std::any_of(queue.begin(), queue.end(),
+                  [&item](const Item &other) {
+                    return other.running &&
+                      other.path_relative == item.path_relative;
+                  });
+    if (!busy)
+      return &item;
+  }
+
+  return NULL;
+}
 
-    TCHAR tmp[MAX_PATH];
-    _tcscpy(tmp, path);
-    _tcscat(tmp, _T(".tmp"));
+bool
+DownloadWorker::Download(Net::Session &session,
+                         const DownloadQueue::Item &item)
+{
+  TCHAR path[MAX_PATH];
+  LocalPath(path, item.path_relative.c_str());
+
+  TCHAR tmp[MAX_PATH];
+  _tcscpy(tmp, path);
+  _tcscat(tmp, _T(".tmp"));
+  File::Delete(tmp);
+
+  if (!DownloadToFile(session, item.uri.c_str(), tmp, NULL, *this))
+    /* DownloadToFile() has deleted the file already */
+    return false;
+
+  if (IsCancelled() || !File::Replace(tmp, path)) {
     File::Delete(tmp);
-    bool success =
-      DownloadToFile(session, item.uri.c_str(), tmp, NULL, *this) &&
-      File::Replace(tmp, path);
+    return false;
+  }
 
-    mutex.Lock();
-    current_size = current_position = -1;
-    const Item copy(std::move(queue.front()));
-    queue.pop_front();
-    for (auto i = listeners.begin(), end = listeners.end(); i != end; ++i)
-      (*i)->OnDownloadComplete(copy.path_relative.c_str(), success);
+  return true;
+}
+
+void
+DownloadWorker::Run()
+{
+  Net::Session session;
+
+  ScopeLock protect(queue.mutex);
+
+  while (!queue.stop) {
+    DownloadQueue::Item *item = queue.FindNext();
+    if (item == NULL) {
+      queue.Wait();
+      continue;
+    }
+
+    item->running = true;
+    item->position = 0;
+    current = item;
+
+    /* the item's "uri" and "path_relative" attributes are not
+       modified while it is running, so they may be read without the
+       lock */
+    queue.mutex.Unlock();
+    const bool success = Download(session, *item);
+    queue.mutex.Lock();
+
+    current = NULL;
+
+    const bool cancelled = item->cancelled;
+    const tstring path_relative(std::move(item->path_relative));
+    queue.queue.remove_if([item](const DownloadQueue::Item &i) {
+        return &i == item;
+      });
+
+    /* Cancel() has already notified the listeners */
+    if (!cancelled)
+      for (auto i = queue.listeners.begin(), end = queue.listeners.end();
+           i != end; ++i)
+        (*i)->OnDownloadComplete(path_relative.c_str(), success);
+
+    /* another item for the same file may be waiting for this one */
+    queue.WakeUp();
   }
 }
 
-static DownloadManagerThread *thread;
+static DownloadQueue *download_queue;
 
 bool
 Net::DownloadManager::Initialise()
 {
-  assert(thread == NULL);
+  assert(download_queue == NULL);
 
-  thread = new DownloadManagerThread();
+  download_queue = new DownloadQueue();
   return true;
 }
 
 void
 Net::DownloadManager::BeginDeinitialise()
 {
-  assert(thread != NULL);
+  assert(download_queue != NULL);
 
-  thread->StopAsync();
+  download_queue->BeginStop();
 }
 
 void
 Net::DownloadManager::Deinitialise()
 {
-  assert(thread != NULL);
+  assert(download_queue != NULL);
 
-  thread->WaitStopped();
-  delete thread;
+  delete download_queue;
 }
 
 bool
 Net::DownloadManager::IsAvailable()
 {
-  assert(thread != NULL);
+  assert(download_queue != NULL);
 
   return true;
 }
@@ -327,41 +492,41 @@ Net::DownloadManager::IsAvailable()
 void
 Net::DownloadManager::AddListener(DownloadListener &listener)
 {
-  assert(thread != NULL);
+  assert(download_queue != NULL);
 
-  thread->AddListener(listener);
+  download_queue->AddListener(listener);
 }
 
 void
 Net::DownloadManager::RemoveListener(DownloadListener &listener)
 {
-  assert(thread != NULL);
+  assert(download_queue != NULL);
 
-  thread->RemoveListener(listener);
+  download_queue->RemoveListener(listener);
 }
 
 void
 Net::DownloadManager::Enumerate(DownloadListener &listener)
 {
-  assert(thread != NULL);
+  assert(download_queue != NULL);
 
-  thread->Enumerate(listener);
+  download_queue->Enumerate(listener);
 }
 
 void
 Net::DownloadManager::Enqueue(const char *uri, const TCHAR *relative_path)
 {
-  assert(thread != NULL);
+  assert(download_queue != NULL);
 
-  thread->Enqueue(uri, relative_path);
+  download_queue->Enqueue(uri, relative_path);
 }
 
 void
 Net::DownloadManager::Cancel(const TCHAR *relative_path)
 {
-  assert(thread != NULL);
+  assert(download_queue != NULL);
 
-  thread->Cancel(relative_path);
+  download_queue->Cancel(relative_path);
 }
 
 #endif
@@ -71,6 +71,33 @@ Projection::GeoToScreen(const GeoPoint &g) const
   return sc;
 }
 
+void
+Projection::GeoToScreen(const GeoPoint *gcc_restrict src,
+                        RasterPoint *gcc_restrict dest, unsigned n) const
+{
+  /* copy the attributes to local variables; this allows the
+     compiler to keep them in registers, instead of reloading them
+     after each store to "dest" */
+  const GeoPoint location = geo_location;
+  const RasterPoint origin = screen_origin;
+  const FastIntegerRotation rotation = screen_rotation;
+  const fixed _draw_scale = draw_scale;
+
+  for (const GeoPoint *end = src + n; src != end; ++src, ++dest) {
+    const GeoPoint d = location - *src;
+
+    const fixed x = fast_mult(d.longitude.Radians(), _draw_scale, 12);
+    const fixed y = fast_mult(d.latitude.Radians(), _draw_scale, 12);
+
+    const FastIntegerRotation::Pair p =
+      rotation.Rotate((int)fast_mult(src->latitude.fastcosine(), x, 16),
+                      (int)y);
+
+    dest->x = origin.x - p.first;
+    dest->y = origin.y + p.second;
+  }
+}
+
 void 
 Projection::SetScale(const fixed _scale)
 {
@@ -144,6 +144,20 @@ public:
   gcc_pure
   RasterPoint GeoToScreen(const GeoPoint &g) const;
 
+  /**
+   * Converts an array of GeoPoints to screen coordinates.  The
+   * results are the same as with the single-point version, but this
+   * one avoids the per-point call overhead and is a lot faster for
+   * large arrays.
+   *
+   * @param src the GeoPoints to convert
+   * @param dest the destination array (must not overlap with the
+   * source)
+   * @param n the number of points
+   */
+  void GeoToScreen(const GeoPoint *gcc_restrict src,
+                   RasterPoint *gcc_restrict dest, unsigned n) const;
+
   /**
    * Returns the origin/rotation center in screen coordinates
    * @return The origin/rotation center in screen coordinates
@@ -0,0 +1,106 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_PROJECTION_SHAPE_PROJECTION_HPP
+#define XCSOAR_PROJECTION_SHAPE_PROJECTION_HPP
+
+#include "Projection/Projection.hpp"
+#include "Topography/XShapePoint.hpp"
+#include "Geo/Math.hpp"
+#include "Screen/OpenGL/System.hpp"
+#include "Compiler.h"
+
+/**
+ * Convert a GeoPoint into a ShapePoint, i.e. the distance from the
+ * given origin in metres.  This is the coordinate system used by
+ * XShape and by the other OpenGL vertex caches.
+ */
+gcc_pure
+static inline ShapePoint
+GeoToShape(const GeoPoint &origin, const GeoPoint &point)
+{
+  const GeoPoint d = point - origin;
+
+  ShapePoint pt;
+  pt.x = (ShapeScalar)fast_mult(point.latitude.fastcosine(),
+                                AngleToEarthDistance(d.longitude), 16);
+  pt.y = (ShapeScalar)-AngleToEarthDistance(d.latitude);
+  return pt;
+}
+
+/**
+ * Multiply the current OpenGL matrix with the transformation from
+ * ShapePoints (relative to the projection's geographic location) to
+ * screen coordinates.
+ */
+static inline void
+ApplyShapeProjection(const Projection &projection)
+{
+  const fixed angle = projection.GetScreenAngle().Degrees();
+  const fixed scale = projection.GetScale();
+  const RasterPoint &screen_origin = projection.GetScreenOrigin();
+
+#ifdef HAVE_GLES
+#ifdef FIXED_MATH
+  GLfixed fixed_angle = angle.as_glfixed();
+  GLfixed fixed_scale = scale.as_glfixed_scale();
+#else
+  GLfixed fixed_angle = angle * (1<<16);
+  GLfixed fixed_scale = scale * (1LL<<32);
+#endif
+  glTranslatex((int)screen_origin.x << 16, (int)screen_origin.y << 16, 0);
+  glRotatex(fixed_angle, 0, 0, -(1<<16));
+  glScalex(fixed_scale, fixed_scale, 1<<16);
+#else
+  glTranslatef(screen_origin.x, screen_origin.y, 0.);
+  glRotatef((GLfloat)angle, 0., 0., -1.);
+  glScalef((GLfloat)scale, (GLfloat)scale, 1.);
+#endif
+}
+
+/**
+ * Move the origin of the current OpenGL matrix by the given
+ * ShapePoint offset.
+ */
+static inline void
+ApplyShapeTranslation(ShapePoint translation)
+{
+#ifdef HAVE_GLES
+  glTranslatex(translation.x, translation.y, 0);
+#else
+  glTranslatef(translation.x, translation.y, 0.);
+#endif
+}
+
+/**
+ * Combination of ApplyShapeProjection() and ApplyShapeTranslation():
+ * sets up the matrix for ShapePoints relative to the given origin.
+ */
+static inline void
+ApplyShapeProjection(const Projection &projection, const GeoPoint &origin)
+{
+  ApplyShapeProjection(projection);
+  ApplyShapeTranslation(GeoToShape(projection.GetGeoLocation(), origin));
+}
+
+#endif
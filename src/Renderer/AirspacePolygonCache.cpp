@@ -0,0 +1,113 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifdef ENABLE_OPENGL
+
+#include "AirspacePolygonCache.hpp"
+#include "Airspace/Airspaces.hpp"
+#include "Airspace/AirspacePolygon.hpp"
+#include "Projection/WindowProjection.hpp"
+#include "Projection/ShapeProjection.hpp"
+#include "Screen/OpenGL/Triangulate.hpp"
+#include "Screen/Color.hpp"
+#include "Geo/Math.hpp"
+
+#include <assert.h>
+
+AirspacePolygonCache::Item::Item(const AirspacePolygon &airspace)
+  :center(airspace.GetGeoBounds().GetCenter())
+{
+  const SearchPointVector &src = airspace.GetPoints();
+  unsigned num_points = src.size();
+
+  /* the triangulation doesn't want the closing point */
+  if (num_points > 1 &&
+      src[num_points - 1].GetLocation() == src[0].GetLocation())
+    --num_points;
+
+  if (num_points < 3 || num_points > 0xffff)
+    return;
+
+  points.reserve(num_points);
+  for (unsigned i = 0; i < num_points; ++i)
+    points.push_back(GeoToShape(center, src[i].GetLocation()));
+
+  strip.resize(3 * (num_points - 2));
+  unsigned count = PolygonToTriangles(points.data(), num_points,
+                                      strip.data());
+  if (count > 0)
+    count = TriangleToStrip(strip.data(), count, num_points);
+
+  strip.resize(count);
+}
+
+void
+AirspacePolygonCache::Prepare(const Airspaces &_airspaces,
+                              const WindowProjection &_projection)
+{
+  if (&_airspaces != airspaces || _airspaces.GetSerial() != serial) {
+    items.clear();
+    airspaces = &_airspaces;
+    serial = _airspaces.GetSerial();
+  }
+
+  projection = &_projection;
+}
+
+const AirspacePolygonCache::Item &
+AirspacePolygonCache::Get(const AirspacePolygon &airspace)
+{
+  auto i = items.find(&airspace);
+  if (i == items.end())
+    i = items.insert(std::make_pair(&airspace, Item(airspace))).first;
+
+  return i->second;
+}
+
+bool
+AirspacePolygonCache::DrawFill(const AirspacePolygon &airspace,
+                               const Color color)
+{
+  assert(projection != NULL);
+
+  const Item &item = Get(airspace);
+  if (item.strip.empty())
+    return false;
+
+  glPushMatrix();
+  ApplyShapeProjection(*projection, item.center);
+#ifdef HAVE_GLES
+  glVertexPointer(2, GL_FIXED, 0, &item.points[0].x);
+#else
+  glVertexPointer(2, GL_INT, 0, &item.points[0].x);
+#endif
+
+  color.Set();
+  glDrawElements(GL_TRIANGLE_STRIP, item.strip.size(), GL_UNSIGNED_SHORT,
+                 item.strip.data());
+
+  glPopMatrix();
+  return true;
+}
+
+#endif
@@ -0,0 +1,104 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_AIRSPACE_POLYGON_CACHE_HPP
+#define XCSOAR_AIRSPACE_POLYGON_CACHE_HPP
+
+#ifdef ENABLE_OPENGL
+
+#include "Topography/XShapePoint.hpp"
+#include "Screen/OpenGL/System.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Util/Serial.hpp"
+#include "Util/NonCopyable.hpp"
+#include "Compiler.h"
+
+#include <map>
+#include <vector>
+
+class Airspaces;
+class AbstractAirspace;
+class AirspacePolygon;
+class WindowProjection;
+class Color;
+
+/**
+ * Caches the triangulated interior of #AirspacePolygon objects, so
+ * they don't need to be clipped, projected and triangulated again on
+ * every frame.
+ *
+ * The points of each polygon are stored in metres relative to its
+ * centre, and drawn with an OpenGL transformation matrix, just like
+ * #XShape does for the topography.
+ */
+class AirspacePolygonCache : private NonCopyable {
+  struct Item {
+    GeoPoint center;
+
+    std::vector<ShapePoint> points;
+
+    /**
+     * Indices of a triangle strip covering the polygon.  Empty if the
+     * polygon could not be triangulated.
+     */
+    std::vector<GLushort> strip;
+
+    explicit Item(const AirspacePolygon &airspace);
+  };
+
+  const Airspaces *airspaces;
+  Serial serial;
+
+  std::map<const AbstractAirspace *, Item> items;
+
+  /**
+   * The projection which was passed to Prepare().
+   */
+  const WindowProjection *projection;
+
+public:
+  AirspacePolygonCache():airspaces(NULL), projection(NULL) {}
+
+  /**
+   * Prepare drawing a frame.  Discards the cache if the airspace
+   * database has been modified.
+   */
+  void Prepare(const Airspaces &airspaces,
+               const WindowProjection &projection);
+
+  /**
+   * Fill the interior of the polygon with the specified color,
+   * honouring the current stencil and blend settings.
+   *
+   * @return false if the polygon could not be drawn from the cache;
+   * the caller must fall back to Canvas::DrawPolygon()
+   */
+  bool DrawFill(const AirspacePolygon &airspace, const Color color);
+
+private:
+  const Item &Get(const AirspacePolygon &airspace);
+};
+
+#endif
+
+#endif
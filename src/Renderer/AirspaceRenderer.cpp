@@ -137,15 +137,18 @@ class AirspaceVisitorRenderer gcc_final
   const AirspaceLook &look;
   const AirspaceWarningCopy &warning_manager;
   const AirspaceRendererSettings &settings;
+  AirspacePolygonCache &polygon_cache;
 
 public:
   AirspaceVisitorRenderer(Canvas &_canvas, const WindowProjection &_projection,
                           const AirspaceLook &_look,
                           const AirspaceWarningCopy &_warnings,
-                          const AirspaceRendererSettings &_settings)
+                          const AirspaceRendererSettings &_settings,
+                          AirspacePolygonCache &_polygon_cache)
     :MapCanvas(_canvas, _projection,
                _projection.GetScreenBounds().Scale(fixed(1.1))),
-     look(_look), warning_manager(_warnings), settings(_settings)
+     look(_look), warning_manager(_warnings), settings(_settings),
+     polygon_cache(_polygon_cache)
   {
     glStencilMask(0xff);
     glClear(GL_STENCIL_BUFFER_BIT);
@@ -213,7 +216,8 @@ private:
       {
         SetupInterior(airspace, !fill_airspace);
         GLEnable blend(GL_BLEND);
-        DrawPrepared();
+        if (!polygon_cache.DrawFill(airspace, GetInteriorColor(airspace)))
+          DrawPrepared();
       }
 
       if (!fill_airspace) {
@@ -274,11 +278,15 @@ private:
     glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
     glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 
-    Color color = settings.classes[airspace.GetType()].fill_color;
-    canvas.Select(Brush(color.WithAlpha(90)));
+    canvas.Select(Brush(GetInteriorColor(airspace)));
     canvas.SelectNullPen();
   }
 
+  gcc_pure
+  Color GetInteriorColor(const AbstractAirspace &airspace) const {
+    return settings.classes[airspace.GetType()].fill_color.WithAlpha(90);
+  }
+
   void SetFillStencil() {
     glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
     glStencilFunc(GL_ALWAYS, 3, 3);
@@ -306,15 +314,18 @@ class AirspaceFillRenderer gcc_final
   const AirspaceLook &look;
   const AirspaceWarningCopy &warning_manager;
   const AirspaceRendererSettings &settings;
+  AirspacePolygonCache &polygon_cache;
 
 public:
   AirspaceFillRenderer(Canvas &_canvas, const WindowProjection &_projection,
                        const AirspaceLook &_look,
                        const AirspaceWarningCopy &_warnings,
-                       const AirspaceRendererSettings &_settings)
+                       const AirspaceRendererSettings &_settings,
+                       AirspacePolygonCache &_polygon_cache)
     :MapCanvas(_canvas, _projection,
                _projection.GetScreenBounds().Scale(fixed(1.1))),
-     look(_look), warning_manager(_warnings), settings(_settings)
+     look(_look), warning_manager(_warnings), settings(_settings),
+     polygon_cache(_polygon_cache)
   {
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
   }
@@ -344,7 +355,8 @@ private:
       {
         SetupInterior(airspace);
         GLEnable blend(GL_BLEND);
-        DrawPrepared();
+        if (!polygon_cache.DrawFill(airspace, GetInteriorColor(airspace)))
+          DrawPrepared();
       }
     }
 
@@ -384,10 +396,14 @@ private:
   }
 
   void SetupInterior(const AbstractAirspace &airspace) {
-    Color color = settings.classes[airspace.GetType()].fill_color;
-    canvas.Select(Brush(color.WithAlpha(48)));
+    canvas.Select(Brush(GetInteriorColor(airspace)));
     canvas.SelectNullPen();
   }
+
+  gcc_pure
+  Color GetInteriorColor(const AbstractAirspace &airspace) const {
+    return settings.classes[airspace.GetType()].fill_color.WithAlpha(48);
+  }
 };
 
 #else // !ENABLE_OPENGL
@@ -603,15 +619,17 @@ AirspaceRenderer::Draw(Canvas &canvas,
     return;
 
 #ifdef ENABLE_OPENGL
+  polygon_cache.Prepare(*airspaces, projection);
+
   if (settings.fill_mode == AirspaceRendererSettings::FillMode::ALL) {
     AirspaceFillRenderer renderer(canvas, projection, look, awc,
-                                  settings);
+                                  settings, polygon_cache);
     airspaces->VisitWithinRange(projection.GetGeoScreenCenter(),
                                           projection.GetScreenDistanceMeters(),
                                           renderer, visible);
   } else {
     AirspaceVisitorRenderer renderer(canvas, projection, look, awc,
-                                     settings);
+                                     settings, polygon_cache);
     airspaces->VisitWithinRange(projection.GetGeoScreenCenter(),
                                           projection.GetScreenDistanceMeters(),
                                           renderer, visible);
@@ -27,6 +27,10 @@ Copyright_License {
 #include "Util/StaticArray.hpp"
 #include "Geo/GeoPoint.hpp"
 
+#ifdef ENABLE_OPENGL
+#include "AirspacePolygonCache.hpp"
+#endif
+
 struct AirspaceLook;
 struct MoreData;
 struct DerivedInfo;
@@ -48,6 +52,10 @@ class AirspaceRenderer
 
   StaticArray<GeoPoint,32> intersections;
 
+#ifdef ENABLE_OPENGL
+  AirspacePolygonCache polygon_cache;
+#endif
+
 public:
   AirspaceRenderer(const AirspaceLook &_look)
     :look(_look), airspaces(NULL), warning_manager(NULL) {}
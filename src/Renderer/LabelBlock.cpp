@@ -23,12 +23,31 @@ Copyright_License {
 
 #include "LabelBlock.hpp"
 
-void
-LabelBlock::Bucket::Clear()
+#include <algorithm>
+
+/**
+ * Convert a pixel coordinate to a cell index, clipped to the grid.
+ */
+gcc_const
+static unsigned
+ToCell(int value, unsigned shift, unsigned n)
 {
-  blocks.clear();
+  if (value < 0)
+    return 0;
+
+  unsigned i = unsigned(value) >> shift;
+  return i < n ? i : n - 1;
 }
 
+LabelBlock::CellRange::CellRange(const PixelRect rc)
+  :left(ToCell(rc.left, CELL_SHIFT_X, GRID_WIDTH)),
+   top(ToCell(rc.top, CELL_SHIFT_Y, GRID_HEIGHT)),
+   /* "right" and "bottom" are exclusive */
+   right(ToCell(std::max(rc.right - 1, (int)rc.left),
+                CELL_SHIFT_X, GRID_WIDTH)),
+   bottom(ToCell(std::max(rc.bottom - 1, (int)rc.top),
+                 CELL_SHIFT_Y, GRID_HEIGHT)) {}
+
 static gcc_pure bool
 CheckRectOverlap(const PixelRect& rc1, const PixelRect& rc2)
 {
@@ -37,38 +56,54 @@ CheckRectOverlap(const PixelRect& rc1, const PixelRect& rc2)
 }
 
 bool
-LabelBlock::Bucket::Check(const PixelRect rc) const
+LabelBlock::Check(const CellRange &range, const PixelRect rc) const
 {
-  for (auto i = blocks.begin(), end = blocks.end(); i != end; ++i)
-    if (CheckRectOverlap(*i, rc))
-      return false;
+  for (unsigned y = range.top; y <= range.bottom; ++y)
+    for (unsigned x = range.left; x <= range.right; ++x)
+      for (unsigned i = cells[y][x]; i != NONE; i = references[i].next)
+        if (CheckRectOverlap(blocks[references[i].block], rc))
+          return false;
 
   return true;
 }
 
-void LabelBlock::reset()
+void
+LabelBlock::Add(const CellRange &range, const PixelRect rc)
 {
-  for (unsigned i = 0; i < BUCKET_COUNT; ++i)
-    buckets[i].Clear();
+  if (blocks.full() ||
+      references.size() + range.GetCount() > references.capacity())
+    /* no more room; the label gets drawn, but won't block others */
+    return;
+
+  const uint16_t block = blocks.size();
+  blocks.append(rc);
+
+  for (unsigned y = range.top; y <= range.bottom; ++y) {
+    for (unsigned x = range.left; x <= range.right; ++x) {
+      Reference &reference = references.append();
+      reference.block = block;
+      reference.next = cells[y][x];
+      cells[y][x] = references.size() - 1;
+    }
+  }
 }
 
-bool LabelBlock::check(const PixelRect rc)
+void
+LabelBlock::reset()
 {
-  unsigned top = rc.top >> BUCKET_SHIFT;
-  unsigned bottom = rc.bottom >> BUCKET_SHIFT;
-
-  if (top >= BUCKET_COUNT)
-    top = BUCKET_COUNT - 1;
-
-  if (bottom < BUCKET_COUNT && !buckets[bottom].Check(rc))
-    return false;
+  blocks.clear();
+  references.clear();
+  std::fill(&cells[0][0], &cells[0][0] + GRID_HEIGHT * GRID_WIDTH,
+            uint16_t(NONE));
+}
 
-  if (top < bottom && !buckets[top].Check(rc))
+bool
+LabelBlock::check(const PixelRect rc)
+{
+  const CellRange range(rc);
+  if (!Check(range, rc))
     return false;
 
-  buckets[top].Add(rc);
-  if (bottom < BUCKET_COUNT && top != bottom)
-    buckets[bottom].Add(rc);
-
+  Add(range, rc);
   return true;
 }
@@ -28,52 +28,104 @@ Copyright_License {
 #include "Util/StaticArray.hpp"
 #include "Compiler.h"
 
+#include <stdint.h>
+
 /**
  * Simple code to prevent text writing over map city names.
+ *
+ * The rectangles are registered in a uniform grid of cells; each cell
+ * has a linked list of the rectangles overlapping it.  A check only
+ * needs to look at the few rectangles in the cells it touches, which
+ * is O(1) on average, even in dense areas.
  */
 class LabelBlock {
 #if defined(_WIN32_WCE) && _WIN32_WCE < 0x400
   /* PPC2000 (ancient hardware, expect small screens) */
-  static constexpr unsigned SCREEN_HEIGHT = 1024;
-  static constexpr unsigned BUCKET_SIZE = 32;
+  static constexpr unsigned SCREEN_SIZE = 1024;
+  static constexpr unsigned MAX_BLOCKS = 256;
 #elif defined(_WIN32_WCE) || defined(HAVE_GLES)
   /* embedded (Android or Windows CE) */
-  static constexpr unsigned SCREEN_HEIGHT = 2048;
-  static constexpr unsigned BUCKET_SIZE = 64;
+  static constexpr unsigned SCREEN_SIZE = 2048;
+  static constexpr unsigned MAX_BLOCKS = 1024;
 #else
   /* desktop, screen may be huge, lots of memory */
-  static constexpr unsigned SCREEN_HEIGHT = 4096;
-  static constexpr unsigned BUCKET_SIZE = 64;
+  static constexpr unsigned SCREEN_SIZE = 4096;
+  static constexpr unsigned MAX_BLOCKS = 2048;
 #endif
-  static constexpr unsigned BUCKET_SHIFT = 7;
-  static constexpr unsigned BUCKET_HEIGHT = 1 << BUCKET_SHIFT;
-  static constexpr unsigned BUCKET_COUNT = SCREEN_HEIGHT / BUCKET_HEIGHT;
 
   /**
-   * A bucket is responsible for hit tests in one horizontal section
-   * of the screen.
+   * The cells are wide and flat, because labels are.
    */
-  class Bucket {
-    typedef StaticArray<PixelRect, BUCKET_SIZE> BlockArray;
-    BlockArray blocks;
+  static constexpr unsigned CELL_SHIFT_X = 7;
+  static constexpr unsigned CELL_SHIFT_Y = 5;
+  static constexpr unsigned GRID_WIDTH = SCREEN_SIZE >> CELL_SHIFT_X;
+  static constexpr unsigned GRID_HEIGHT = SCREEN_SIZE >> CELL_SHIFT_Y;
+
+  static constexpr unsigned MAX_REFERENCES = MAX_BLOCKS * 4;
 
-  public:
-    void Clear();
+  /**
+   * Marks the end of a cell's list.
+   */
+  static constexpr uint16_t NONE = 0xffff;
 
-    gcc_pure
-    bool Check(const PixelRect rc) const;
+  static_assert(MAX_REFERENCES < NONE, "Too many references");
 
-    void Add(const PixelRect rc) {
-      if (!blocks.full())
-        blocks.append(rc);
-    }
+  /**
+   * An item in the linked list of a cell.
+   */
+  struct Reference {
+    /**
+     * Index into #blocks.
+     */
+    uint16_t block;
+
+    /**
+     * Index of the next #Reference in the same cell, or #NONE.
+     */
+    uint16_t next;
   };
 
-  Bucket buckets[BUCKET_COUNT];
+  StaticArray<PixelRect, MAX_BLOCKS> blocks;
+  StaticArray<Reference, MAX_REFERENCES> references;
+
+  /**
+   * The index of the first #Reference of each cell, or #NONE.
+   */
+  uint16_t cells[GRID_HEIGHT][GRID_WIDTH];
+
+  /**
+   * A range of cells (inclusive) covered by a rectangle.
+   */
+  struct CellRange {
+    unsigned left, top, right, bottom;
+
+    CellRange(const PixelRect rc);
+
+    unsigned GetCount() const {
+      return (right - left + 1) * (bottom - top + 1);
+    }
+  };
 
 public:
+  LabelBlock() {
+    reset();
+  }
+
+  /**
+   * Checks whether the rectangle overlaps with any rectangle that
+   * was added before.  If not, it is added.
+   *
+   * @return true if there is no overlap (i.e. the label may be drawn)
+   */
   bool check(const PixelRect rc);
+
   void reset();
+
+private:
+  gcc_pure
+  bool Check(const CellRange &range, const PixelRect rc) const;
+
+  void Add(const CellRange &range, const PixelRect rc);
 };
 
 #endif
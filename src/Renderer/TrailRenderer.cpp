@@ -30,9 +30,16 @@ Copyright_License {
 #include "Computer/TraceComputer.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "Geo/Math.hpp"
+#ifdef ENABLE_OPENGL
+#include "Projection/ShapeProjection.hpp"
+#endif
 #include "Engine/Contest/ContestTrace.hpp"
 #include "Util/Clamp.hpp"
 
+#ifdef ENABLE_OPENGL
+#include "Engine/Trace/Trace.hpp"
+#endif
+
 #include <algorithm>
 
 using std::min;
@@ -89,25 +96,49 @@ GetAltitudeColorIndex(fixed alt, fixed min_alt, fixed max_alt)
   return Clamp((int)(relative_altitude * _max), 0, _max);
 }
 
+gcc_const
+static unsigned
+GetColorIndex(bool altitude, fixed value, fixed min_value, fixed max_value)
+{
+  return altitude
+    ? GetAltitudeColorIndex(value, min_value, max_value)
+    : GetSnailColorIndex(value, min_value, max_value);
+}
+
+gcc_pure
+static fixed
+GetValue(bool altitude, const TracePoint &point)
+{
+  return altitude ? point.GetAltitude() : point.GetVario();
+}
+
+/**
+ * Determine the value range for the trail colours.
+ *
+ * @param get_value a function returning the altitude or the vario
+ * value of an element
+ */
+template<typename I, typename F>
 static std::pair<fixed, fixed>
-GetMinMax(TrailSettings::Type type, const TracePointVector &trace)
+GetMinMax(bool altitude, I begin, I end, F get_value)
 {
   fixed value_min, value_max;
 
-  if (type == TrailSettings::Type::ALTITUDE) {
+  if (altitude) {
     value_max = fixed(1000);
     value_min = fixed(500);
-    for (auto it = trace.begin(); it != trace.end(); ++it) {
-      value_max = max(it->GetAltitude(), value_max);
-      value_min = min(it->GetAltitude(), value_min);
-    }
   } else {
     value_max = fixed(0.75);
     value_min = fixed(-2.0);
-    for (auto it = trace.begin(); it != trace.end(); ++it) {
-      value_max = max(it->GetVario(), value_max);
-      value_min = min(it->GetVario(), value_min);
-    }
+  }
+
+  for (I it = begin; it != end; ++it) {
+    const fixed value = get_value(*it);
+    value_max = max(value, value_max);
+    value_min = min(value, value_min);
+  }
+
+  if (!altitude) {
     value_max = min(fixed(7.5), value_max);
     value_min = max(fixed(-5.0), value_min);
   }
@@ -115,6 +146,154 @@ GetMinMax(TrailSettings::Type type, const TracePointVector &trace)
   return std::make_pair(value_min, value_max);
 }
 
+static std::pair<fixed, fixed>
+GetMinMax(TrailSettings::Type type, const TracePointVector &trace)
+{
+  const bool altitude = type == TrailSettings::Type::ALTITUDE;
+  return GetMinMax(altitude, trace.begin(), trace.end(),
+                   [altitude](const TracePoint &point) {
+                     return GetValue(altitude, point);
+                   });
+}
+
+#ifdef ENABLE_OPENGL
+
+void
+TrailRenderer::UpdateVertexCache(const Trace &trace, bool altitude,
+                                 const WindowProjection &projection,
+                                 unsigned min_time)
+{
+  VertexCache &c = vertex_cache;
+
+  /* the vertices are relative to the origin, and the projection is
+     linearised there; rebase them when the screen has moved too far
+     away to keep the error small */
+  const GeoPoint &location = projection.GetGeoLocation();
+
+  Trace::const_iterator i = trace.begin();
+  if (!c.valid || c.modify_serial != trace.GetModifySerial() ||
+      c.altitude != altitude || trace.size() < c.points.size() ||
+      trace.size() > 0xffff ||
+      location.Distance(c.origin) > projection.GetScreenDistanceMeters()) {
+    c.valid = true;
+    c.modify_serial = trace.GetModifySerial();
+    c.altitude = altitude;
+    c.origin = location;
+    c.points.clear();
+    c.times.clear();
+    c.values.clear();
+    c.num_classified = 0;
+    for (unsigned j = 0; j < TrailLook::NUMSNAILCOLORS; ++j)
+      c.segments[j].clear();
+  } else if (c.append_serial == trace.GetAppendSerial()) {
+    i = trace.end();
+  } else {
+    /* no thinning since the last update: the new fixes have been
+       appended at the end */
+    i = std::prev(trace.end(), trace.size() - c.points.size());
+  }
+
+  c.append_serial = trace.GetAppendSerial();
+
+  const unsigned old_size = c.points.size();
+  for (auto end = trace.end(); i != end; ++i) {
+    c.points.push_back(GeoToShape(c.origin, i->GetLocation()));
+    c.times.push_back(i->GetTime());
+    c.values.push_back(GetValue(altitude, *i));
+    c.last_location = i->GetLocation();
+  }
+
+  const unsigned first =
+    std::lower_bound(c.times.begin(), c.times.end(), min_time) -
+    c.times.begin();
+  if (first != c.first || c.points.size() != old_size ||
+      c.num_classified == 0) {
+    c.first = first;
+
+    auto minmax = GetMinMax(altitude, c.values.begin() + first,
+                            c.values.end(),
+                            [](fixed value) { return value; });
+    if (minmax.first != c.value_min || minmax.second != c.value_max) {
+      /* the colour range has changed: classify all segments again */
+      c.value_min = minmax.first;
+      c.value_max = minmax.second;
+      c.num_classified = 0;
+      for (unsigned j = 0; j < TrailLook::NUMSNAILCOLORS; ++j)
+        c.segments[j].clear();
+    }
+  }
+
+  /* sort new segments by colour; like the scalar code, a segment gets
+     the colour of its end point */
+  for (unsigned j = std::max(c.num_classified, 1u), n = c.points.size();
+       j < n; ++j) {
+    const unsigned index = GetColorIndex(altitude, c.values[j],
+                                         c.value_min, c.value_max);
+    const VertexCache::Segment segment = { GLushort(j - 1), GLushort(j) };
+    c.segments[index].push_back(segment);
+  }
+
+  c.num_classified = c.points.size();
+}
+
+void
+TrailRenderer::DrawVertexCache(Canvas &canvas,
+                               const TraceComputer &trace_computer,
+                               const WindowProjection &projection,
+                               unsigned min_time, const RasterPoint pos,
+                               const TrailSettings &settings)
+{
+  const bool altitude = settings.type == TrailSettings::Type::ALTITUDE;
+
+  trace_computer.Lock();
+  UpdateVertexCache(trace_computer.GetFull(), altitude, projection, min_time);
+  trace_computer.Unlock();
+
+  const VertexCache &c = vertex_cache;
+  if (c.first >= c.points.size())
+    return;
+
+  const bool scaled_trail = !altitude && settings.scaling_enabled &&
+                            projection.GetMapScale() <= fixed(6000);
+  const Pen *pens = scaled_trail ? look.scaled_trail_pens : look.trail_pens;
+
+  glPushMatrix();
+  ApplyShapeProjection(projection, c.origin);
+#ifdef HAVE_GLES
+  glVertexPointer(2, GL_FIXED, 0, &c.points[0].x);
+#else
+  glVertexPointer(2, GL_INT, 0, &c.points[0].x);
+#endif
+
+  const unsigned first = c.first;
+  for (unsigned i = 0; i < TrailLook::NUMSNAILCOLORS; ++i) {
+    const auto &segments = c.segments[i];
+
+    /* skip the segments which are older than min_time */
+    auto begin = std::lower_bound(segments.begin(), segments.end(), first,
+                                  [](const VertexCache::Segment &segment,
+                                     unsigned index) {
+                                    return segment.a < index;
+                                  });
+    if (begin == segments.end())
+      continue;
+
+    pens[i].Bind();
+    glDrawElements(GL_LINES, 2 * (segments.end() - begin),
+                   GL_UNSIGNED_SHORT, &begin->a);
+    pens[i].Unbind();
+  }
+
+  glPopMatrix();
+
+  /* connect the most recent fix with the aircraft */
+  canvas.Select(pens[GetColorIndex(altitude, c.values.back(),
+                                   c.value_min, c.value_max)]);
+  canvas.DrawLine(projection.GeoToScreen(c.last_location), pos);
+}
+
+#endif
+
 void
 TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
                     const WindowProjection &projection, unsigned min_time,
@@ -125,12 +304,24 @@ TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
   if (settings.length == TrailSettings::Length::OFF)
     return;
 
-  if (!LoadTrace(trace_computer, min_time, projection))
-    return;
-
   if (!calculated.wind_available)
     enable_traildrift = false;
 
+#ifdef ENABLE_OPENGL
+  if (!enable_traildrift &&
+      settings.type != TrailSettings::Type::VARIO_1_DOTS &&
+      settings.type != TrailSettings::Type::VARIO_2_DOTS) {
+    /* the trail is static on the map; draw it from the vertex cache
+       instead of projecting it again */
+    DrawVertexCache(canvas, trace_computer, projection, min_time, pos,
+                    settings);
+    return;
+  }
+#endif
+
+  if (!LoadTrace(trace_computer, min_time, projection))
+    return;
+
   GeoPoint traildrift;
   if (enable_traildrift) {
     GeoPoint tp1 = FindLatitudeLongitude(basic.location,
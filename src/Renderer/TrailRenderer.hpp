@@ -28,12 +28,22 @@ Copyright_License {
 #include "Engine/Trace/Point.hpp"
 #include "Engine/Trace/Vector.hpp"
 
+#ifdef ENABLE_OPENGL
+#include "Look/TrailLook.hpp"
+#include "Topography/XShapePoint.hpp"
+#include "Screen/OpenGL/System.hpp"
+#include "Util/Serial.hpp"
+
+#include <vector>
+#endif
+
 struct RasterPoint;
 class Canvas;
 class TraceComputer;
 class Projection;
 class WindowProjection;
 class ContestTraceVector;
+class Trace;
 struct TrailLook;
 struct NMEAInfo;
 struct DerivedInfo;
@@ -45,6 +55,57 @@ class TrailRenderer {
   TracePointVector trace;
   AllocatedArray<RasterPoint> points;
 
+#ifdef ENABLE_OPENGL
+  /**
+   * A copy of the full trace in flat coordinates (metres relative to
+   * #origin), which is drawn with the OpenGL transformation matrix.
+   * New fixes are appended incrementally; it is rebuilt only after
+   * the #Trace has been thinned or cleared.
+   */
+  struct VertexCache {
+    struct Segment {
+      GLushort a, b;
+    };
+
+    Serial append_serial, modify_serial;
+
+    bool valid;
+
+    /**
+     * Are the #values altitudes (or vario values)?
+     */
+    bool altitude;
+
+    GeoPoint origin, last_location;
+
+    std::vector<ShapePoint> points;
+    std::vector<unsigned> times;
+    std::vector<fixed> values;
+
+    /**
+     * The index of the first point not older than "min_time", and the
+     * range of #values from there on, which determines the colours.
+     */
+    unsigned first;
+    fixed value_min, value_max;
+
+    /**
+     * The number of points whose preceding segment has been sorted
+     * into #segments.
+     */
+    unsigned num_classified;
+
+    /**
+     * The line segments for each trail colour, ordered by time.
+     */
+    std::vector<Segment> segments[TrailLook::NUMSNAILCOLORS];
+
+    VertexCache()
+      :valid(false), first(0),
+       value_min(fixed(0)), value_max(fixed(0)), num_classified(0) {}
+  } vertex_cache;
+#endif
+
 public:
   TrailRenderer(const TrailLook &_look):look(_look) {}
 
@@ -84,6 +145,19 @@ public:
 private:
   void DrawTraceVector(Canvas &canvas, const Projection &projection,
                        const TracePointVector &trace);
+
+#ifdef ENABLE_OPENGL
+  void UpdateVertexCache(const Trace &trace, bool altitude,
+                         const WindowProjection &projection,
+                         unsigned min_time);
+
+  /**
+   * Draw the (undrifted, non-dotted) trail from the #VertexCache.
+   */
+  void DrawVertexCache(Canvas &canvas, const TraceComputer &trace_computer,
+                       const WindowProjection &projection, unsigned min_time,
+                       const RasterPoint pos, const TrailSettings &settings);
+#endif
 };
 
 #endif
@@ -41,6 +41,7 @@ typedef struct FT_FaceRec_ *FT_Face;
 #endif
 
 #include <tchar.h>
+#include <stdint.h>
 
 class TextUtil;
 
@@ -113,6 +114,52 @@ public:
   }
 
   void Render(const TCHAR *text, const PixelSize size, void *buffer) const;
+
+  /**
+   * A single rendered character, see RenderGlyphBitmap().
+   */
+  struct Glyph {
+    /**
+     * The horizontal bearing of the glyph, which extends the string's
+     * bounding box to the left if negative.
+     */
+    int left;
+
+    /**
+     * The vertical position of the bitmap's first row relative to
+     * the top of the text line.
+     */
+    int top;
+
+    /**
+     * The distance to the pen position of the next character.
+     */
+    int advance;
+
+    /**
+     * The bitmap size; may be empty, e.g. for a space.
+     */
+    unsigned width, height;
+
+    /**
+     * The distance between two rows in the buffer.
+     */
+    int pitch;
+
+    /**
+     * The 8 bit coverage values of the bitmap.  This points into the
+     * font's glyph slot, and is only valid until the next call.
+     */
+    const uint8_t *buffer;
+  };
+
+  /**
+   * Render one character into the font's glyph slot, with the same
+   * metrics as used by Render().
+   *
+   * @return false if the font has no glyph for this character
+   */
+  bool RenderGlyphBitmap(TCHAR ch, Glyph &glyph) const;
 #elif defined(ANDROID)
   int TextTextureGL(const TCHAR *text, PixelSize &size) const;
 #elif defined(USE_GDI)
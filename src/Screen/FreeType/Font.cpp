@@ -288,3 +288,37 @@ Font::Render(const TCHAR *text, const PixelSize size, void *_buffer) const
     x += glyph_advance;
   }
 }
+
+bool
+Font::RenderGlyphBitmap(TCHAR ch, Glyph &glyph) const
+{
+  const FT_Face face = this->face;
+
+  FT_UInt i = FT_Get_Char_Index(face, ch);
+  if (i == 0)
+    return false;
+
+  FT_Error error = FT_Load_Glyph(face, i, FT_LOAD_DEFAULT);
+  if (error)
+    return false;
+
+  const FT_GlyphSlot slot = face->glyph;
+  const FT_Glyph_Metrics &metrics = slot->metrics;
+
+  glyph.left = FT_FLOOR(metrics.horiBearingX);
+  glyph.top = ascent_height - FT_FLOOR(metrics.horiBearingY);
+  glyph.advance = FT_CEIL(metrics.horiAdvance);
+
+  error = FT_Render_Glyph(slot, FT_RENDER_MODE_NORMAL);
+  if (error) {
+    glyph.width = glyph.height = 0;
+    return true;
+  }
+
+  const FT_Bitmap &bitmap = slot->bitmap;
+  glyph.width = bitmap.width;
+  glyph.height = bitmap.rows;
+  glyph.pitch = bitmap.pitch;
+  glyph.buffer = (const uint8_t *)bitmap.buffer;
+  return true;
+}
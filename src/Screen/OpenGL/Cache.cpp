@@ -113,6 +113,26 @@ struct TextCacheKey {
   };
 };
 
+#ifdef USE_FREETYPE
+
+/**
+ * One glyph atlas per font.  The pointers are used as keys; the
+ * atlases are discarded by TextCache::Flush(), which must be called
+ * whenever fonts are reloaded.
+ */
+static std::unordered_map<const Font *, GlyphAtlas *> atlases;
+
+static GlyphAtlas &
+GetAtlas(const Font &font)
+{
+  GlyphAtlas *&atlas = atlases[&font];
+  if (atlas == nullptr)
+    atlas = new GlyphAtlas(font);
+  return *atlas;
+}
+
+#else
+
 struct RenderedText : public ListHead {
   GLTexture *texture;
 
@@ -122,14 +142,7 @@ struct RenderedText : public ListHead {
     other.texture = NULL;
   }
 
-#ifdef USE_FREETYPE
-  RenderedText(unsigned width, unsigned height, const uint8_t *buffer) {
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    texture = new GLTexture(GL_LUMINANCE, width, height,
-                            GL_LUMINANCE, GL_UNSIGNED_BYTE,
-                            buffer);
-  }
-#elif defined(ANDROID)
+#ifdef ANDROID
   RenderedText(int id, unsigned width, unsigned height)
     :texture(new GLTexture(id, width, height)) {}
 #else
@@ -149,9 +162,12 @@ struct RenderedText : public ListHead {
   }
 };
 
-static Cache<TextCacheKey, PixelSize, 1024u, TextCacheKey::Hash> size_cache;
 static Cache<TextCacheKey, RenderedText, 256u, TextCacheKey::Hash> text_cache;
 
+#endif
+
+static Cache<TextCacheKey, PixelSize, 1024u, TextCacheKey::Hash> size_cache;
+
 PixelSize
 TextCache::GetSize(const Font &font, const char *text)
 {
@@ -176,14 +192,23 @@ TextCache::LookupSize(const Font &font, const char *text)
     return size;
 
   TextCacheKey key(font, text);
+
+#ifdef USE_FREETYPE
+  const PixelSize *cached = size_cache.Get(key);
+  if (cached == NULL)
+    return size;
+
+  return *cached;
+#else
   const RenderedText *cached = text_cache.Get(key);
   if (cached == NULL)
     return size;
 
   return cached->texture->GetSize();
+#endif
 }
 
-GLTexture *
+TextCache::Texture *
 TextCache::Get(const Font *font, const char *text)
 {
   assert(pthread_equal(pthread_self(), OpenGL::thread));
@@ -193,6 +218,15 @@ TextCache::Get(const Font *font, const char *text)
   if (*text == 0)
     return NULL;
 
+#ifdef USE_FREETYPE
+  const PixelSize size = GetSize(*font, text);
+  if (size.cx == 0 || size.cy == 0)
+    return nullptr;
+
+  static GlyphRun run;
+  run = GlyphRun(GetAtlas(*font), text, size);
+  return &run;
+#else
   TextCacheKey key(*font, text);
 
   /* look it up */
@@ -203,20 +237,7 @@ TextCache::Get(const Font *font, const char *text)
 
   /* render the text into a OpenGL texture */
 
-#ifdef USE_FREETYPE
-  PixelSize size = font->TextSize(text);
-  size_t buffer_size = font->BufferSize(size);
-  if (buffer_size == 0)
-    return nullptr;
-
-  uint8_t *buffer = new uint8_t[buffer_size];
-  if (buffer == nullptr)
-    return nullptr;
-
-  font->Render(text, size, buffer);
-  RenderedText rt(size.cx, size.cy, buffer);
-  delete[] buffer;
-#elif defined(ANDROID)
+#ifdef ANDROID
   PixelSize size;
   int texture_id = font->TextTextureGL(text, size);
   if (texture_id == 0)
@@ -245,6 +266,7 @@ TextCache::Get(const Font *font, const char *text)
   /* done */
 
   return texture;
+#endif
 }
 
 void
@@ -253,5 +275,12 @@ TextCache::Flush()
   assert(pthread_equal(pthread_self(), OpenGL::thread));
 
   size_cache.Clear();
+
+#ifdef USE_FREETYPE
+  for (const auto &i : atlases)
+    delete i.second;
+  atlases.clear();
+#else
   text_cache.Clear();
+#endif
 }
@@ -26,19 +26,37 @@ Copyright_License {
 
 #include "Compiler.h"
 
+#ifdef USE_FREETYPE
+#include "GlyphAtlas.hpp"
+#endif
+
 struct PixelSize;
 class GLTexture;
 class Font;
 
 namespace TextCache {
+#ifdef USE_FREETYPE
+  /**
+   * With FreeType, strings are drawn from a per-font glyph atlas
+   * instead of being rendered into a texture each.
+   */
+  typedef GlyphRun Texture;
+#else
+  typedef GLTexture Texture;
+#endif
+
   gcc_pure
   PixelSize GetSize(const Font &font, const char *text);
 
   gcc_pure
   PixelSize LookupSize(const Font &font, const char *text);
 
+  /**
+   * Returns an object which draws the specified text.  It is valid
+   * until the next call.
+   */
   gcc_pure
-  GLTexture *Get(const Font *font, const char *text);
+  Texture *Get(const Font *font, const char *text);
 
   void Flush();
 };
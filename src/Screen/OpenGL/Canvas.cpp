@@ -533,7 +533,7 @@ Canvas::DrawText(PixelScalar x, PixelScalar y, const TCHAR *text)
   if (font == NULL)
     return;
 
-  GLTexture *texture = TextCache::Get(font, text);
+  TextCache::Texture *texture = TextCache::Get(font, text);
   if (texture == NULL)
     return;
 
@@ -575,7 +575,7 @@ Canvas::DrawTransparentText(PixelScalar x, PixelScalar y, const TCHAR *text)
   if (font == NULL)
     return;
 
-  GLTexture *texture = TextCache::Get(font, text);
+  TextCache::Texture *texture = TextCache::Get(font, text);
   if (texture == NULL)
     return;
 
@@ -611,7 +611,7 @@ Canvas::DrawClippedText(PixelScalar x, PixelScalar y,
   if (font == NULL)
     return;
 
-  GLTexture *texture = TextCache::Get(font, text);
+  TextCache::Texture *texture = TextCache::Get(font, text);
   if (texture == NULL)
     return;
 
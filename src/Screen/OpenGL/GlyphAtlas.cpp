@@ -0,0 +1,251 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "GlyphAtlas.hpp"
+#include "Texture.hpp"
+#include "Debug.hpp"
+#include "Screen/Font.hpp"
+#include "Util/AllocatedArray.hpp"
+
+#include <algorithm>
+
+GlyphAtlas::GlyphAtlas(const Font &_font)
+  :font(_font), texture(nullptr),
+   row_x(0), row_y(0), row_height(0)
+{
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+  delete texture;
+}
+
+void
+GlyphAtlas::Bind()
+{
+  assert(pthread_equal(pthread_self(), OpenGL::thread));
+
+  if (texture == nullptr) {
+    /* start with a blank texture, so there are no leftovers in the
+       gaps between the glyphs */
+    uint8_t *buffer = new uint8_t[SIZE * SIZE];
+    std::fill(buffer, buffer + SIZE * SIZE, 0);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    texture = new GLTexture(GL_LUMINANCE, SIZE, SIZE,
+                            GL_LUMINANCE, GL_UNSIGNED_BYTE, buffer);
+    delete[] buffer;
+  }
+
+  texture->Bind();
+}
+
+void
+GlyphAtlas::Clear()
+{
+  glyphs.clear();
+  row_x = row_y = row_height = 0;
+
+  /* the next Bind() call creates a blank texture */
+  delete texture;
+  texture = nullptr;
+  Bind();
+}
+
+bool
+GlyphAtlas::Add(TCHAR ch)
+{
+  Glyph &glyph = glyphs[ch];
+
+  Font::Glyph rendered;
+  if (!font.RenderGlyphBitmap(ch, rendered)) {
+    /* remember that the font doesn't have this character */
+    glyph.x = glyph.y = glyph.width = glyph.height = 0;
+    glyph.left = glyph.top = glyph.advance = 0;
+    return true;
+  }
+
+  glyph.width = rendered.width;
+  glyph.height = rendered.height;
+  glyph.left = rendered.left;
+  glyph.top = rendered.top;
+  glyph.advance = rendered.advance;
+
+  if (rendered.width == 0 || rendered.height == 0) {
+    glyph.x = glyph.y = 0;
+    return true;
+  }
+
+  /* keep a one pixel gap between glyphs, so texture filtering does
+     not pick up the neighbour */
+
+  if (row_x + rendered.width > SIZE) {
+    row_x = 0;
+    row_y += row_height + 1;
+    row_height = 0;
+  }
+
+  if (rendered.width > SIZE || row_y + rendered.height > SIZE) {
+    glyphs.erase(ch);
+    return false;
+  }
+
+  glyph.x = row_x;
+  glyph.y = row_y;
+
+  row_x += rendered.width + 1;
+  row_height = std::max(row_height, rendered.height);
+
+  const uint8_t *src = rendered.buffer;
+  static AllocatedArray<uint8_t> buffer;
+  if (rendered.pitch != int(rendered.width)) {
+    /* OpenGL/ES has no GL_UNPACK_ROW_LENGTH; copy the rows into a
+       tightly packed buffer */
+    buffer.GrowDiscard(rendered.width * rendered.height);
+    uint8_t *dest = buffer.begin();
+    for (unsigned i = 0; i < rendered.height;
+         ++i, src += rendered.pitch, dest += rendered.width)
+      std::copy(src, src + rendered.width, dest);
+    src = buffer.begin();
+  }
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, glyph.x, glyph.y,
+                  rendered.width, rendered.height,
+                  GL_LUMINANCE, GL_UNSIGNED_BYTE, src);
+  return true;
+}
+
+bool
+GlyphAtlas::Load(const TCHAR *text)
+{
+  for (const TCHAR *p = text; *p != 0; ++p)
+    if (Find(*p) == nullptr && !Add(*p))
+      return false;
+
+  return true;
+}
+
+void
+GlyphAtlas::Draw(const TCHAR *text, PixelScalar x, PixelScalar y,
+                 UPixelScalar width, UPixelScalar height)
+{
+  assert(texture != nullptr);
+
+  if (!Load(text)) {
+    /* the texture is full: start over; if this still fails, the
+       string is drawn without the glyphs which did not fit */
+    Clear();
+    Load(text);
+  }
+
+  /* like Font::Render(), shift the string to the right if the first
+     glyph extends to the left of the pen position */
+  int pen = 0, min_x = 0;
+  unsigned n = 0;
+  for (const TCHAR *p = text; *p != 0; ++p) {
+    const Glyph *glyph = Find(*p);
+    if (glyph == nullptr)
+      continue;
+
+    min_x = std::min(min_x, pen + glyph->left);
+    pen += glyph->advance;
+    if (glyph->width > 0)
+      ++n;
+  }
+
+  if (n == 0)
+    return;
+
+  static AllocatedArray<RasterPoint> vertices;
+  static AllocatedArray<GLfloat> coords;
+  vertices.GrowDiscard(n * 6);
+  coords.GrowDiscard(n * 12);
+
+  RasterPoint *v = vertices.begin();
+  GLfloat *c = coords.begin();
+
+  const int right = x + int(width), bottom = y + int(height);
+  const GLfloat scale = 1. / SIZE;
+
+  pen = -min_x;
+  for (const TCHAR *p = text; *p != 0; ++p) {
+    const Glyph *glyph = Find(*p);
+    if (glyph == nullptr)
+      continue;
+
+    int x0 = x + pen, y0 = y + glyph->top;
+    pen += glyph->advance;
+
+    if (glyph->width == 0)
+      continue;
+
+    int x1 = x0 + glyph->width, y1 = y0 + glyph->height;
+    int src_x = glyph->x, src_y = glyph->y;
+
+    /* clip to the string's box */
+    if (x0 < x) {
+      src_x += x - x0;
+      x0 = x;
+    }
+
+    if (y0 < y) {
+      src_y += y - y0;
+      y0 = y;
+    }
+
+    x1 = std::min(x1, right);
+    y1 = std::min(y1, bottom);
+    if (x0 >= x1 || y0 >= y1)
+      continue;
+
+    const GLfloat u0 = src_x * scale, v0 = src_y * scale;
+    const GLfloat u1 = (src_x + x1 - x0) * scale;
+    const GLfloat v1 = (src_y + y1 - y0) * scale;
+
+    /* two triangles per glyph */
+    *v++ = RasterPoint(x0, y0);
+    *v++ = RasterPoint(x1, y0);
+    *v++ = RasterPoint(x0, y1);
+    *v++ = RasterPoint(x1, y0);
+    *v++ = RasterPoint(x0, y1);
+    *v++ = RasterPoint(x1, y1);
+
+    const GLfloat quad[] = {
+      u0, v0, u1, v0, u0, v1,
+      u1, v0, u0, v1, u1, v1,
+    };
+    c = std::copy(quad, quad + 12, c);
+  }
+
+  const unsigned n_vertices = v - vertices.begin();
+  if (n_vertices == 0)
+    return;
+
+  glVertexPointer(2, GL_VALUE, 0, vertices.begin());
+
+  glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+  glTexCoordPointer(2, GL_FLOAT, 0, coords.begin());
+  glDrawArrays(GL_TRIANGLES, 0, n_vertices);
+  glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+}
@@ -0,0 +1,175 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SCREEN_OPENGL_GLYPH_ATLAS_HPP
+#define XCSOAR_SCREEN_OPENGL_GLYPH_ATLAS_HPP
+
+#include "Screen/Point.hpp"
+#include "Util/NonCopyable.hpp"
+#include "Compiler.h"
+
+#include <unordered_map>
+
+#include <tchar.h>
+#include <assert.h>
+
+class Font;
+class GLTexture;
+
+/**
+ * A texture which contains the glyphs of one #Font, packed in rows.
+ * Text is drawn as one quad per glyph from this texture, therefore
+ * drawing a string does not need a texture upload once all of its
+ * characters have been seen.
+ *
+ * When the texture is full, all glyphs are discarded and the atlas
+ * is refilled on demand.
+ */
+class GlyphAtlas : private NonCopyable {
+  static constexpr unsigned SIZE = 512;
+
+  struct Glyph {
+    /**
+     * The position of the bitmap in the texture.
+     */
+    unsigned short x, y;
+
+    unsigned short width, height;
+
+    short left, top, advance;
+  };
+
+  const Font &font;
+
+  /**
+   * The texture; created on demand.
+   */
+  GLTexture *texture;
+
+  /**
+   * The position of the next glyph in the current row.
+   */
+  unsigned row_x, row_y;
+
+  /**
+   * The height of the tallest glyph in the current row.
+   */
+  unsigned row_height;
+
+  std::unordered_map<TCHAR, Glyph> glyphs;
+
+public:
+  explicit GlyphAtlas(const Font &_font);
+  ~GlyphAtlas();
+
+  void Bind();
+
+  /**
+   * Draw the specified string, clipped to the specified size.  The
+   * texture must be bound, and the caller is responsible for setting
+   * up the texture environment.
+   */
+  void Draw(const TCHAR *text, PixelScalar x, PixelScalar y,
+            UPixelScalar width, UPixelScalar height);
+
+private:
+  /**
+   * Discard all glyphs.
+   */
+  void Clear();
+
+  /**
+   * Make sure all characters of the string are in the texture.
+   *
+   * @return false if the texture is full
+   */
+  bool Load(const TCHAR *text);
+
+  /**
+   * @return false if the texture is full
+   */
+  bool Add(TCHAR ch);
+
+  gcc_pure
+  const Glyph *Find(TCHAR ch) const {
+    auto i = glyphs.find(ch);
+    return i != glyphs.end()
+      ? &i->second
+      : nullptr;
+  }
+};
+
+/**
+ * A string which is drawn from a #GlyphAtlas.  It provides the
+ * subset of the #GLTexture methods used by #Canvas to draw text.
+ */
+class GlyphRun {
+  GlyphAtlas *atlas;
+  const TCHAR *text;
+  PixelSize size;
+
+public:
+  GlyphRun() = default;
+
+  GlyphRun(GlyphAtlas &_atlas, const TCHAR *_text, PixelSize _size)
+    :atlas(&_atlas), text(_text), size(_size) {}
+
+  UPixelScalar GetWidth() const {
+    return size.cx;
+  }
+
+  UPixelScalar GetHeight() const {
+    return size.cy;
+  }
+
+  gcc_pure
+  PixelSize GetSize() const {
+    return size;
+  }
+
+  void Bind() {
+    atlas->Bind();
+  }
+
+  void Draw(PixelScalar dest_x, PixelScalar dest_y) const {
+    atlas->Draw(text, dest_x, dest_y, size.cx, size.cy);
+  }
+
+  /**
+   * Draw the upper left part of the string.  The source position
+   * must be 0/0 and the source size must be equal to the destination
+   * size; these parameters exist only for compatibility with
+   * #GLTexture.
+   */
+  void Draw(PixelScalar dest_x, PixelScalar dest_y,
+            UPixelScalar dest_width, UPixelScalar dest_height,
+            PixelScalar src_x, PixelScalar src_y,
+            UPixelScalar src_width, UPixelScalar src_height) const {
+    assert(src_x == 0 && src_y == 0);
+    assert(src_width == dest_width && src_height == dest_height);
+
+    atlas->Draw(text, dest_x, dest_y, dest_width, dest_height);
+  }
+};
+
+#endif
@@ -26,6 +26,7 @@ Copyright_License {
 
 #include <string.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <algorithm>
 
 //#define DEBUG_TILE
@@ -33,6 +34,78 @@ Copyright_License {
 #include <stdio.h>
 #endif
 
+/**
+ * The height of the glide line as a function of the number of steps
+ * walked along the line.
+ */
+struct GlideLine {
+  short h_origin;
+  int slope_fact;
+
+  /**
+   * Does the line descend from the origin?  Otherwise, the height
+   * difference is added.
+   */
+  bool descending;
+
+  /**
+   * The line never rises above this height.
+   */
+  short h_limit;
+
+  gcc_pure
+  short AtStep(int steps) const {
+    const short dh = (short)((steps*slope_fact)>>RASTER_SLOPE_FACT);
+    const short h = descending ? h_origin - dh : h_origin + dh;
+    return std::min(h, h_limit);
+  }
+};
+
+/**
+ * Consult the min/max pyramid of the tile containing the current
+ * search position, and determine how many steps of the line search
+ * may pass without another terrain sample, because the whole block
+ * is safely below the glide line.
+ *
+ * @param min_steps the number of steps the caller would skip anyway
+ * @return the number of steps until the next sample is due, or 0 if
+ * the pyramid does not allow skipping more than #min_steps
+ */
+gcc_pure
+static unsigned
+GetClearSteps(const RasterTile &tile, unsigned x, unsigned y,
+              int sx, int sy,
+              const GlideLine &line, int total_steps,
+              short h_safety, short h_ceiling, unsigned min_steps)
+{
+  if (!tile.HasPyramid())
+    return 0;
+
+  /* try the largest blocks first */
+  for (int level = RasterTile::PYRAMID_LEVELS - 1; level >= 0; --level) {
+    const unsigned steps = tile.GetBlockSteps(level, x, y, sx, sy);
+    if (steps <= min_steps)
+      /* finer blocks are contained in this one and cannot gain
+         anything */
+      break;
+
+    const RasterTile::HeightRange &range = tile.GetBlockRange(level, x, y);
+    if (range.minimum < 0)
+      /* the search terminates at invalid terrain and water; these
+         must be sampled */
+      continue;
+
+    /* the line is monotonic, so its extremes are at both ends */
+    const short h_a = line.AtStep(total_steps);
+    const short h_b = line.AtStep(total_steps + steps - 1);
+    if (range.maximum + h_safety <= std::min(h_a, h_b) &&
+        std::max(h_a, h_b) <= h_ceiling)
+      return steps;
+  }
+
+  return 0;
+}
+
 bool
 RasterTileCache::FirstIntersection(int x0, int y0,
                                    int x1, int y1,
@@ -108,6 +181,12 @@ RasterTileCache::FirstIntersection(int x0, int y0,
   unsigned last_clear_y = y0;
   short last_clear_h = h_origin;
 
+  // while skipping a clear pyramid block: the last position visited
+  // inside the block
+  bool skipping = false;
+  unsigned skip_x = x0, skip_y = y0;
+  int skip_steps = 0;
+
   while (h_terrain>=0) {
 
     if (!step_counter) {
@@ -115,6 +194,18 @@ RasterTileCache::FirstIntersection(int x0, int y0,
       if ((_x >= width) || (_y >= height))
         break; // outside bounds
 
+      if (skipping) {
+        // the whole block was clear, up to the position before this
+        // one
+        skipping = false;
+        last_clear_x = skip_x;
+        last_clear_y = skip_y;
+        last_clear_h = (short)((skip_steps*slope_fact)>>RASTER_SLOPE_FACT)
+          + h_origin;
+        if (can_climb)
+          last_clear_h = std::min(last_clear_h, h_dest);
+      }
+
       h_terrain = GetFieldDirect(x_int, y_int, tile_index)+h_safety;
       step_counter = tile_index<0? step_coarse: step_fine;
 
@@ -183,6 +274,25 @@ RasterTileCache::FirstIntersection(int x0, int y0,
           last_clear_x = x_int;
           last_clear_y = y_int;
           last_clear_h = h_int;
+
+          const RasterTile &tile = tiles.Get(x_int / tile_width,
+                                             y_int / tile_height);
+          if (tile.IsEnabled()) {
+            const GlideLine line = {
+              h_origin, slope_fact, false,
+              can_climb ? h_dest : (short)SHRT_MAX,
+            };
+
+            const unsigned clear_steps =
+              GetClearSteps(tile, x_int, y_int,
+                            dx > 0 ? sx : 0, dy > 0 ? sy : 0,
+                            line, total_steps, h_safety, h_ceiling,
+                            step_counter);
+            if (clear_steps > 0) {
+              step_counter = clear_steps;
+              skipping = true;
+            }
+          }
         }
       }
     }
@@ -194,6 +304,12 @@ RasterTileCache::FirstIntersection(int x0, int y0,
       return false;
     }
 
+    if (skipping) {
+      skip_x = x_int;
+      skip_y = y_int;
+      skip_steps = total_steps;
+    }
+
     const int e2 = 2*err;
     if (e2 > -dy) {
       err -= dy;
@@ -313,6 +429,12 @@ RasterTileCache::Intersection(int x0, int y0,
   unsigned last_clear_y = _y;
   short last_clear_h = h_int;
 
+  // while skipping a clear pyramid block: the last position visited
+  // inside the block
+  bool skipping = false;
+  unsigned skip_x = _x, skip_y = _y;
+  int skip_steps = 0;
+
   while (h_terrain>=0) {
 
     if (!step_counter) {
@@ -320,6 +442,16 @@ RasterTileCache::Intersection(int x0, int y0,
       if ((_x >= width) || (_y >= height))
         break; // outside bounds
 
+      if (skipping) {
+        // the whole block was clear, up to the position before this
+        // one
+        skipping = false;
+        last_clear_x = skip_x;
+        last_clear_y = skip_y;
+        last_clear_h = h_origin -
+          (short)((skip_steps*slope_fact)>>RASTER_SLOPE_FACT);
+      }
+
       h_terrain = GetFieldDirect(_x, _y, tile_index);
       step_counter = tile_index<0? step_coarse: step_fine;
 
@@ -343,11 +475,34 @@ RasterTileCache::Intersection(int x0, int y0,
       last_clear_x = _x;
       last_clear_y = _y;
       last_clear_h = h_int;
+
+      const RasterTile &tile = tiles.Get(_x / tile_width, _y / tile_height);
+      if (tile.IsEnabled()) {
+        const GlideLine line = {
+          h_origin, slope_fact, true, (short)SHRT_MAX,
+        };
+
+        const unsigned clear_steps =
+          GetClearSteps(tile, _x, _y,
+                        dx > 0 ? sx : 0, dy > 0 ? sy : 0,
+                        line, total_steps, 0, (short)SHRT_MAX,
+                        step_counter);
+        if (clear_steps > 0) {
+          step_counter = clear_steps;
+          skipping = true;
+        }
+      }
     }
 
     if (total_steps > max_steps)
       break;
 
+    if (skipping) {
+      skip_x = _x;
+      skip_y = _y;
+      skip_steps = total_steps;
+    }
+
     const int e2 = 2*err;
     if (e2 > -dy) {
       err -= dy;
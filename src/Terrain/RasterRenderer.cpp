@@ -31,6 +31,14 @@ Copyright_License {
 #include "Asset.hpp"
 #include "Event/Idle.hpp"
 
+#ifdef ENABLE_PARALLEL_RASTER
+#include "Thread/StandbyThread.hpp"
+
+#ifdef HAVE_POSIX
+#include <unistd.h>
+#endif
+#endif
+
 #include <assert.h>
 #include <stdint.h>
 
@@ -62,6 +70,63 @@ TerrainShading(const short illum, uint8_t &r, uint8_t &g, uint8_t &b)
   }
 }
 
+#ifdef ENABLE_PARALLEL_RASTER
+
+/**
+ * A helper thread which generates one band of the terrain image.
+ */
+class RasterRenderer::BandThread : public StandbyThread {
+  const BandFunction *function;
+  unsigned y_begin, y_end;
+
+public:
+  /**
+   * Start generating the given band in background.
+   */
+  void Begin(const BandFunction &_function,
+             unsigned _y_begin, unsigned _y_end) {
+    ScopeLock protect(mutex);
+    function = &_function;
+    y_begin = _y_begin;
+    y_end = _y_end;
+    Trigger();
+  }
+
+  void Wait() {
+    LockWaitDone();
+  }
+
+  void LockStop() {
+    ScopeLock protect(mutex);
+    Stop();
+  }
+
+protected:
+  virtual void Tick() {
+    mutex.Unlock();
+    (*function)(y_begin, y_end);
+    mutex.Lock();
+  }
+};
+
+/**
+ * Determine the number of CPU cores which are online.
+ */
+static unsigned
+GetProcessorCount()
+{
+#ifdef HAVE_POSIX
+  const long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? (unsigned)n : 1;
+#else
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors > 0 ? info.dwNumberOfProcessors : 1;
+#endif
+}
+
+#endif
+
 RasterRenderer::RasterRenderer()
   :quantisation_pixels(2),
 #ifdef ENABLE_OPENGL
@@ -69,6 +134,9 @@ RasterRenderer::RasterRenderer()
    bounds(GeoBounds::Invalid()),
 #endif
    image(NULL)
+#ifdef ENABLE_PARALLEL_RASTER
+  , num_band_threads(0), band_threads_initialised(false)
+#endif
 {
   // scale quantisation_pixels so resolution is not too high on old hardware
   // with large displays
@@ -79,6 +147,13 @@ RasterRenderer::RasterRenderer()
 
 RasterRenderer::~RasterRenderer()
 {
+#ifdef ENABLE_PARALLEL_RASTER
+  for (unsigned i = 0; i < num_band_threads; ++i) {
+    band_threads[i]->LockStop();
+    delete band_threads[i];
+  }
+#endif
+
   delete image;
 }
 
@@ -179,14 +254,82 @@ RasterRenderer::GenerateImage(bool do_shading,
     GenerateUnshadedImage(height_scale);
 }
 
+#ifdef ENABLE_PARALLEL_RASTER
+
+void
+RasterRenderer::ForEachBand(const BandFunction &f)
+{
+  /* don't bother splitting small images; waking up the threads
+     would cost more than it saves */
+  static constexpr unsigned MIN_BAND_HEIGHT = 32;
+
+  if (!band_threads_initialised) {
+    band_threads_initialised = true;
+
+    num_band_threads = std::min(GetProcessorCount() - 1,
+                                unsigned(MAX_BAND_THREADS));
+    for (unsigned i = 0; i < num_band_threads; ++i)
+      band_threads[i] = new BandThread();
+  }
+
+  const unsigned height = height_matrix.GetHeight();
+  const unsigned num_bands =
+    std::max(1u, std::min(num_band_threads + 1, height / MIN_BAND_HEIGHT));
+  const unsigned band_height = (height + num_bands - 1) / num_bands;
+
+  /* the calling thread generates the first band; the other ones are
+     delegated to the helper threads */
+  for (unsigned i = 1; i < num_bands; ++i)
+    band_threads[i - 1]->Begin(f, i * band_height,
+                               std::min((i + 1) * band_height, height));
+
+  f(0, std::min(band_height, height));
+
+  for (unsigned i = 1; i < num_bands; ++i)
+    band_threads[i - 1]->Wait();
+}
+
+#endif
+
 void
 RasterRenderer::GenerateUnshadedImage(unsigned height_scale)
 {
-  const short *src = height_matrix.GetData();
+#ifdef ENABLE_PARALLEL_RASTER
+  ForEachBand([this, height_scale](unsigned y_begin, unsigned y_end){
+      GenerateUnshadedImage(height_scale, y_begin, y_end);
+    });
+#else
+  GenerateUnshadedImage(height_scale, 0, height_matrix.GetHeight());
+#endif
+
+  image->SetDirty();
+}
+
+/**
+ * Returns the given row of the image.
+ */
+static BGRColor *
+GetImageRow(RawBitmap &image, unsigned y)
+{
+  BGRColor *row = image.GetTopRow();
+  for (; y > 0; --y)
+    row = image.GetNextRow(row);
+  return row;
+}
+
+void
+RasterRenderer::GenerateUnshadedImage(unsigned height_scale,
+                                      unsigned y_begin, unsigned y_end)
+{
+  assert(y_begin <= y_end);
+  assert(y_end <= height_matrix.GetHeight());
+
+  const short *src = height_matrix.GetData() +
+    y_begin * height_matrix.GetWidth();
   const BGRColor *oColorBuf = color_table + 64 * 256;
-  BGRColor *dest = image->GetTopRow();
+  BGRColor *dest = GetImageRow(*image, y_begin);
 
-  for (unsigned y = height_matrix.GetHeight(); y > 0; --y) {
+  for (unsigned y = y_end - y_begin; y > 0; --y) {
     BGRColor *p = dest;
     dest = image->GetNextRow(dest);
 
@@ -207,8 +350,6 @@ RasterRenderer::GenerateUnshadedImage(unsigned height_scale)
       }
     }
   }
-
-  image->SetDirty();
 }
 
 /**
@@ -237,8 +378,28 @@ void
 RasterRenderer::GenerateSlopeImage(unsigned height_scale,
                                    int contrast,
                                    const int sx, const int sy, const int sz)
+{
+#ifdef ENABLE_PARALLEL_RASTER
+  ForEachBand([=](unsigned y_begin, unsigned y_end){
+      GenerateSlopeImage(height_scale, contrast, sx, sy, sz, y_begin, y_end);
+    });
+#else
+  GenerateSlopeImage(height_scale, contrast, sx, sy, sz,
+                     0, height_matrix.GetHeight());
+#endif
+
+  image->SetDirty();
+}
+
+void
+RasterRenderer::GenerateSlopeImage(unsigned height_scale,
+                                   int contrast,
+                                   const int sx, const int sy, const int sz,
+                                   unsigned y_begin, unsigned y_end)
 {
   assert(quantisation_effective > 0);
+  assert(y_begin <= y_end);
+  assert(y_end <= height_matrix.GetHeight());
 
   PixelRect border;
   border.left = quantisation_effective;
@@ -248,7 +409,8 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
 
   const unsigned height_slope_factor = std::max(1, (int)pixel_size);
 
-  const short *src = height_matrix.GetData();
+  const short *src = height_matrix.GetData() +
+    y_begin * height_matrix.GetWidth();
   const BGRColor *oColorBuf = color_table + 64 * 256;
 #ifdef FAST_RSQRT
   const short szindex = sz*contrast/128;
@@ -260,9 +422,9 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
   const int sz_c = sz*contrast>>7;
 #endif
 
-  BGRColor *dest = image->GetTopRow();
+  BGRColor *dest = GetImageRow(*image, y_begin);
 
-  for (unsigned y = 0; y < height_matrix.GetHeight(); ++y) {
+  for (unsigned y = y_begin; y < y_end; ++y) {
     const unsigned row_plus_index = y < (unsigned)border.bottom
       ? quantisation_effective
       : height_matrix.GetHeight() - 1 - y;
@@ -363,8 +525,6 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
       }
     }
   }
-
-  image->SetDirty();
 }
 
 void
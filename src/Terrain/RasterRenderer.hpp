@@ -33,6 +33,10 @@ Copyright_License {
 #include "Geo/GeoBounds.hpp"
 #endif
 
+#ifdef ENABLE_PARALLEL_RASTER
+#include <functional>
+#endif
+
 #define NUM_COLOR_RAMP_LEVELS 13
 
 class Angle;
@@ -75,6 +79,21 @@ class RasterRenderer : private NonCopyable {
 
   BGRColor color_table[256 * 128];
 
+#ifdef ENABLE_PARALLEL_RASTER
+  static constexpr unsigned MAX_BAND_THREADS = 3;
+
+  class BandThread;
+
+  /**
+   * Helper threads which generate horizontal bands of the image,
+   * while the calling thread generates the first band.  They are
+   * created by the first GenerateImage() call.
+   */
+  BandThread *band_threads[MAX_BAND_THREADS];
+  unsigned num_band_threads;
+  bool band_threads_initialised;
+#endif
+
 public:
   RasterRenderer();
   ~RasterRenderer();
@@ -141,18 +160,44 @@ protected:
    */
   void GenerateUnshadedImage(unsigned height_scale);
 
+  /**
+   * Convert the rows [y_begin, y_end) of the height matrix into the
+   * image, without shading.
+   */
+  void GenerateUnshadedImage(unsigned height_scale,
+                             unsigned y_begin, unsigned y_end);
+
   /**
    * Convert the height matrix into the image, with slope shading.
    */
   void GenerateSlopeImage(unsigned height_scale, int contrast,
                           const int sx, const int sy, const int sz);
 
+  /**
+   * Convert the rows [y_begin, y_end) of the height matrix into the
+   * image, with slope shading.
+   */
+  void GenerateSlopeImage(unsigned height_scale, int contrast,
+                          const int sx, const int sy, const int sz,
+                          unsigned y_begin, unsigned y_end);
+
   /**
    * Convert the height matrix into the image, with slope shading.
    */
   void GenerateSlopeImage(unsigned height_scale,
                           int contrast, int brightness,
                           const Angle sunazimuth);
+
+#ifdef ENABLE_PARALLEL_RASTER
+  typedef std::function<void(unsigned y_begin, unsigned y_end)> BandFunction;
+
+  /**
+   * Split the height matrix into horizontal bands and invoke the
+   * function for each of them, one band per CPU core.  Returns after
+   * all bands are finished.
+   */
+  void ForEachBand(const BandFunction &f);
+#endif
 };
 
 #endif
@@ -24,6 +24,7 @@ Copyright_License {
 #include "Terrain/RasterTile.hpp"
 
 #include <algorithm>
+#include <limits.h>
 
 bool
 RasterTile::SaveCache(FILE *file) const
@@ -58,6 +59,99 @@ RasterTile::Enable()
   }
 }
 
+void
+RasterTile::UpdatePyramid()
+{
+  assert(IsEnabled());
+
+  /* level 0 is built from the raw height data */
+
+  const unsigned size = 1u << PYRAMID_BITS;
+  AllocatedGrid<HeightRange> &base = pyramid[0];
+  base.GrowDiscard((width + size - 1) >> PYRAMID_BITS,
+                   (height + size - 1) >> PYRAMID_BITS);
+
+  for (unsigned by = 0; by < base.GetHeight(); ++by) {
+    const unsigned y_end = std::min((by + 1) * size, height);
+
+    for (unsigned bx = 0; bx < base.GetWidth(); ++bx) {
+      const unsigned x_begin = bx * size;
+      const unsigned x_end = std::min(x_begin + size, width);
+
+      short minimum = SHRT_MAX, maximum = SHRT_MIN;
+      for (unsigned y = by * size; y < y_end; ++y) {
+        const short *p = buffer.GetDataAt(x_begin, y);
+        const short *end = p + (x_end - x_begin);
+        for (; p != end; ++p) {
+          minimum = std::min(minimum, *p);
+          maximum = std::max(maximum, *p);
+        }
+      }
+
+      HeightRange &range = base.Get(bx, by);
+      range.minimum = minimum;
+      range.maximum = maximum;
+    }
+  }
+
+  /* each coarser level merges 2x2 blocks of the previous one */
+
+  for (unsigned level = 1; level < PYRAMID_LEVELS; ++level) {
+    const AllocatedGrid<HeightRange> &src = pyramid[level - 1];
+    AllocatedGrid<HeightRange> &dest = pyramid[level];
+    dest.GrowDiscard((src.GetWidth() + 1) / 2, (src.GetHeight() + 1) / 2);
+
+    for (unsigned by = 0; by < dest.GetHeight(); ++by) {
+      const unsigned y_end = std::min(by * 2 + 2, src.GetHeight());
+
+      for (unsigned bx = 0; bx < dest.GetWidth(); ++bx) {
+        const unsigned x_end = std::min(bx * 2 + 2, src.GetWidth());
+
+        HeightRange range = src.Get(bx * 2, by * 2);
+        for (unsigned y = by * 2; y < y_end; ++y) {
+          for (unsigned x = bx * 2; x < x_end; ++x) {
+            const HeightRange &r = src.Get(x, y);
+            range.minimum = std::min(range.minimum, r.minimum);
+            range.maximum = std::max(range.maximum, r.maximum);
+          }
+        }
+
+        dest.Get(bx, by) = range;
+      }
+    }
+  }
+}
+
+unsigned
+RasterTile::GetBlockSteps(unsigned level, unsigned x, unsigned y,
+                          int sx, int sy) const
+{
+  const unsigned size = 1u << (PYRAMID_BITS + level);
+
+  x -= xstart;
+  y -= ystart;
+
+  assert(x < width);
+  assert(y < height);
+
+  unsigned steps_x = UINT_MAX, steps_y = UINT_MAX;
+
+  if (sx > 0)
+    steps_x = std::min((x | (size - 1)) + 1, width) - x;
+  else if (sx < 0)
+    steps_x = (x & (size - 1)) + 1;
+
+  if (sy > 0)
+    steps_y = std::min((y | (size - 1)) + 1, height) - y;
+  else if (sy < 0)
+    steps_y = (y & (size - 1)) + 1;
+
+  /* each step moves along only one axis, therefore all positions
+     reached with fewer steps than the distance to the nearest block
+     edge are still inside the block */
+  return std::min(steps_x, steps_y);
+}
+
 short
 RasterTile::GetHeight(unsigned x, unsigned y) const
 {
@@ -35,6 +35,26 @@ class RasterTile : private NonCopyable {
   };
 
 public:
+  /**
+   * The lowest and highest height within one block of the min/max
+   * pyramid.
+   */
+  struct HeightRange {
+    short minimum, maximum;
+  };
+
+  /**
+   * The finest level of the min/max pyramid covers blocks of
+   * 2^PYRAMID_BITS pixels.
+   */
+  static constexpr unsigned PYRAMID_BITS = 5;
+
+  /**
+   * The number of pyramid levels; each level doubles the block size
+   * of the previous one.
+   */
+  static constexpr unsigned PYRAMID_LEVELS = 4;
+
   unsigned int xstart, ystart, xend, yend;
   unsigned int width, height;
 
@@ -48,6 +68,13 @@ public:
 
   RasterBuffer buffer;
 
+  /**
+   * The min/max pyramid of the loaded #buffer, used by the terrain
+   * intersection searches to skip whole blocks.  It is built by
+   * UpdatePyramid() after the tile has been loaded.
+   */
+  AllocatedGrid<HeightRange> pyramid[PYRAMID_LEVELS];
+
 public:
   RasterTile()
     :xstart(0), ystart(0), xend(0), yend(0),
@@ -98,6 +125,9 @@ public:
 
   void Disable() {
     buffer.Reset();
+
+    for (unsigned level = 0; level < PYRAMID_LEVELS; ++level)
+      pyramid[level].Reset();
   }
 
   void Enable();
@@ -131,6 +161,44 @@ public:
   short GetInterpolatedHeight(unsigned x, unsigned y,
                               unsigned ix, unsigned iy) const;
 
+  /**
+   * Build the min/max pyramid from the freshly loaded #buffer.
+   */
+  void UpdatePyramid();
+
+  bool HasPyramid() const {
+    return pyramid[0].IsDefined();
+  }
+
+  /**
+   * Look up the height range of the pyramid block containing the
+   * specified pixel.
+   *
+   * @param level the pyramid level (0 is the finest)
+   * @param x the pixel column within the map; must be within the tile
+   * @param y the pixel row within the map; must be within the tile
+   */
+  gcc_pure
+  const HeightRange &GetBlockRange(unsigned level,
+                                   unsigned x, unsigned y) const {
+    assert(HasPyramid());
+    assert(level < PYRAMID_LEVELS);
+
+    const unsigned shift = PYRAMID_BITS + level;
+    return pyramid[level].Get((x - xstart) >> shift, (y - ystart) >> shift);
+  }
+
+  /**
+   * Determine how many steps a line walking from the specified pixel
+   * into the direction (sx, sy) may make before it can leave the
+   * pyramid block, i.e. all positions reached with fewer steps are
+   * inside the block.  A direction of zero means the line does not
+   * move along that axis.
+   */
+  gcc_pure
+  unsigned GetBlockSteps(unsigned level, unsigned x, unsigned y,
+                         int sx, int sy) const;
+
   inline short* GetImageBuffer() {
     return buffer.GetData();
   }
@@ -28,6 +28,7 @@ Copyright_License {
 #include "IO/ZipLineReader.hpp"
 #include "Operation/Operation.hpp"
 #include "Math/FastMath.h"
+#include "Thread/FastMutex.hpp"
 
 #include <string.h>
 #include <algorithm>
@@ -324,15 +325,24 @@ RasterTileCache::MarkerSegment(long file_offset, unsigned id)
 
 extern RasterTileCache *raster_tile_current;
 
+/**
+ * The JPEG2000 decoder reports to the global variable
+ * #raster_tile_current.  This mutex serialises all decoder runs, so
+ * raster files may be loaded by more than one thread.
+ */
+static FastMutex jpeg2000_mutex;
+
 void
 RasterTileCache::LoadJPG2000(const char *jp2_filename)
 {
   jas_stream_t *in;
 
+  jpeg2000_mutex.Lock();
   raster_tile_current = this;
 
   in = jas_stream_fopen(jp2_filename, "rb");
   if (!in) {
+    jpeg2000_mutex.Unlock();
     Reset();
     return;
   }
@@ -342,6 +352,7 @@ RasterTileCache::LoadJPG2000(const char *jp2_filename)
 
   jp2_decode(in, scan_overview ? "xcsoar=2" : "xcsoar=1");
   jas_stream_close(in);
+  jpeg2000_mutex.Unlock();
 }
 
 bool
@@ -441,11 +452,16 @@ RasterTileCache::UpdateTiles(const char *path, int x, int y, unsigned radius)
 
   /* permanently disable the requested tiles which are still not
      loaded, to prevent trying to reload them over and over in a busy
-     loop */
+     loop; build the min/max pyramid of the new ones */
   for (auto it = request_tiles.begin(), end = request_tiles.end();
       it != end; ++it) {
     RasterTile &tile = tiles.GetLinear(*it);
-    if (tile.IsRequested() && !tile.IsEnabled())
+    if (!tile.IsRequested())
+      continue;
+
+    if (tile.IsEnabled())
+      tile.UpdatePyramid();
+    else
       tile.Clear();
   }
 
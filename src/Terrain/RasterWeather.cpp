@@ -30,6 +30,7 @@ Copyright_License {
 #include "Util/ConvertString.hpp"
 #include "Util/Clamp.hpp"
 #include "Operation/Operation.hpp"
+#include "Thread/Mutex.hpp"
 #include "zzip/zzip.h"
 
 #include <assert.h>
@@ -101,8 +102,12 @@ RasterWeather::RasterWeather()
     _parameter(0),
     _weather_time(0),
     reload(true),
-    weather_map(NULL)
+    current_time(0),
+    weather_map(NULL),
+    preloader(*this)
 {
+  view_location.SetInvalid();
+  view_radius = fixed(0);
   std::fill(weather_available, weather_available + MAX_WEATHER_TIMES, false);
 }
 
@@ -186,21 +191,65 @@ RasterWeather::GetFilename(TCHAR *rasp_filename, const TCHAR* name,
   LocalPath(rasp_filename, fname);
 }
 
-bool
-RasterWeather::LoadItem(const TCHAR* name, unsigned time_index,
+RasterMap *
+RasterWeather::LoadItem(unsigned parameter, unsigned time_index,
                         OperationEnvironment &operation)
 {
+  assert(parameter > 0 && parameter < MAX_WEATHER_MAP);
+
   TCHAR rasp_filename[MAX_PATH];
-  GetFilename(rasp_filename, name, time_index);
+  GetFilename(rasp_filename, WeatherDescriptors[parameter].name, time_index);
   RasterMap *map = new RasterMap(rasp_filename, NULL, NULL, operation);
-  if (!map->IsDefined()) {
+  if (map->IsDefined())
+    return map;
+
+  delete map;
+
+  if (parameter != 1)
+    return NULL;
+
+  /* fall back to the alternative W* file name */
+  GetFilename(rasp_filename, _T("wstar_bsratio"), time_index);
+  map = new RasterMap(rasp_filename, NULL, NULL, operation);
+  if (map->IsDefined())
+    return map;
+
+  delete map;
+  return NULL;
+}
+
+bool
+RasterWeather::AddCached(unsigned parameter, unsigned time_index,
+                         RasterMap *map)
+{
+  RasterMap *evicted;
+  const bool added = cache.Add(parameter, time_index, map,
+                               _parameter, current_time, weather_map,
+                               evicted);
+  delete evicted;
+
+  if (!added)
     delete map;
-    return false;
-  }
 
-  delete weather_map;
-  weather_map = map;
-  return true;
+  return added;
+}
+
+void
+RasterWeather::ClearCache()
+{
+  for (auto i = cache.begin(), end = cache.end(); i != end; ++i)
+    delete i->map;
+
+  cache.clear();
+}
+
+int
+RasterWeather::FindPreloadTime(unsigned parameter, unsigned time_index) const
+{
+  if (parameter == 0 || parameter != _parameter)
+    return -1;
+
+  return cache.FindPreloadTime(parameter, time_index, weather_available);
 }
 
 bool
@@ -287,10 +336,23 @@ RasterWeather::Reload(int day_time_local, OperationEnvironment &operation)
 
       _Close();
 
-      if (!LoadItem(WeatherDescriptors[_parameter].name, _weather_time,
-                    operation) &&
-          _parameter == 1)
-        LoadItem(_T("wstar_bsratio"), _weather_time, operation);
+      /* rank the cached maps against the actual time step, even in
+         "Now" mode, where _weather_time is reset to 0 below */
+      current_time = _weather_time;
+
+      const RasterWeatherCache::Item *cached =
+        cache.Find(_parameter, _weather_time);
+      if (cached == NULL) {
+        AddCached(_parameter, _weather_time,
+                  LoadItem(_parameter, _weather_time, operation));
+        cached = cache.Find(_parameter, _weather_time);
+      }
+
+      if (cached != NULL)
+        weather_map = cached->map;
+
+      preloader.Request(_parameter, _weather_time,
+                        view_location, view_radius);
     }
   }
 
@@ -302,14 +364,17 @@ RasterWeather::Reload(int day_time_local, OperationEnvironment &operation)
 void
 RasterWeather::Close()
 {
+  preloader.Stop();
+
   Poco::ScopedRWLock protect(lock, true);
   _Close();
+  ClearCache();
 }
 
 void
 RasterWeather::_Close()
 {
-  delete weather_map;
+  /* the map itself is owned by the cache */
   weather_map = NULL;
   center = GeoPoint(Angle::Zero(), Angle::Zero());
 }
@@ -317,6 +382,9 @@ RasterWeather::_Close()
 void
 RasterWeather::SetViewCenter(const GeoPoint &location, fixed radius)
 {
+  view_location = location;
+  view_radius = radius;
+
   if (_parameter == 0 || weather_map == NULL)
     // will be drawing terrain
     return;
@@ -342,6 +410,74 @@ RasterWeather::IsDirty() const
   return weather_map->IsDirty();
 }
 
+void
+RasterWeather::Preloader::Request(unsigned _parameter, unsigned _time_index,
+                                  const GeoPoint &_location, fixed _radius)
+{
+  ScopeLock protect(mutex);
+  parameter = _parameter;
+  time_index = _time_index;
+  location = _location;
+  radius = _radius;
+
+  if (!IsBusy())
+    Trigger();
+}
+
+void
+RasterWeather::Preloader::Stop()
+{
+  ScopeLock protect(mutex);
+  StopAsync();
+  WaitStopped();
+}
+
+void
+RasterWeather::Preloader::Tick()
+{
+  while (!IsStopped()) {
+    const unsigned _parameter = parameter, _time_index = time_index;
+    const GeoPoint _location = location;
+    const fixed _radius = radius;
+
+    /* don't hold the mutex while obtaining RasterWeather::lock,
+       because Reload() locks them in the opposite order */
+    mutex.Unlock();
+
+    int next;
+    {
+      Poco::ScopedRWLock protect(weather.lock, false);
+      next = weather.FindPreloadTime(_parameter, _time_index);
+    }
+
+    bool added = false;
+    if (next >= 0) {
+      NullOperationEnvironment operation;
+      RasterMap *map = LoadItem(_parameter, next, operation);
+      if (map != NULL && _location.IsValid()) {
+        /* load the tiles around the current view; bounded, because
+           the view may be outside of the forecast area */
+        for (unsigned i = 0; i < 16; ++i) {
+          map->SetViewCenter(_location, _radius);
+          if (!map->IsDirty())
+            break;
+        }
+      }
+
+      Poco::ScopedRWLock protect(weather.lock, true);
+      /* a NULL map is cached as well, so a missing or broken file
+         isn't retried over and over */
+      added = weather.AddCached(_parameter, next, map);
+    }
+
+    mutex.Lock();
+
+    if (!added && parameter == _parameter && time_index == _time_index)
+      /* nothing left to do, and no new request has arrived */
+      break;
+  }
+}
+
 const TCHAR*
 RasterWeather::ItemLabel(unsigned i)
 {
@@ -24,8 +24,10 @@ Copyright_License {
 #ifndef XCSOAR_TERRAIN_RASTER_WEATHER_HPP
 #define XCSOAR_TERRAIN_RASTER_WEATHER_HPP
 
+#include "Terrain/RasterWeatherCache.hpp"
 #include "Geo/GeoPoint.hpp"
 #include "Poco/RWLock.h"
+#include "Thread/StandbyThread.hpp"
 #include "Compiler.h"
 
 #include <tchar.h>
@@ -40,20 +42,69 @@ struct zzip_dir;
 class RasterWeather {
 public:
   static constexpr unsigned MAX_WEATHER_MAP = 16; /**< Max number of items stored */
-  static constexpr unsigned MAX_WEATHER_TIMES = 48; /**< Max time segments of each item */
+  static constexpr unsigned MAX_WEATHER_TIMES = RasterWeatherCache::MAX_TIMES; /**< Max time segments of each item */
 
 private:
+  /**
+   * Decodes the other time steps of the selected parameter in
+   * background, so stepping through the forecast doesn't have to
+   * wait for the JPEG2000 decoder.
+   */
+  class Preloader : public StandbyThread {
+    RasterWeather &weather;
+
+    /* the following attributes are protected by StandbyThread::mutex */
+    unsigned parameter, time_index;
+    GeoPoint location;
+    fixed radius;
+
+  public:
+    Preloader(RasterWeather &_weather)
+      :weather(_weather) {}
+
+    void Request(unsigned parameter, unsigned time_index,
+                 const GeoPoint &location, fixed radius);
+
+    void Stop();
+
+  protected:
+    virtual void Tick() gcc_override;
+  };
+
   GeoPoint center;
 
+  /**
+   * The location passed to the last SetViewCenter() call.
+   */
+  GeoPoint view_location;
+  fixed view_radius;
+
   unsigned _parameter;
   unsigned _weather_time;
   bool reload;
+
+  /**
+   * The time step of #weather_map.  Unlike #_weather_time, this is
+   * the actual time step in "Now" mode.  Protected by #lock.
+   */
+  unsigned current_time;
+
+  /**
+   * The current map; points into #cache.
+   */
   RasterMap *weather_map;
 
   mutable Poco::RWLock lock;
 
   bool weather_available[MAX_WEATHER_TIMES];
 
+  /**
+   * Decoded maps, owned by this object.  Protected by #lock.
+   */
+  RasterWeatherCache cache;
+
+  Preloader preloader;
+
 public:
   /** 
    * Default constructor
@@ -106,8 +157,38 @@ private:
   static void GetFilename(TCHAR *rasp_filename, const TCHAR *name,
                           unsigned time_index);
 
-  bool LoadItem(const TCHAR* name, unsigned time_index,
-                OperationEnvironment &operation);
+  /**
+   * Load the map of the specified parameter and time step.  Does
+   * not touch any attributes, and may be called without the lock.
+   *
+   * @return the new map (to be deleted by the caller) or NULL on
+   * error
+   */
+  static RasterMap *LoadItem(unsigned parameter, unsigned time_index,
+                             OperationEnvironment &operation);
+
+  /**
+   * Add a map to the cache; see RasterWeatherCache::Add().  The maps
+   * which are not kept are deleted.
+   *
+   * Caller must hold the lock for writing.
+   *
+   * @return true if the map was added
+   */
+  bool AddCached(unsigned parameter, unsigned time_index, RasterMap *map);
+
+  /**
+   * Delete all cached maps.  Caller must hold the lock for writing.
+   */
+  void ClearCache();
+
+  /**
+   * Determine the next time step which shall be preloaded, or -1 if
+   * the cache has enough maps around the specified time.  Caller
+   * must hold the lock.
+   */
+  gcc_pure
+  int FindPreloadTime(unsigned parameter, unsigned time_index) const;
 
   gcc_pure
   bool ExistsItem(struct zzip_dir *dir, const TCHAR* name,
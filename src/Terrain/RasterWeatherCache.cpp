@@ -0,0 +1,113 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "RasterWeatherCache.hpp"
+
+#include <iterator>
+
+unsigned
+RasterWeatherCache::TimeRank(unsigned time_index, unsigned current)
+{
+  return time_index >= current
+    ? time_index - current
+    : MAX_TIMES - 1 - time_index;
+}
+
+const RasterWeatherCache::Item *
+RasterWeatherCache::Find(unsigned parameter, unsigned time_index) const
+{
+  for (auto i = items.begin(), end = items.end(); i != end; ++i)
+    if (i->parameter == parameter && i->time_index == time_index)
+      return i;
+
+  return NULL;
+}
+
+bool
+RasterWeatherCache::Add(unsigned parameter, unsigned time_index,
+                        RasterMap *map,
+                        unsigned current_parameter, unsigned current_time,
+                        const RasterMap *current_map, RasterMap *&evicted_r)
+{
+  evicted_r = NULL;
+
+  if (parameter != current_parameter || Find(parameter, time_index) != NULL)
+    return false;
+
+  if (items.full()) {
+    /* find the least useful entry: maps of another parameter first,
+       then the one farthest away from the current time step; never
+       evict the current map */
+    Item *victim = NULL;
+    unsigned victim_rank = 0;
+    for (auto i = items.begin(), end = items.end(); i != end; ++i) {
+      if (i->map != NULL && i->map == current_map)
+        continue;
+
+      const unsigned rank = i->parameter != current_parameter
+        ? MAX_TIMES
+        : TimeRank(i->time_index, current_time);
+      if (victim == NULL || rank > victim_rank) {
+        victim = i;
+        victim_rank = rank;
+      }
+    }
+
+    if (victim == NULL ||
+        victim_rank <= TimeRank(time_index, current_time))
+      return false;
+
+    evicted_r = victim->map;
+    items.quick_remove(std::distance(items.begin(), victim));
+  }
+
+  Item &item = items.append();
+  item.parameter = parameter;
+  item.time_index = time_index;
+  item.map = map;
+  return true;
+}
+
+int
+RasterWeatherCache::FindPreloadTime(unsigned parameter, unsigned time_index,
+                                    const bool *available) const
+{
+  /* walk through the available time steps in the order of
+     TimeRank(), and stop after as many as fit into the cache */
+  unsigned n = 0;
+  for (unsigned rank = 0; rank < MAX_TIMES; ++rank) {
+    const unsigned t = time_index + rank < MAX_TIMES
+      ? time_index + rank
+      : MAX_TIMES - 1 - rank;
+    if (!available[t])
+      continue;
+
+    if (Find(parameter, t) == NULL)
+      return t;
+
+    if (++n >= MAX_SIZE)
+      break;
+  }
+
+  return -1;
+}
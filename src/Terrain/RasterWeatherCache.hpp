@@ -0,0 +1,129 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_RASTER_WEATHER_CACHE_HPP
+#define XCSOAR_TERRAIN_RASTER_WEATHER_CACHE_HPP
+
+#include "Util/StaticArray.hpp"
+#include "Compiler.h"
+
+class RasterMap;
+
+/**
+ * The decoded weather maps kept in memory by #RasterWeather, and the
+ * policy which of them to keep and which to preload.
+ *
+ * This class does not own the maps; the caller is responsible for
+ * deleting them.
+ */
+class RasterWeatherCache {
+public:
+  /**
+   * The number of time steps of a forecast.
+   */
+  static constexpr unsigned MAX_TIMES = 48;
+
+  /**
+   * The maximum number of decoded maps kept in memory.
+   */
+  static constexpr unsigned MAX_SIZE = 12;
+
+  /**
+   * A decoded map of one parameter at one time step.
+   */
+  struct Item {
+    unsigned parameter, time_index;
+
+    /**
+     * The map, or NULL if it could not be loaded.
+     */
+    RasterMap *map;
+  };
+
+private:
+  typedef StaticArray<Item, MAX_SIZE> ItemArray;
+
+  ItemArray items;
+
+public:
+  typedef ItemArray::const_iterator const_iterator;
+
+  const_iterator begin() const {
+    return items.begin();
+  }
+
+  const_iterator end() const {
+    return items.end();
+  }
+
+  unsigned size() const {
+    return items.size();
+  }
+
+  void clear() {
+    items.clear();
+  }
+
+  /**
+   * Returns the preload priority of the specified time step relative
+   * to the current one: first the current time step and the following
+   * ones, then the preceding ones in reverse order.  A smaller value
+   * means the map is more likely to be needed soon.
+   */
+  gcc_const
+  static unsigned TimeRank(unsigned time_index, unsigned current);
+
+  gcc_pure
+  const Item *Find(unsigned parameter, unsigned time_index) const;
+
+  /**
+   * Add a map, evicting the map which is least likely to be needed
+   * soon.  If the cache is full with maps which are more useful (or
+   * if it belongs to a parameter which is not selected anymore), the
+   * new map is not added.
+   *
+   * @param current_parameter the selected parameter
+   * @param current_time the time step of the current map
+   * @param current_map the map being displayed; it is never evicted
+   * @param evicted_r returns the evicted map (to be deleted by the
+   * caller) or NULL
+   * @return true if the map was added, false if the caller shall
+   * delete it
+   */
+  bool Add(unsigned parameter, unsigned time_index, RasterMap *map,
+           unsigned current_parameter, unsigned current_time,
+           const RasterMap *current_map, RasterMap *&evicted_r);
+
+  /**
+   * Determine the next time step which shall be preloaded, or -1 if
+   * the cache has enough maps around the specified time.
+   *
+   * @param available an array of #MAX_TIMES flags specifying which
+   * time steps exist in the forecast
+   */
+  gcc_pure
+  int FindPreloadTime(unsigned parameter, unsigned time_index,
+                      const bool *available) const;
+};
+
+#endif
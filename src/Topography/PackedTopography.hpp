@@ -0,0 +1,216 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TOPOGRAPHY_PACKED_HPP
+#define XCSOAR_TOPOGRAPHY_PACKED_HPP
+
+#include "Geo/GeoBounds.hpp"
+#include "Compiler.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Definitions for the preprocessed topography format (*.xtp).  It is
+ * generated from a map file by tools/PackTopography.cpp, and is
+ * designed to be mapped into memory (see #FileMapping) and rendered
+ * from directly: points are already converted to the metric
+ * #ShapePoint coordinates used by the OpenGL renderer, polygons are
+ * triangulated and all thinning levels are precomputed.  A tile
+ * index per layer replaces msShapefileWhichShapes().
+ *
+ * All integers are stored in host byte order, the magic number is
+ * used to detect a mismatch.  All offsets are relative to the
+ * beginning of the file, and all structures are 4-byte aligned.
+ */
+namespace PackedTopography {
+  static constexpr uint32_t MAGIC = 0x58435450;
+  static constexpr uint32_t VERSION = 1;
+
+  /**
+   * The number of precomputed thinning levels, must be the same as
+   * XShape::THINNING_LEVELS.
+   */
+  static constexpr unsigned THINNING_LEVELS = 4;
+
+  /**
+   * Angles are stored as integer multiples of 10^-7 degrees.
+   */
+  static constexpr int32_t ANGLE_FACTOR = 10000000;
+
+  struct Header {
+    uint32_t magic, version;
+
+    uint32_t num_layers;
+
+    /**
+     * Offset of an array of #Layer objects.
+     */
+    uint32_t layers_offset;
+  };
+
+  struct Point {
+    int32_t longitude, latitude;
+  };
+
+  struct Bounds {
+    int32_t west, south, east, north;
+  };
+
+  struct Layer {
+    /**
+     * The map scale thresholds (see #TopographyFile) in meters.
+     */
+    uint32_t scale_threshold, label_threshold, important_label_threshold;
+
+    int32_t icon;
+
+    uint8_t red, green, blue, pen_width;
+
+    /**
+     * The bounds of all shapes, which are covered by the tile grid.
+     */
+    Bounds bounds;
+
+    uint32_t tile_columns, tile_rows;
+
+    /**
+     * Offset of an array of tile_columns*tile_rows+1 uint32_t values
+     * (row by row), each the position of the tile's first element in
+     * the tile_shapes array.
+     */
+    uint32_t tiles_offset;
+
+    /**
+     * Offset of an array of uint32_t shape indices.  A shape appears
+     * in each tile its bounds overlap.
+     */
+    uint32_t tile_shapes_offset;
+
+    uint32_t num_shapes;
+
+    /**
+     * Offset of an array of #Shape objects.
+     */
+    uint32_t shapes_offset;
+  };
+
+  struct Shape {
+    Bounds bounds;
+
+    /**
+     * The origin of the #ShapePoint coordinates.
+     */
+    Point center;
+
+    /**
+     * The MS_SHAPE_TYPE.
+     */
+    uint8_t type;
+
+    uint8_t num_lines;
+
+    uint16_t reserved;
+
+    uint32_t num_points;
+
+    /**
+     * Offset of an array of num_lines uint16_t values: the number of
+     * points of each line.
+     */
+    uint32_t lines_offset;
+
+    /**
+     * Offset of num_points pairs of int32_t values: the #ShapePoint
+     * coordinates relative to the center, in meters.
+     */
+    uint32_t points_offset;
+
+    /**
+     * Offset of a null-terminated UTF-8 string, or 0 if the shape has
+     * no label.
+     */
+    uint32_t label_offset;
+
+    /**
+     * For each thinning level, the offset of a uint16_t array in the
+     * layout of XShape::get_indices(): first the counts (one per line
+     * for lines, one in total for polygons), followed by the indices.
+     * 0 if there are no indices for this level.
+     */
+    uint32_t indices_offset[THINNING_LEVELS];
+  };
+
+  static inline int32_t
+  ExportAngle(Angle angle)
+  {
+    const double degrees = (double)angle.Degrees() * ANGLE_FACTOR;
+    return (int32_t)(degrees >= 0 ? degrees + 0.5 : degrees - 0.5);
+  }
+
+  static inline Angle
+  ImportAngle(int32_t value)
+  {
+    return Angle::Degrees(fixed(value) / ANGLE_FACTOR);
+  }
+
+  static inline GeoPoint
+  ImportPoint(const Point &point)
+  {
+    return GeoPoint(ImportAngle(point.longitude),
+                    ImportAngle(point.latitude));
+  }
+
+  static inline GeoBounds
+  ImportBounds(const Bounds &bounds)
+  {
+    return GeoBounds(GeoPoint(ImportAngle(bounds.west),
+                              ImportAngle(bounds.north)),
+                     GeoPoint(ImportAngle(bounds.east),
+                              ImportAngle(bounds.south)));
+  }
+
+  /**
+   * Check whether the specified range lies inside a buffer of the
+   * given size, without risking integer overflows.
+   */
+  gcc_const
+  static inline bool
+  CheckRange(size_t size, uint32_t offset, size_t count, size_t item_size)
+  {
+    return offset <= size && count <= (size - offset) / item_size;
+  }
+
+  /**
+   * Return a pointer to the object at the given offset.  The caller
+   * is responsible for checking the range first.
+   */
+  template<typename T>
+  static inline const T *
+  At(const void *data, uint32_t offset)
+  {
+    return (const T *)(const void *)((const uint8_t *)data + offset);
+  }
+}
+
+#endif
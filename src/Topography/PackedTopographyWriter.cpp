@@ -0,0 +1,267 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Topography/PackedTopographyWriter.hpp"
+#include "Topography/PackedTopography.hpp"
+#include "Topography/TopographyStore.hpp"
+#include "Topography/TopographyFile.hpp"
+#include "Topography/XShape.hpp"
+#include "Util/Clamp.hpp"
+
+#include <vector>
+#include <algorithm>
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifndef ENABLE_OPENGL
+#error WritePackedTopography() requires OpenGL for triangulating the polygons
+#endif
+
+using namespace PackedTopography;
+
+/**
+ * A growing buffer for the output file.
+ */
+class Writer {
+  std::vector<uint8_t> buffer;
+
+public:
+  const std::vector<uint8_t> &GetBuffer() const {
+    return buffer;
+  }
+
+  /**
+   * Append data, aligned to 4 bytes.
+   *
+   * @return the offset of the data in the file
+   */
+  uint32_t Append(const void *data, size_t size) {
+    buffer.resize((buffer.size() + 3) & ~size_t(3));
+    const uint32_t offset = buffer.size();
+    const uint8_t *p = (const uint8_t *)data;
+    buffer.insert(buffer.end(), p, p + size);
+    return offset;
+  }
+
+  uint32_t AppendString(const char *s) {
+    return Append(s, strlen(s) + 1);
+  }
+
+  /**
+   * Reserve space for an object which will be filled in later with
+   * At().
+   */
+  template<typename T>
+  uint32_t Reserve(size_t n=1) {
+    buffer.resize((buffer.size() + 3) & ~size_t(3));
+    const uint32_t offset = buffer.size();
+    buffer.resize(buffer.size() + n * sizeof(T));
+    return offset;
+  }
+
+  template<typename T>
+  T &At(uint32_t offset) {
+    return *(T *)(void *)&buffer[offset];
+  }
+};
+
+static Bounds
+ExportBounds(const GeoBounds &bounds)
+{
+  Bounds b;
+  b.west = ExportAngle(bounds.GetWest());
+  b.south = ExportAngle(bounds.GetSouth());
+  b.east = ExportAngle(bounds.GetEast());
+  b.north = ExportAngle(bounds.GetNorth());
+  return b;
+}
+
+static uint32_t
+WriteIndices(Writer &writer, const TopographyFile &file, const XShape &shape,
+             unsigned level)
+{
+  const unsigned short *count;
+  const unsigned short *indices =
+    shape.get_indices(level, file.GetMinimumPointDistance(level), count);
+  if (indices == NULL)
+    return 0;
+
+  /* counts and indices are stored in one buffer, see
+     XShape::BuildIndices() */
+  unsigned num_indices = 0;
+  for (const unsigned short *i = count; i != indices; ++i)
+    num_indices += *i;
+
+  return writer.Append(count,
+                       (indices - count + num_indices) * sizeof(*count));
+}
+
+static void
+WriteShape(Writer &writer, const TopographyFile &file, const XShape &shape,
+           Shape &record)
+{
+  const unsigned num_lines = shape.get_number_of_lines();
+  const unsigned short *lines = shape.get_lines();
+
+  unsigned num_points = 0;
+  for (unsigned i = 0; i < num_lines; ++i)
+    num_points += lines[i];
+
+  record.bounds = ExportBounds(shape.get_bounds());
+  record.center.longitude = ExportAngle(shape.get_center().longitude);
+  record.center.latitude = ExportAngle(shape.get_center().latitude);
+  record.type = shape.get_type();
+  record.num_lines = num_lines;
+  record.reserved = 0;
+  record.num_points = num_points;
+  record.lines_offset = writer.Append(lines, num_lines * sizeof(*lines));
+  record.points_offset = writer.Append(shape.get_points(),
+                                       num_points * sizeof(ShapePoint));
+  record.label_offset = shape.get_label() != NULL
+    ? writer.AppendString(shape.get_label())
+    : 0;
+
+  for (unsigned level = 0; level < THINNING_LEVELS; ++level)
+    record.indices_offset[level] =
+      shape.get_type() == MS_SHAPE_LINE || shape.get_type() == MS_SHAPE_POLYGON
+      ? WriteIndices(writer, file, shape, level)
+      : 0;
+}
+
+gcc_const
+static unsigned
+ToTile(int32_t value, int32_t min, int32_t max, unsigned n)
+{
+  return std::min(unsigned(((int64_t)value - min) * n /
+                           ((int64_t)max - min + 1)),
+                  n - 1);
+}
+
+static void
+WriteLayer(Writer &writer, const TopographyFile &file, uint32_t layer_offset)
+{
+  std::vector<const XShape *> shapes;
+  for (const XShape &shape : file)
+    if (shape.get_number_of_lines() > 0)
+      shapes.push_back(&shape);
+
+  /* the record is filled in a local copy, because the Writer buffer
+     may be reallocated while writing the shapes */
+  Layer layer;
+  memset(&layer, 0, sizeof(layer));
+  layer.scale_threshold = (uint32_t)file.GetScaleThreshold();
+  layer.label_threshold = (uint32_t)file.GetLabelThreshold();
+  layer.important_label_threshold =
+    (uint32_t)file.GetImportantLabelThreshold();
+  layer.icon = file.GetIcon();
+  layer.red = file.GetColor().Red();
+  layer.green = file.GetColor().Green();
+  layer.blue = file.GetColor().Blue();
+  layer.pen_width = file.GetPenWidth();
+  layer.num_shapes = shapes.size();
+
+  std::vector<Shape> records(shapes.size());
+  GeoBounds bounds = GeoBounds::Invalid();
+  for (unsigned i = 0; i < shapes.size(); ++i) {
+    WriteShape(writer, file, *shapes[i], records[i]);
+    bounds.Extend(shapes[i]->get_bounds().GetNorthWest());
+    bounds.Extend(shapes[i]->get_bounds().GetSouthEast());
+  }
+
+  layer.shapes_offset = writer.Append(records.data(),
+                                      records.size() * sizeof(Shape));
+
+  if (shapes.empty())
+    bounds = GeoBounds(GeoPoint(Angle::Zero(), Angle::Zero()));
+  layer.bounds = ExportBounds(bounds);
+
+  /* build the tile index: about four shapes per tile */
+  const unsigned n = Clamp(unsigned(sqrt(shapes.size() / 4.)), 1u, 256u);
+  layer.tile_columns = layer.tile_rows = n;
+
+  std::vector<std::vector<uint32_t>> tiles(n * n);
+  for (unsigned i = 0; i < records.size(); ++i) {
+    const Bounds &b = records[i].bounds;
+    const unsigned column_min = ToTile(b.west, layer.bounds.west,
+                                       layer.bounds.east, n);
+    const unsigned column_max = ToTile(b.east, layer.bounds.west,
+                                       layer.bounds.east, n);
+    const unsigned row_min = ToTile(b.south, layer.bounds.south,
+                                    layer.bounds.north, n);
+    const unsigned row_max = ToTile(b.north, layer.bounds.south,
+                                    layer.bounds.north, n);
+
+    for (unsigned row = row_min; row <= row_max; ++row)
+      for (unsigned column = column_min; column <= column_max; ++column)
+        tiles[row * n + column].push_back(i);
+  }
+
+  std::vector<uint32_t> tile_table, tile_shapes;
+  for (const auto &tile : tiles) {
+    tile_table.push_back(tile_shapes.size());
+    tile_shapes.insert(tile_shapes.end(), tile.begin(), tile.end());
+  }
+  tile_table.push_back(tile_shapes.size());
+
+  layer.tiles_offset = writer.Append(tile_table.data(),
+                                     tile_table.size() * sizeof(uint32_t));
+  layer.tile_shapes_offset =
+    writer.Append(tile_shapes.data(), tile_shapes.size() * sizeof(uint32_t));
+
+  writer.At<Layer>(layer_offset) = layer;
+}
+
+bool
+WritePackedTopography(const TopographyStore &topography, const char *path)
+{
+  Writer writer;
+  const uint32_t header_offset = writer.Reserve<Header>();
+  const uint32_t layers_offset = writer.Reserve<Layer>(topography.size());
+
+  for (unsigned i = 0; i < topography.size(); ++i)
+    WriteLayer(writer, topography[i], layers_offset + i * sizeof(Layer));
+
+  /* TopographyStore::LoadPacked() requires the file to end with a
+     null byte, so all strings are terminated */
+  writer.AppendString("");
+
+  Header &header = writer.At<Header>(header_offset);
+  header.magic = MAGIC;
+  header.version = VERSION;
+  header.num_layers = topography.size();
+  header.layers_offset = layers_offset;
+
+  FILE *file = fopen(path, "wb");
+  if (file == NULL)
+    return false;
+
+  const std::vector<uint8_t> &buffer = writer.GetBuffer();
+  if (fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+    fclose(file);
+    return false;
+  }
+
+  return fclose(file) == 0;
+}
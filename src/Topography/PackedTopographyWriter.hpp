@@ -0,0 +1,41 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TOPOGRAPHY_PACKED_WRITER_HPP
+#define XCSOAR_TOPOGRAPHY_PACKED_WRITER_HPP
+
+class TopographyStore;
+
+/**
+ * Write all shapes of the #TopographyStore into a preprocessed
+ * topography file (see #PackedTopography).  All shapes must have
+ * been loaded with TopographyStore::LoadAll().  This requires
+ * OpenGL, because the polygons are triangulated with the OpenGL
+ * renderer's code.
+ *
+ * @return false if the file could not be written
+ */
+bool
+WritePackedTopography(const TopographyStore &store, const char *path);
+
+#endif
@@ -23,7 +23,9 @@ Copyright_License {
 
 #include "Topography/TopographyFile.hpp"
 #include "Topography/XShape.hpp"
+#include "Topography/PackedTopography.hpp"
 #include "Projection/WindowProjection.hpp"
+#include "Util/UTF8.hpp"
 
 #include <zzip/lib.h>
 
@@ -37,13 +39,14 @@ TopographyFile::TopographyFile(struct zzip_dir *_dir, const char *filename,
                                const Color thecolor,
                                int _label_field, int _icon,
                                int _pen_width)
-  :dir(_dir), first(NULL),
+  :dir(_dir), packed_layer(NULL), first(NULL),
    label_field(_label_field), icon(_icon),
    pen_width(_pen_width),
    color(thecolor), scale_threshold(_threshold),
    label_threshold(_label_threshold),
    important_label_threshold(_important_label_threshold),
-   cache_bounds(GeoBounds::Invalid())
+   cache_bounds(GeoBounds::Invalid()),
+   has_loaded(false)
 {
   if (msShapefileOpen(&file, "rb", dir, filename, 0) == -1)
     return;
@@ -62,12 +65,71 @@ TopographyFile::TopographyFile(struct zzip_dir *_dir, const char *filename,
   ++serial;
 }
 
+/**
+ * Check the tile index of a preprocessed layer.  The shape records
+ * are checked later by CheckPackedShape(), when they are loaded.
+ */
+gcc_pure
+static bool
+CheckPackedLayer(const void *data, size_t size,
+                 const PackedTopography::Layer &layer)
+{
+  using namespace PackedTopography;
+
+  if (layer.tile_columns == 0 || layer.tile_columns > 1024 ||
+      layer.tile_rows == 0 || layer.tile_rows > 1024 ||
+      layer.bounds.west > layer.bounds.east ||
+      layer.bounds.south > layer.bounds.north)
+    return false;
+
+  const unsigned num_tiles = layer.tile_columns * layer.tile_rows;
+  if (layer.tiles_offset % sizeof(uint32_t) != 0 ||
+      !CheckRange(size, layer.tiles_offset, num_tiles + 1, sizeof(uint32_t)))
+    return false;
+
+  const uint32_t *tiles = At<uint32_t>(data, layer.tiles_offset);
+  for (unsigned i = 0; i < num_tiles; ++i)
+    if (tiles[i] > tiles[i + 1])
+      return false;
+
+  return layer.tile_shapes_offset % sizeof(uint32_t) == 0 &&
+    CheckRange(size, layer.tile_shapes_offset, tiles[num_tiles],
+               sizeof(uint32_t)) &&
+    layer.shapes_offset % sizeof(uint32_t) == 0 &&
+    CheckRange(size, layer.shapes_offset, layer.num_shapes, sizeof(Shape));
+}
+
+TopographyFile::TopographyFile(const void *data, size_t size,
+                               const PackedTopography::Layer &layer)
+  :dir(NULL), packed_layer(&layer), packed_data(data), packed_size(size),
+   first(NULL),
+   label_field(-1), icon(layer.icon), pen_width(layer.pen_width),
+   color(layer.red, layer.green, layer.blue),
+   scale_threshold(fixed(layer.scale_threshold)),
+   label_threshold(fixed(layer.label_threshold)),
+   important_label_threshold(fixed(layer.important_label_threshold)),
+   cache_bounds(GeoBounds::Invalid()),
+   has_loaded(false)
+{
+  if (layer.num_shapes == 0 || !CheckPackedLayer(data, size, layer))
+    return;
+
+  shapes.ResizeDiscard(layer.num_shapes);
+  std::fill(shapes.begin(), shapes.end(), ShapeList(NULL));
+
+  ++serial;
+}
+
 TopographyFile::~TopographyFile()
 {
   if (IsEmpty())
     return;
 
   ClearCache();
+
+  if (packed_layer != NULL)
+    return;
+
   msShapefileClose(&file);
 
   if (dir != NULL) {
@@ -82,9 +144,12 @@ TopographyFile::ClearCache()
   for (auto i = shapes.begin(), end = shapes.end(); i != end; ++i) {
     delete i->shape;
     i->shape = NULL;
+    delete i->loaded;
+    i->loaded = NULL;
   }
 
   first = NULL;
+  has_loaded = false;
 }
 
 gcc_pure
@@ -100,53 +165,240 @@ ConvertRect(const GeoBounds &br)
 }
 
 bool
-TopographyFile::Update(const WindowProjection &map_projection)
+TopographyFile::IsUpdateNeeded(fixed map_scale, const GeoBounds &area) const
 {
   if (IsEmpty())
     return false;
 
-  if (map_projection.GetMapScale() > scale_threshold)
+  if (map_scale > scale_threshold)
     /* not visible, don't update cache now */
     return false;
 
-  const GeoBounds screenRect =
-    map_projection.GetScreenBounds();
-  if (cache_bounds.IsValid() && cache_bounds.IsInside(screenRect))
-    /* the cache is still fresh */
-    return false;
+  /* is the cache still fresh? */
+  return !cache_bounds.IsValid() || !cache_bounds.IsInside(area);
+}
 
-  cache_bounds = map_projection.GetScreenBounds().Scale(fixed(2));
+/**
+ * Check the shape record of a preprocessed layer before an #XShape
+ * gets constructed from it.  The point coordinates are not checked,
+ * to avoid touching their pages; the indices are, because a bad one
+ * would make the renderer read beyond the point array, and so is the
+ * label, because the text renderer requires valid UTF-8.
+ * TopographyStore::LoadPacked() has already verified that the file
+ * ends with a null byte, so the label is terminated.
+ */
+gcc_pure
+static bool
+CheckPackedShape(const void *data, size_t size,
+                 const PackedTopography::Shape &shape)
+{
+  using namespace PackedTopography;
+
+  if (shape.num_lines == 0 || shape.num_lines > XShape::MAX_LINES ||
+      shape.lines_offset % sizeof(uint16_t) != 0 ||
+      !CheckRange(size, shape.lines_offset, shape.num_lines,
+                  sizeof(uint16_t)) ||
+      shape.points_offset % sizeof(int32_t) != 0 ||
+      !CheckRange(size, shape.points_offset, shape.num_points,
+                  2 * sizeof(int32_t)) ||
+      shape.label_offset >= size)
+    return false;
 
-  rectObj deg_bounds = ConvertRect(cache_bounds);
+  const uint16_t *lines = At<uint16_t>(data, shape.lines_offset);
+  unsigned num_points = 0;
+  for (unsigned i = 0; i < shape.num_lines; ++i)
+    num_points += lines[i];
 
-  // Test which shapes are inside the given bounds and save the
-  // status to file.status
-  msShapefileWhichShapes(&file, dir, deg_bounds, 0);
+  if (num_points != shape.num_points)
+    return false;
 
-  // If not a single shape is inside the bounds
-  if (!file.status) {
-    // ... clear the whole buffer
-    ClearCache();
+  if (shape.label_offset != 0 &&
+      !ValidateUTF8(At<char>(data, shape.label_offset)))
     return false;
+
+  for (unsigned level = 0; level < THINNING_LEVELS; ++level) {
+    const uint32_t offset = shape.indices_offset[level];
+    if (offset == 0) {
+      /* lines with only two points don't need thinning; everything
+         else must be complete, or XShape::get_indices() would try to
+         build the indices on its own */
+      if (shape.type == MS_SHAPE_POLYGON ||
+          (shape.type == MS_SHAPE_LINE && num_points > 2))
+        return false;
+
+      continue;
+    }
+
+    const unsigned num_counts = shape.type == MS_SHAPE_LINE
+      ? shape.num_lines
+      : 1;
+    if (offset % sizeof(uint16_t) != 0 ||
+        !CheckRange(size, offset, num_counts, sizeof(uint16_t)))
+      return false;
+
+    const uint16_t *counts = At<uint16_t>(data, offset);
+    unsigned num_indices = 0;
+    for (unsigned i = 0; i < num_counts; ++i)
+      num_indices += counts[i];
+
+    if (!CheckRange(size, offset, num_counts + num_indices, sizeof(uint16_t)))
+      return false;
+
+    const uint16_t *indices = counts + num_counts;
+    for (unsigned i = 0; i < num_indices; ++i)
+      if (indices[i] >= num_points)
+        return false;
+  }
+
+  return true;
+}
+
+XShape *
+TopographyFile::LoadShape(unsigned i)
+{
+  if (packed_layer == NULL)
+    return new XShape(&file, i, label_field);
+
+  const PackedTopography::Shape &shape =
+    PackedTopography::At<PackedTopography::Shape>(packed_data,
+                                                  packed_layer->shapes_offset)[i];
+  if (!CheckPackedShape(packed_data, packed_size, shape))
+    return NULL;
+
+  return new XShape(packed_data, shape);
+}
+
+/**
+ * Convert a quantised coordinate to a tile column/row number, clipped
+ * to the grid.
+ */
+gcc_const
+static unsigned
+ToTile(int32_t value, int32_t min, int32_t max, unsigned n)
+{
+  if (value <= min)
+    return 0;
+
+  if (value >= max)
+    return n - 1;
+
+  return unsigned(((int64_t)value - min) * n / ((int64_t)max - min + 1));
+}
+
+void
+TopographyFile::FindPackedShapes(const GeoBounds &bounds)
+{
+  using namespace PackedTopography;
+
+  const Layer &layer = *packed_layer;
+
+  for (auto it = shapes.begin(), end = shapes.end(); it != end; ++it)
+    it->in_range = false;
+
+  const Bounds area = {
+    ExportAngle(bounds.GetWest()), ExportAngle(bounds.GetSouth()),
+    ExportAngle(bounds.GetEast()), ExportAngle(bounds.GetNorth()),
+  };
+
+  if (area.east < layer.bounds.west || area.west > layer.bounds.east ||
+      area.north < layer.bounds.south || area.south > layer.bounds.north)
+    return;
+
+  const unsigned column_min = ToTile(area.west, layer.bounds.west,
+                                     layer.bounds.east, layer.tile_columns);
+  const unsigned column_max = ToTile(area.east, layer.bounds.west,
+                                     layer.bounds.east, layer.tile_columns);
+  const unsigned row_min = ToTile(area.south, layer.bounds.south,
+                                  layer.bounds.north, layer.tile_rows);
+  const unsigned row_max = ToTile(area.north, layer.bounds.south,
+                                  layer.bounds.north, layer.tile_rows);
+
+  const uint32_t *tiles = At<uint32_t>(packed_data, layer.tiles_offset);
+  const uint32_t *tile_shapes = At<uint32_t>(packed_data,
+                                             layer.tile_shapes_offset);
+  const Shape *records = At<Shape>(packed_data, layer.shapes_offset);
+
+  for (unsigned row = row_min; row <= row_max; ++row) {
+    for (unsigned column = column_min; column <= column_max; ++column) {
+      const unsigned tile = row * layer.tile_columns + column;
+      for (unsigned j = tiles[tile], end = tiles[tile + 1]; j != end; ++j) {
+        const uint32_t i = tile_shapes[j];
+        if (i >= shapes.size() || shapes[i].in_range)
+          continue;
+
+        const Bounds &b = records[i].bounds;
+        if (b.east >= area.west && b.west <= area.east &&
+            b.north >= area.south && b.south <= area.north)
+          shapes[i].in_range = true;
+      }
+    }
+  }
+}
+
+void
+TopographyFile::LoadShapes(const GeoBounds &area)
+{
+  assert(!IsEmpty());
+
+  loaded_bounds = area.Scale(fixed(2));
+
+  if (packed_layer != NULL) {
+    FindPackedShapes(loaded_bounds);
+  } else {
+    // Test which shapes are inside the given bounds and save the
+    // status to file.status
+    msShapefileWhichShapes(&file, dir, ConvertRect(loaded_bounds), 0);
+
+    auto it = shapes.begin();
+    for (int i = 0; i < file.numshapes; ++i, ++it)
+      it->in_range = file.status != NULL && msGetBit(file.status, i);
   }
 
   // Iterate through the shapefile entries
+  unsigned i = 0;
+  for (auto it = shapes.begin(), end = shapes.end(); it != end; ++it, ++i) {
+    if (it->in_range) {
+      if (it->shape == NULL && it->loaded == NULL)
+        // shape isn't cached yet -> load the shape
+        it->loaded = LoadShape(i);
+    } else {
+      // the shape is outside the bounds; discard it if it was loaded
+      // by a previous call which was not published
+      delete it->loaded;
+      it->loaded = NULL;
+    }
+  }
+
+  has_loaded = true;
+}
+
+bool
+TopographyFile::PublishShapes()
+{
+  if (!has_loaded)
+    return false;
+
+  has_loaded = false;
+  cache_bounds = loaded_bounds;
+
   const ShapeList **current = &first;
-  auto it = shapes.begin();
-  for (int i = 0; i < file.numshapes; ++i, ++it) {
-    if (!msGetBit(file.status, i)) {
+  for (auto it = shapes.begin(), end = shapes.end(); it != end; ++it) {
+    if (!it->in_range) {
       // If the shape is outside the bounds
       // delete the shape from the cache
       delete it->shape;
       it->shape = NULL;
     } else {
-      // is inside the bounds
-      if (it->shape == NULL)
-        // shape isn't cached yet -> cache the shape
-        it->shape = new XShape(&file, i, label_field);
-      // update list pointer
-      *current = it;
-      current = &it->next;
+      if (it->shape == NULL) {
+        it->shape = it->loaded;
+        it->loaded = NULL;
+      }
+
+      if (it->shape != NULL) {
+        // update list pointer
+        *current = it;
+        current = &it->next;
+      }
     }
   }
   // end of list marker
@@ -156,19 +408,33 @@ TopographyFile::Update(const WindowProjection &map_projection)
   return true;
 }
 
+bool
+TopographyFile::Update(const WindowProjection &map_projection)
+{
+  const GeoBounds &screen_bounds = map_projection.GetScreenBounds();
+  if (!IsUpdateNeeded(map_projection.GetMapScale(), screen_bounds))
+    return false;
+
+  LoadShapes(screen_bounds);
+  return PublishShapes();
+}
+
 void
 TopographyFile::LoadAll()
 {
   // Iterate through the shapefile entries
   const ShapeList **current = &first;
-  auto it = shapes.begin();
-  for (int i = 0; i < file.numshapes; ++i, ++it) {
+  unsigned i = 0;
+  for (auto it = shapes.begin(), end = shapes.end(); it != end; ++it, ++i) {
     if (it->shape == NULL)
       // shape isn't cached yet -> cache the shape
-      it->shape = new XShape(&file, i, label_field);
-    // update list pointer
-    *current = it;
-    current = &it->next;
+      it->shape = LoadShape(i);
+
+    if (it->shape != NULL) {
+      // update list pointer
+      *current = it;
+      current = &it->next;
+    }
   }
   // end of list marker
   *current = NULL;
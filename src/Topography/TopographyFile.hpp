@@ -34,6 +34,7 @@ Copyright_License {
 #include "Screen/Color.hpp"
 
 #include <assert.h>
+#include <stddef.h>
 
 struct GeoPoint;
 class Canvas;
@@ -43,18 +44,34 @@ struct MapSettings;
 class XShape;
 struct zzip_dir;
 
+namespace PackedTopography {
+  struct Layer;
+}
+
 class TopographyFile : private NonCopyable {
   struct ShapeList {
     const ShapeList *next;
 
     const XShape *shape;
 
+    /**
+     * A shape which was loaded by LoadShapes(), but which has not yet
+     * been published by PublishShapes().
+     */
+    const XShape *loaded;
+
+    /**
+     * Is this shape inside the bounds of the last LoadShapes() call?
+     */
+    bool in_range;
+
     ShapeList() {}
-    ShapeList(const XShape *_shape):shape(_shape) {}
+    ShapeList(const XShape *_shape)
+      :shape(_shape), loaded(NULL), in_range(false) {}
   };
 
   /**
-   * This gets incremented by Update().
+   * This gets incremented by PublishShapes().
    */
   Serial serial;
 
@@ -62,6 +79,20 @@ class TopographyFile : private NonCopyable {
 
   shapefileObj file;
 
+  /**
+   * If this file was loaded from a preprocessed topography file (see
+   * #PackedTopography), then this points to its layer description,
+   * and #file is not used.
+   */
+  const PackedTopography::Layer *packed_layer;
+
+  /**
+   * The memory mapped preprocessed topography file.  Only valid if
+   * #packed_layer is set.
+   */
+  const void *packed_data;
+  size_t packed_size;
+
   AllocatedArray<ShapeList> shapes;
   const ShapeList *first;
 
@@ -94,6 +125,17 @@ class TopographyFile : private NonCopyable {
    */
   GeoBounds cache_bounds;
 
+  /**
+   * The scope of the shapes loaded by LoadShapes().  It becomes the
+   * new #cache_bounds in PublishShapes().
+   */
+  GeoBounds loaded_bounds;
+
+  /**
+   * Has LoadShapes() been called after the last PublishShapes() call?
+   */
+  bool has_loaded;
+
 public:
   class const_iterator {
     friend class TopographyFile;
@@ -153,6 +195,13 @@ public:
                  int label_field=-1, int icon=0,
                  int pen_width=1);
 
+  /**
+   * Construct a layer of a preprocessed topography file.  The memory
+   * must remain valid until this object is destructed.
+   */
+  TopographyFile(const void *data, size_t size,
+                 const PackedTopography::Layer &layer);
+
   /**
    * The destructor clears the cache and closes the shapefile
    */
@@ -190,6 +239,18 @@ public:
     return pen_width;
   }
 
+  fixed GetScaleThreshold() const {
+    return scale_threshold;
+  }
+
+  fixed GetLabelThreshold() const {
+    return label_threshold;
+  }
+
+  fixed GetImportantLabelThreshold() const {
+    return important_label_threshold;
+  }
+
   const_iterator begin() const {
     return const_iterator(first);
   }
@@ -216,6 +277,33 @@ public:
 #endif
 
   /**
+   * Does the shape cache need to be updated so it covers the given
+   * area?
+   */
+  gcc_pure
+  bool IsUpdateNeeded(fixed map_scale, const GeoBounds &area) const;
+
+  /**
+   * Read the shapes around the given area from the shapefile, without
+   * modifying the shape list visible to the renderer.  This may be
+   * called in a background thread, as long as PublishShapes() and
+   * Update() are not called concurrently.
+   */
+  void LoadShapes(const GeoBounds &area);
+
+  /**
+   * Replace the shape list with the shapes read by the last
+   * LoadShapes() call, and free the ones which are out of range now.
+   * This must be called in the thread which renders the shapes.
+   *
+   * @return true if the shape list has been modified
+   */
+  bool PublishShapes();
+
+  /**
+   * Synchronously load and publish the shapes around the visible
+   * screen.
+   *
    * @return true if new data from the topography file has been loaded
    */
   bool Update(const WindowProjection &map_projection);
@@ -227,6 +315,19 @@ public:
 
 protected:
   void ClearCache();
+
+private:
+  /**
+   * Set ShapeList::in_range for all shapes of the preprocessed file
+   * which overlap the given bounds, using its tile index.
+   */
+  void FindPackedShapes(const GeoBounds &bounds);
+
+  /**
+   * Create the XShape object for the specified shape.  May return
+   * NULL if the shape is malformed.
+   */
+  XShape *LoadShape(unsigned i);
 };
 
 #endif
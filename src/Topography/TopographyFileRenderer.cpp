@@ -36,6 +36,12 @@ Copyright_License {
 #include "Util/AllocatedArray.hpp"
 #include "Geo/GeoClip.hpp"
 
+#ifdef ENABLE_OPENGL
+#include "Screen/OpenGL/Globals.hpp"
+#include "Projection/ShapeProjection.hpp"
+#include "Screen/OpenGL/Buffer.hpp"
+#endif
+
 #include <algorithm>
 
 TopographyFileRenderer::TopographyFileRenderer(const TopographyFile &_file)
@@ -76,6 +82,56 @@ TopographyFileRenderer::UpdateVisibleShapes(const WindowProjection &projection)
 
 #ifdef ENABLE_OPENGL
 
+/**
+ * Set up the vertex pointer for the shape's points.  If possible,
+ * they are drawn from a vertex buffer object, which is uploaded only
+ * once, instead of being copied from client memory each frame.
+ */
+static void
+SetVertexPointer(const XShape &shape)
+{
+  const GLvoid *pointer;
+  if (OpenGL::vertex_buffer_object) {
+    shape.GetPointBuffer().Bind();
+    pointer = NULL;
+  } else
+    pointer = &shape.get_points()[0].x;
+
+#ifdef HAVE_GLES
+  glVertexPointer(2, GL_FIXED, 0, pointer);
+#else
+  glVertexPointer(2, GL_INT, 0, pointer);
+#endif
+}
+
+/**
+ * Prepare drawing the specified indices of the shape.  Returns the
+ * pointer to be passed to glDrawElements(), which is an offset into
+ * the element array buffer object if one is used.
+ */
+static const GLushort *
+BindIndices(const XShape &shape, unsigned level, const GLushort *indices)
+{
+  if (!OpenGL::vertex_buffer_object)
+    return indices;
+
+  shape.GetIndexBuffer(level).Bind(GL_ELEMENT_ARRAY_BUFFER);
+  return NULL;
+}
+
+/**
+ * Unbind the buffer objects bound by SetVertexPointer() and
+ * BindIndices(), because other code passes client memory pointers.
+ */
+static void
+UnbindBuffers()
+{
+  if (OpenGL::vertex_buffer_object) {
+    GLArrayBuffer::Unbind();
+    GLBuffer::Unbind(GL_ELEMENT_ARRAY_BUFFER);
+  }
+}
+
 void
 TopographyFileRenderer::PaintPoint(Canvas &canvas,
                                    const WindowProjection &projection,
@@ -166,28 +222,11 @@ TopographyFileRenderer::Paint(Canvas &canvas,
 #endif
 
   glPushMatrix();
-  fixed angle = projection.GetScreenAngle().Degrees();
-  fixed scale = projection.GetScale();
-  const RasterPoint &screen_origin = projection.GetScreenOrigin();
-#ifdef HAVE_GLES
-#ifdef FIXED_MATH
-  GLfixed fixed_angle = angle.as_glfixed();
-  GLfixed fixed_scale = scale.as_glfixed_scale();
-#else
-  GLfixed fixed_angle = angle * (1<<16);
-  GLfixed fixed_scale = scale * (1LL<<32);
-#endif
-  glTranslatex((int)screen_origin.x << 16, (int)screen_origin.y << 16, 0);
-  glRotatex(fixed_angle, 0, 0, -(1<<16));
-  glScalex(fixed_scale, fixed_scale, 1<<16);
-#else
-  glTranslatef(screen_origin.x, screen_origin.y, 0.);
-  glRotatef((GLfloat)angle, 0., 0., -1.);
-  glScalef((GLfloat)scale, (GLfloat)scale, 1.);
-#endif
+  ApplyShapeProjection(projection);
 #else // !ENABLE_OPENGL
   const GeoClip clip(projection.GetScreenBounds().Scale(fixed(1.1)));
   AllocatedArray<GeoPoint> geo_points;
+  AllocatedArray<RasterPoint> screen_points;
 
   int iskip = file.GetSkipSteps(map_scale);
 #endif
@@ -200,16 +239,10 @@ TopographyFileRenderer::Paint(Canvas &canvas,
       continue;
 
 #ifdef ENABLE_OPENGL
-    const ShapePoint *points = shape.get_points();
-
     const ShapePoint translation =
       shape.shape_translation(projection.GetGeoLocation());
     glPushMatrix();
-#ifdef HAVE_GLES
-    glTranslatex(translation.x, translation.y, 0);
-#else
-    glTranslatef(translation.x, translation.y, 0.);
-#endif
+    ApplyShapeTranslation(translation);
 #else // !ENABLE_OPENGL
     const unsigned short *lines = shape.get_lines();
     const unsigned short *end_lines = lines + shape.get_number_of_lines();
@@ -235,11 +268,7 @@ TopographyFileRenderer::Paint(Canvas &canvas,
     case MS_SHAPE_LINE:
       {
 #ifdef ENABLE_OPENGL
-#ifdef HAVE_GLES
-        glVertexPointer(2, GL_FIXED, 0, &points[0].x);
-#else
-        glVertexPointer(2, GL_INT, 0, &points[0].x);
-#endif
+        SetVertexPointer(shape);
 
         const GLushort *indices, *count;
         if (level == 0 ||
@@ -249,21 +278,29 @@ TopographyFileRenderer::Paint(Canvas &canvas,
           for (int offset = 0; count < end_count; offset += *count++)
             glDrawArrays(GL_LINE_STRIP, offset, *count);
         } else {
+          indices = BindIndices(shape, level, indices);
           const GLushort *end_count = count + shape.get_number_of_lines();
           for (; count < end_count; indices += *count++)
             glDrawElements(GL_LINE_STRIP, *count, GL_UNSIGNED_SHORT, indices);
         }
+
+        UnbindBuffers();
 #else // !ENABLE_OPENGL
       for (; lines < end_lines; ++lines) {
         unsigned msize = *lines;
         shape_renderer.Begin(msize);
 
-        const GeoPoint *end = points + msize - 1;
-        for (; points < end; ++points)
-          shape_renderer.AddPointIfDistant(projection.GeoToScreen(*points));
+        screen_points.GrowDiscard(msize);
+        projection.GeoToScreen(points, screen_points.begin(), msize);
+        points += msize - 1;
+
+        const RasterPoint *pt = screen_points.begin();
+        const RasterPoint *end = pt + msize - 1;
+        for (; pt < end; ++pt)
+          shape_renderer.AddPointIfDistant(*pt);
 
         // make sure we always draw the last point
-        shape_renderer.AddPoint(projection.GeoToScreen(*points));
+        shape_renderer.AddPoint(*pt);
 
         shape_renderer.FinishPolyline(canvas);
       }
@@ -278,13 +315,11 @@ TopographyFileRenderer::Paint(Canvas &canvas,
         const GLushort *triangles = shape.get_indices(level, min_distance,
                                                         index_count);
 
-#ifdef HAVE_GLES
-        glVertexPointer(2, GL_FIXED, 0, &points[0].x);
-#else
-        glVertexPointer(2, GL_INT, 0, &points[0].x);
-#endif
+        SetVertexPointer(shape);
+        triangles = BindIndices(shape, level, triangles);
         glDrawElements(GL_TRIANGLE_STRIP, *index_count, GL_UNSIGNED_SHORT,
                        triangles);
+        UnbindBuffers();
       }
 #else // !ENABLE_OPENGL
       for (; lines < end_lines; ++lines) {
@@ -306,10 +341,12 @@ TopographyFileRenderer::Paint(Canvas &canvas,
 
         shape_renderer.Begin(msize);
 
-        for (unsigned i = 0; i < msize; ++i) {
-          GeoPoint g = geo_points[i];
-          shape_renderer.AddPointIfDistant(projection.GeoToScreen(g));
-        }
+        screen_points.GrowDiscard(msize);
+        projection.GeoToScreen(geo_points.begin(), screen_points.begin(),
+                               msize);
+
+        for (unsigned i = 0; i < msize; ++i)
+          shape_renderer.AddPointIfDistant(screen_points[i]);
 
         shape_renderer.FinishPolygon(canvas);
       }
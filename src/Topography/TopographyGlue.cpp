@@ -29,6 +29,8 @@ Copyright_License {
 #include "Operation/Operation.hpp"
 #include "IO/ZipLineReader.hpp"
 #include "Util/ConvertString.hpp"
+#include "OS/PathName.hpp"
+#include "OS/FileUtil.hpp"
 
 #include <zzip/zzip.h>
 
@@ -63,6 +65,31 @@ LoadConfiguredTopographyZip(TopographyStore &store,
   return true;
 }
 
+/**
+ * Load the preprocessed topography file which was generated by
+ * tools/PackTopography.cpp from the map file; it has the same name,
+ * but the extension ".xtp" instead of ".xcm".
+ */
+static bool
+LoadConfiguredTopographyPacked(TopographyStore &store)
+{
+  TCHAR path[MAX_PATH];
+  if (!Profile::GetPath(ProfileKeys::MapFile, path) ||
+      !MatchesExtension(path, _T(".xcm")))
+    return false;
+
+  _tcscpy(path + _tcslen(path) - 4, _T(".xtp"));
+  if (!File::Exists(path))
+    return false;
+
+  if (!store.LoadPacked(path)) {
+    LogStartUp(_T("Failed to load preprocessed topography: %s"), path);
+    return false;
+  }
+
+  return true;
+}
+
 bool
 LoadConfiguredTopography(TopographyStore &store,
                          OperationEnvironment &operation)
@@ -70,5 +97,6 @@ LoadConfiguredTopography(TopographyStore &store,
   LogFormat("Loading Topography File...");
   operation.SetText(_("Loading Topography File..."));
 
-  return LoadConfiguredTopographyZip(store, operation);
+  return LoadConfiguredTopographyPacked(store) ||
+    LoadConfiguredTopographyZip(store, operation);
 }
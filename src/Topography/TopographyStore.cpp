@@ -23,6 +23,8 @@ Copyright_License {
 
 #include "Topography/TopographyStore.hpp"
 #include "Topography/TopographyFile.hpp"
+#include "Topography/PackedTopography.hpp"
+#include "OS/FileMapping.hpp"
 #include "Util/StringUtil.hpp"
 #include "Util/ConvertString.hpp"
 #include "IO/LineReader.hpp"
@@ -61,6 +63,41 @@ TopographyStore::ScanVisibility(const WindowProjection &m_projection,
     }
   }
 
+  if (num_updated > 0)
+    ++serial;
+
+  return num_updated;
+}
+
+bool
+TopographyStore::IsUpdateNeeded(fixed map_scale, const GeoBounds &area) const
+{
+  for (auto it = files.begin(), end = files.end(); it != end; ++it)
+    if ((*it)->IsUpdateNeeded(map_scale, area))
+      return true;
+
+  return false;
+}
+
+void
+TopographyStore::LoadShapes(fixed map_scale, const GeoBounds &area)
+{
+  for (auto it = files.begin(), end = files.end(); it != end; ++it)
+    if ((*it)->IsUpdateNeeded(map_scale, area))
+      (*it)->LoadShapes(area);
+}
+
+unsigned
+TopographyStore::PublishShapes()
+{
+  unsigned num_updated = 0;
+  for (auto it = files.begin(), end = files.end(); it != end; ++it)
+    if ((*it)->PublishShapes())
+      ++num_updated;
+
+  if (num_updated > 0)
+    ++serial;
+
   return num_updated;
 }
 
@@ -69,6 +106,8 @@ TopographyStore::LoadAll()
 {
   for (const auto &i : files)
     i->LoadAll();
+
+  ++serial;
 }
 
 TopographyStore::~TopographyStore()
@@ -208,4 +247,50 @@ TopographyStore::Reset()
     delete *it;
 
   files.clear();
+
+  delete packed;
+  packed = NULL;
+
+  ++serial;
+}
+
+bool
+TopographyStore::LoadPacked(const TCHAR *path)
+{
+  using namespace PackedTopography;
+
+  Reset();
+
+  FileMapping *mapping = new FileMapping(path);
+  if (mapping->error()) {
+    delete mapping;
+    return false;
+  }
+
+  const void *data = mapping->data();
+  const size_t size = mapping->size();
+  const Header &header = *At<Header>(data, 0);
+  if (size < sizeof(header) || header.magic != MAGIC ||
+      header.version != VERSION ||
+      header.layers_offset % sizeof(uint32_t) != 0 ||
+      !CheckRange(size, header.layers_offset, header.num_layers,
+                  sizeof(Layer)) ||
+      /* all strings must be terminated within the file */
+      *At<char>(data, size - 1) != 0) {
+    delete mapping;
+    return false;
+  }
+
+  packed = mapping;
+
+  const Layer *layers = At<Layer>(data, header.layers_offset);
+  for (unsigned i = 0; i < header.num_layers && !files.full(); ++i) {
+    TopographyFile *file = new TopographyFile(data, size, layers[i]);
+    if (file->IsEmpty())
+      delete file;
+    else
+      files.append(file);
+  }
+
+  return true;
 }
@@ -26,13 +26,18 @@ Copyright_License {
 
 #include "Util/NonCopyable.hpp"
 #include "Util/StaticArray.hpp"
+#include "Util/Serial.hpp"
+#include "Math/fixed.hpp"
+#include "Compiler.h"
 
 #include <tchar.h>
 
 class WindowProjection;
+class GeoBounds;
 class TopographyFile;
 class NLineReader;
 class OperationEnvironment;
+class FileMapping;
 struct zzip_dir;
 
 /**
@@ -48,7 +53,19 @@ public:
 private:
   StaticArray<TopographyFile *, MAXTOPOGRAPHY> files;
 
+  /**
+   * The preprocessed topography file loaded by LoadPacked(), or NULL.
+   * The #TopographyFile objects point into it.
+   */
+  FileMapping *packed;
+
+  /**
+   * Incremented whenever the shapes of any file change.
+   */
+  Serial serial;
+
 public:
+  TopographyStore():packed(NULL) {}
   ~TopographyStore();
 
   unsigned size() const {
@@ -59,6 +76,10 @@ public:
     return *files[i];
   }
 
+  const Serial &GetSerial() const {
+    return serial;
+  }
+
   /**
    * @param max_update the maximum number of files updated in this
    * call
@@ -67,6 +88,31 @@ public:
   unsigned ScanVisibility(const WindowProjection &m_projection,
                           unsigned max_update=1024);
 
+  /**
+   * Does any of the visible files need new shapes to cover the given
+   * area?
+   */
+  gcc_pure
+  bool IsUpdateNeeded(fixed map_scale, const GeoBounds &area) const;
+
+  /**
+   * Load the shapes around the given area into all files which need
+   * an update.  This is the expensive part of ScanVisibility(), and
+   * may be called in a background thread.  The result becomes visible
+   * with PublishShapes().
+   *
+   * @see TopographyFile::LoadShapes()
+   */
+  void LoadShapes(fixed map_scale, const GeoBounds &area);
+
+  /**
+   * Publish the shapes loaded by LoadShapes().  Must be called in the
+   * thread which renders the topography.
+   *
+   * @return the number of files which were updated
+   */
+  unsigned PublishShapes();
+
   /**
    * Load all shapes of all files into memory.  For debugging
    * purposes.
@@ -75,6 +121,14 @@ public:
 
   void Load(OperationEnvironment &operation, NLineReader &reader,
             const TCHAR *directory, struct zzip_dir *zdir = NULL);
+
+  /**
+   * Map a preprocessed topography file (see #PackedTopography) into
+   * memory and load its layers.
+   *
+   * @return false if the file could not be loaded
+   */
+  bool LoadPacked(const TCHAR *path);
   void Reset();
 };
 
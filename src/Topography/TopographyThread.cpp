@@ -0,0 +1,88 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Topography/TopographyThread.hpp"
+#include "Topography/TopographyStore.hpp"
+
+TopographyThread::TopographyThread(TopographyStore &_store,
+                                   const Callback &_callback)
+  :store(_store), callback(_callback), ready(false) {}
+
+TopographyThread::~TopographyThread()
+{
+  ScopeLock protect(mutex);
+  StandbyThread::Stop();
+}
+
+void
+TopographyThread::Trigger(fixed map_scale, const GeoBounds &area)
+{
+  ScopeLock protect(mutex);
+
+  if (IsBusy() || ready)
+    /* wait until the previous job has been published; this
+       guarantees that the thread never touches a TopographyFile
+       while the renderer modifies it */
+    return;
+
+  if (!store.IsUpdateNeeded(map_scale, area))
+    return;
+
+  next_map_scale = map_scale;
+  next_area = area;
+  StandbyThread::Trigger();
+}
+
+unsigned
+TopographyThread::Publish()
+{
+  ScopeLock protect(mutex);
+
+  if (!ready)
+    return 0;
+
+  assert(!IsBusy());
+
+  ready = false;
+  return store.PublishShapes();
+}
+
+void
+TopographyThread::Tick()
+{
+  const fixed map_scale = next_map_scale;
+  const GeoBounds area = next_area;
+
+  mutex.Unlock();
+  store.LoadShapes(map_scale, area);
+  mutex.Lock();
+
+  ready = true;
+  SendNotification();
+}
+
+void
+TopographyThread::OnNotification()
+{
+  callback();
+}
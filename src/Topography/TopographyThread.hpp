@@ -0,0 +1,101 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TOPOGRAPHY_THREAD_HPP
+#define XCSOAR_TOPOGRAPHY_THREAD_HPP
+
+#include "Thread/StandbyThread.hpp"
+#include "Event/Notify.hpp"
+#include "Geo/GeoBounds.hpp"
+#include "Math/fixed.hpp"
+
+#include <functional>
+
+class TopographyStore;
+
+/**
+ * A thread which reads the shapes of a #TopographyStore in
+ * background, so the thread which draws the map never blocks on
+ * shapefile I/O.  New shapes are published to the renderer by
+ * Publish(), which is cheap.
+ */
+class TopographyThread gcc_final
+  : private StandbyThread, private Notify {
+public:
+  typedef std::function<void()> Callback;
+
+private:
+  TopographyStore &store;
+
+  /**
+   * This function gets called in the main thread after new shapes
+   * have been loaded and are ready for Publish().
+   */
+  const Callback callback;
+
+  /**
+   * The parameters of the next LoadShapes() call.  Protected by
+   * StandbyThread::mutex.
+   */
+  fixed next_map_scale;
+  GeoBounds next_area;
+
+  /**
+   * Has the thread finished loading shapes which have not been
+   * published yet?  While this flag is set, the thread will not be
+   * triggered again.  Protected by StandbyThread::mutex.
+   */
+  bool ready;
+
+public:
+  TopographyThread(TopographyStore &_store, const Callback &_callback);
+
+  /**
+   * Stops the thread.  Shapes which were not published yet are freed
+   * by the #TopographyStore.
+   */
+  ~TopographyThread();
+
+  /**
+   * Start loading the shapes which are needed to cover the given
+   * area, unless the thread is busy or the shapes are already there.
+   */
+  void Trigger(fixed map_scale, const GeoBounds &area);
+
+  /**
+   * Make the shapes loaded by the thread visible to the renderer.
+   * Must be called in the thread which draws the topography.
+   *
+   * @return the number of files which were updated
+   */
+  unsigned Publish();
+
+private:
+  /* virtual methods from class StandbyThread */
+  virtual void Tick() gcc_override;
+
+  /* virtual methods from class Notify */
+  virtual void OnNotification() gcc_override;
+};
+
+#endif
@@ -22,12 +22,14 @@ Copyright_License {
 */
 
 #include "Topography/XShape.hpp"
+#include "Topography/PackedTopography.hpp"
 #include "Util/UTF8.hpp"
 #include "shapelib/mapserver.h"
+#include "Geo/Math.hpp"
 #ifdef ENABLE_OPENGL
-#include "Projection/Projection.hpp"
+#include "Projection/ShapeProjection.hpp"
 #include "Screen/OpenGL/Triangulate.hpp"
-#include "Geo/Math.hpp"
+#include "Screen/OpenGL/Buffer.hpp"
 #endif
 
 #include <algorithm>
@@ -89,11 +91,15 @@ min_points_for_type(int shapelib_type)
 }
 
 XShape::XShape(shapefileObj *shpfile, int i, int label_field)
-  :label(NULL)
+  :packed(false), label(NULL)
 {
 #ifdef ENABLE_OPENGL
-  for (unsigned l=0; l < THINNING_LEVELS; l++)
+  for (unsigned l=0; l < THINNING_LEVELS; l++) {
     index_count[l] = indices[l] = NULL;
+    index_buffer[l] = NULL;
+  }
+
+  point_buffer = NULL;
 #endif
 
   shapeObj shape;
@@ -146,13 +152,13 @@ XShape::XShape(shapefileObj *shpfile, int i, int label_field)
    * center of the shape and the shape has a big vertical size.
    */
 
-  points = new ShapePoint[num_points];
-  ShapePoint *p = points;
+  ShapePoint *p = new ShapePoint[num_points];
+  points = p;
 #else // !ENABLE_OPENGL
   /* convert all points of all lines to GeoPoints */
 
-  points = new GeoPoint[num_points];
-  GeoPoint *p = points;
+  GeoPoint *p = new GeoPoint[num_points];
+  points = p;
 #endif
   for (unsigned l = 0; l < num_lines; ++l) {
     const pointObj *src = shape.line[l].point;
@@ -175,14 +181,94 @@ XShape::XShape(shapefileObj *shpfile, int i, int label_field)
   msFreeShape(&shape);
 }
 
+XShape::XShape(const void *data, const PackedTopography::Shape &shape)
+  :packed(true), label(NULL)
+{
+  using namespace PackedTopography;
+
+  bounds = ImportBounds(shape.bounds);
+
+  type = shape.type;
+
+  assert(shape.num_lines <= MAX_LINES);
+  num_lines = shape.num_lines;
+  std::copy_n(At<uint16_t>(data, shape.lines_offset), num_lines, lines);
+
+#ifdef ENABLE_OPENGL
+  static_assert(sizeof(ShapePoint) == 2 * sizeof(int32_t),
+                "ShapePoint does not match the file format");
+
+  center = ImportPoint(shape.center);
+
+  /* render directly from the file mapping */
+  points = At<ShapePoint>(data, shape.points_offset);
+
+  point_buffer = NULL;
+  for (unsigned l = 0; l < THINNING_LEVELS; l++) {
+    index_buffer[l] = NULL;
+
+    if (shape.indices_offset[l] == 0) {
+      index_count[l] = indices[l] = NULL;
+      continue;
+    }
+
+    /* the indices are never modified, so casting away the "const" is
+       safe */
+    index_count[l] = const_cast<unsigned short *>
+      (At<uint16_t>(data, shape.indices_offset[l]));
+    indices[l] = index_count[l] + (type == MS_SHAPE_LINE ? num_lines : 1);
+  }
+#else // !ENABLE_OPENGL
+  /* the points are stored in the metric coordinates of the OpenGL
+     renderer; convert them back to GeoPoints */
+
+  const GeoPoint center = ImportPoint(shape.center);
+  const int32_t *src = At<int32_t>(data, shape.points_offset);
+
+  GeoPoint *p = new GeoPoint[shape.num_points];
+  points = p;
+  for (unsigned i = 0; i < shape.num_points; ++i, src += 2) {
+    GeoPoint point;
+    point.latitude = center.latitude - EarthDistanceToAngle(fixed(src[1]));
+    point.longitude = center.longitude +
+      EarthDistanceToAngle(fixed(src[0]) * point.latitude.invfastcosine());
+    *p++ = point;
+  }
+#endif
+
+  if (shape.label_offset != 0) {
+    const char *src = At<char>(data, shape.label_offset);
+#ifdef _UNICODE
+    label = import_label(src);
+#else
+    /* the label was validated by CheckPackedShape() */
+    label = const_cast<TCHAR *>(src);
+#endif
+  }
+}
+
 XShape::~XShape()
 {
-  free(label);
-  delete[] points;
+#ifndef _UNICODE
+  if (!packed)
+#endif
+    free(label);
+
 #ifdef ENABLE_OPENGL
-  // Note: index_count and indices share one buffer
+  if (!packed) {
+    delete[] points;
+
+    // Note: index_count and indices share one buffer
+    for (int i=0; i < THINNING_LEVELS; i++)
+      delete[] index_count[i];
+  }
+
   for (int i=0; i < THINNING_LEVELS; i++)
-    delete[] index_count[i];
+    delete index_buffer[i];
+
+  delete point_buffer;
+#else
+  delete[] points;
 #endif
 }
 
@@ -264,6 +350,10 @@ XShape::get_indices(int thinning_level, unsigned min_distance,
                     const unsigned short *&count) const
 {
   if (indices[thinning_level] == NULL) {
+    if (packed)
+      /* the preprocessed file contains all indices which are needed */
+      return NULL;
+
     XShape &deconst = const_cast<XShape &>(*this);
     if (!deconst.BuildIndices(thinning_level, min_distance))
       return NULL;
@@ -273,16 +363,55 @@ XShape::get_indices(int thinning_level, unsigned min_distance,
   return indices[thinning_level];
 }
 
+GLArrayBuffer &
+XShape::GetPointBuffer() const
+{
+  if (point_buffer == NULL) {
+    unsigned num_points = 0;
+    for (unsigned i = 0; i < num_lines; i++)
+      num_points += lines[i];
+
+    XShape &deconst = const_cast<XShape &>(*this);
+    deconst.point_buffer = new GLArrayBuffer();
+    point_buffer->Load(num_points * sizeof(points[0]), points);
+  }
+
+  return *point_buffer;
+}
+
+GLBuffer &
+XShape::GetIndexBuffer(unsigned thinning_level) const
+{
+  assert(indices[thinning_level] != NULL);
+
+  if (index_buffer[thinning_level] == NULL) {
+    unsigned n;
+    if (type == MS_SHAPE_LINE) {
+      n = 0;
+      for (unsigned i = 0; i < num_lines; i++)
+        n += index_count[thinning_level][i];
+    } else
+      n = *index_count[thinning_level];
+
+    XShape &deconst = const_cast<XShape &>(*this);
+    GLBuffer *buffer = deconst.index_buffer[thinning_level] = new GLBuffer();
+    buffer->Load(GL_ELEMENT_ARRAY_BUFFER, n * sizeof(GLushort),
+                 indices[thinning_level], GL_STATIC_DRAW);
+  }
+
+  return *index_buffer[thinning_level];
+}
+
 ShapePoint
-XShape::geo_to_shape(const GeoPoint &origin, const GeoPoint &point) const
+XShape::geo_to_shape(const GeoPoint &location) const
 {
-  const GeoPoint d = point-origin;
+  return GeoToShape(center, location);
+}
 
-  ShapePoint pt;
-  pt.x = (ShapeScalar)fast_mult(point.latitude.fastcosine(),
-                                AngleToEarthDistance(d.longitude), 16);
-  pt.y = (ShapeScalar)-AngleToEarthDistance(d.latitude);
-  return pt;
+ShapePoint
+XShape::shape_translation(const GeoPoint &screen_center) const
+{
+  return GeoToShape(screen_center, center);
 }
 
 #endif // ENABLE_OPENGL
@@ -38,12 +38,24 @@ Copyright_License {
 #include <tchar.h>
 #include <assert.h>
 
+#ifdef ENABLE_OPENGL
+class GLBuffer;
+class GLArrayBuffer;
+#endif
+
+namespace PackedTopography {
+  struct Shape;
+}
+
 class XShape : private NonCopyable {
+public:
   enum { MAX_LINES = 32 };
 #ifdef ENABLE_OPENGL
   enum { THINNING_LEVELS = 4 };
 #endif
 
+private:
+
   GeoBounds bounds;
 #ifdef ENABLE_OPENGL
   GeoPoint center;
@@ -51,6 +63,13 @@ class XShape : private NonCopyable {
 
   unsigned char type;
 
+  /**
+   * Was this object constructed from a preprocessed topography file?
+   * Then (on OpenGL) the points, the indices and the label point into
+   * the memory mapped file, and are not owned by this object.
+   */
+  bool packed;
+
   /**
    * The number of elements in the "lines" array.
    */
@@ -67,7 +86,7 @@ class XShape : private NonCopyable {
    * All points of all lines.
    */
 #ifdef ENABLE_OPENGL
-  ShapePoint *points;
+  const ShapePoint *points;
 
   /**
    * Indices of polygon triangles or lines with reduced number of vertices.
@@ -81,14 +100,29 @@ class XShape : private NonCopyable {
    * level, which contains the number of points for each line.
    */
   unsigned short *index_count[THINNING_LEVELS];
+
+  /**
+   * Copies of #points and #indices in video memory.  They are
+   * uploaded on demand by the renderer, because they must be created
+   * in the OpenGL thread.
+   */
+  GLArrayBuffer *point_buffer;
+  GLBuffer *index_buffer[THINNING_LEVELS];
 #else // !ENABLE_OPENGL
-  GeoPoint *points;
+  const GeoPoint *points;
 #endif
 
   TCHAR *label;
 
 public:
   XShape(shapefileObj *shpfile, int i, int label_field=-1);
+
+  /**
+   * Construct a shape from a record of a preprocessed topography
+   * file.  The record must have been checked, and the memory must
+   * remain valid until this object is destructed.
+   */
+  XShape(const void *data, const PackedTopography::Shape &shape);
   ~XShape();
 
 #ifdef ENABLE_OPENGL
@@ -98,6 +132,20 @@ protected:
 public:
   const unsigned short *get_indices(int thinning_level, unsigned min_distance,
                                     const unsigned short *&count) const;
+
+  /**
+   * Returns a vertex buffer object containing all points; it is
+   * uploaded on the first call.  Must be called in the OpenGL thread.
+   */
+  GLArrayBuffer &GetPointBuffer() const;
+
+  /**
+   * Returns an element array buffer object containing the indices of
+   * the specified thinning level; it is uploaded on the first call.
+   * get_indices() must have returned a non-NULL value for this
+   * level.  Must be called in the OpenGL thread.
+   */
+  GLBuffer &GetIndexBuffer(unsigned thinning_level) const;
 #endif
 
   const GeoBounds &get_bounds() const {
@@ -138,21 +186,15 @@ public:
   /**
    * Convert a GeoPoint into a ShapePoint.
    */
-  ShapePoint geo_to_shape(const GeoPoint &location) const {
-    return geo_to_shape(center, location);
-  }
+  gcc_pure
+  ShapePoint geo_to_shape(const GeoPoint &location) const;
 
   /**
    * Get the offset of the shape center from the screen center in ShapePoint
    * scale.
    */
-  ShapePoint shape_translation(const GeoPoint &screen_center) const {
-    return geo_to_shape(screen_center, center);
-  }
-
-private:
   gcc_pure
-  ShapePoint geo_to_shape(const GeoPoint &origin, const GeoPoint &point) const;
+  ShapePoint shape_translation(const GeoPoint &screen_center) const;
 #endif
 };
 
@@ -41,6 +41,7 @@ namespace LiveTrack24
 
   static const char *GetServer();
   static bool SendRequest(const char *url);
+  static bool SendRequest(Net::Session &session, const char *url);
 }
 
 LiveTrack24::UserID
@@ -136,6 +137,22 @@ LiveTrack24::SendPosition(SessionID session, unsigned packet_id,
                           GeoPoint position, unsigned altitude,
                           unsigned ground_speed, Angle track,
                           int64_t timestamp_utc)
+{
+  // Open download session
+  Net::Session net_session;
+  if (net_session.Error())
+    return false;
+
+  return SendPosition(net_session, session, packet_id, position, altitude,
+                      ground_speed, track, timestamp_utc);
+}
+
+bool
+LiveTrack24::SendPosition(Net::Session &net_session,
+                          SessionID session, unsigned packet_id,
+                          GeoPoint position, unsigned altitude,
+                          unsigned ground_speed, Angle track,
+                          int64_t timestamp_utc)
 {
   // http://www.livetrack24.com/track.php?leolive=4&sid=42664778&pid=321&
   //   lat=22.3&lon=40.2&alt=23&sog=40&cog=160&tm=1241422845
@@ -150,7 +167,7 @@ LiveTrack24::SendPosition(SessionID session, unsigned packet_id,
              (unsigned)track.AsBearing().Degrees(),
              (long long int)timestamp_utc);
 
-  return SendRequest(url);
+  return SendRequest(net_session, url);
 }
 
 bool
@@ -185,6 +202,12 @@ LiveTrack24::SendRequest(const char *url)
   if (session.Error())
     return false;
 
+  return SendRequest(session, url);
+}
+
+bool
+LiveTrack24::SendRequest(Net::Session &session, const char *url)
+{
   // Request the file
   Net::Request request(session, url, 3000);
   if (!request.Send(10000))
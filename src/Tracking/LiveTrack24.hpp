@@ -31,6 +31,7 @@ class Angle;
 struct BrokenDateTime;
 struct GeoPoint;
 class JobRunner;
+namespace Net { class Session; }
 
 /**
  * API for the LiveTrack24.com server.
@@ -113,6 +114,18 @@ namespace LiveTrack24
                     GeoPoint position, unsigned altitude, unsigned ground_speed,
                     Angle track, int64_t timestamp_utc);
 
+  /**
+   * Sends a "gps point" packet to the tracking server, reusing an
+   * existing #Net::Session.  This saves the setup costs when sending
+   * a batch of positions.
+   *
+   * @param ground_speed Speed over ground in km/h
+   */
+  bool SendPosition(Net::Session &net_session,
+                    SessionID session, unsigned packet_id,
+                    GeoPoint position, unsigned altitude, unsigned ground_speed,
+                    Angle track, int64_t timestamp_utc);
+
   /** Sends the "end of track" packet to the tracking server */
   bool EndTracking(SessionID session, unsigned packet_id);
 
@@ -0,0 +1,106 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "LiveTrack24Queue.hpp"
+
+#include <string.h>
+
+namespace LiveTrack24
+{
+  struct QueueHeader {
+    static constexpr unsigned VERSION = 1;
+
+    unsigned version;
+
+    /** the size of one #Position; guards against mismatching builds */
+    unsigned position_size;
+
+    unsigned count;
+  };
+}
+
+unsigned
+LiveTrack24::PositionQueue::GetSize() const
+{
+  unsigned count = 0;
+  for (auto i = buffer.begin(), end = buffer.end(); i != end; ++i)
+    ++count;
+
+  return count;
+}
+
+bool
+LiveTrack24::PositionQueue::Save(FILE *file) const
+{
+  QueueHeader header;
+
+  /* zero-fill all implicit padding bytes (to make valgrind happy) */
+  memset(&header, 0, sizeof(header));
+
+  header.version = QueueHeader::VERSION;
+  header.position_size = sizeof(Position);
+  header.count = GetSize();
+
+  if (fwrite(&header, sizeof(header), 1, file) != 1)
+    return false;
+
+  for (auto i = buffer.begin(), end = buffer.end(); i != end; ++i) {
+    const Position &src = *i;
+
+    /* copy to a zero-filled buffer, so no uninitialised padding bytes
+       get written to the file */
+    Position position;
+    memset(&position, 0, sizeof(position));
+    position.timestamp = src.timestamp;
+    position.location = src.location;
+    position.altitude = src.altitude;
+    position.ground_speed = src.ground_speed;
+    position.track = src.track;
+
+    if (fwrite(&position, sizeof(position), 1, file) != 1)
+      return false;
+  }
+
+  return true;
+}
+
+bool
+LiveTrack24::PositionQueue::Load(FILE *file)
+{
+  QueueHeader header;
+  if (fread(&header, sizeof(header), 1, file) != 1 ||
+      header.version != QueueHeader::VERSION ||
+      header.position_size != sizeof(Position) ||
+      header.count > MAX_SIZE)
+    return false;
+
+  for (unsigned i = 0; i < header.count; ++i) {
+    Position position;
+    if (fread(&position, sizeof(position), 1, file) != 1)
+      return false;
+
+    Push(position);
+  }
+
+  return true;
+}
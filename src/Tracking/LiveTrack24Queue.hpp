@@ -0,0 +1,115 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_LIVETRACK24_QUEUE_HPP
+#define XCSOAR_LIVETRACK24_QUEUE_HPP
+
+#include "Geo/GeoPoint.hpp"
+#include "Util/OverwritingRingBuffer.hpp"
+
+#include <stdint.h>
+#include <stdio.h>
+
+namespace LiveTrack24
+{
+  /**
+   * One fix which shall be submitted to the tracking server.
+   */
+  struct Position {
+    /** Unix UTC time stamp */
+    int64_t timestamp;
+
+    GeoPoint location;
+
+    /** Altitude [m] */
+    unsigned altitude;
+
+    /** Speed over ground [km/h] */
+    unsigned ground_speed;
+
+    Angle track;
+  };
+
+  /**
+   * A queue of positions which have not been submitted to the
+   * tracking server yet.  When it overflows, the oldest positions are
+   * discarded.  It can be saved to a file, to submit pending
+   * positions after a restart.
+   *
+   * Not thread safe.
+   */
+  class PositionQueue {
+    static constexpr unsigned MAX_SIZE = 1024;
+
+    OverwritingRingBuffer<Position, MAX_SIZE + 1> buffer;
+
+  public:
+    bool IsEmpty() const {
+      return buffer.empty();
+    }
+
+    void Clear() {
+      buffer.clear();
+    }
+
+    gcc_pure
+    unsigned GetSize() const;
+
+    void Push(const Position &position) {
+      buffer.push(position);
+    }
+
+    /**
+     * Returns the oldest position.
+     */
+    const Position &Peek() const {
+      return buffer.peek();
+    }
+
+    /**
+     * Returns the newest position.
+     */
+    const Position &Last() const {
+      return buffer.last();
+    }
+
+    /**
+     * Removes the oldest position.
+     */
+    void Shift() {
+      buffer.shift();
+    }
+
+    /**
+     * Writes all positions to the specified file.
+     */
+    bool Save(FILE *file) const;
+
+    /**
+     * Appends the positions from a file created by Save().
+     */
+    bool Load(FILE *file);
+  };
+}
+
+#endif
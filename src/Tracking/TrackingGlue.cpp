@@ -25,8 +25,13 @@ Copyright_License {
 #include "NMEA/MoreData.hpp"
 #include "NMEA/Derived.hpp"
 #include "Units/System.hpp"
+#include "Net/Session.hpp"
+#include "LocalPath.hpp"
+#include "OS/FileUtil.hpp"
 #include "Util/Macros.hpp"
 
+#include <stdio.h>
+
 
 static LiveTrack24::VehicleType
 MapVehicleTypeToLifetrack24(TrackingSettings::VehicleType vt)
@@ -47,11 +52,18 @@ MapVehicleTypeToLifetrack24(TrackingSettings::VehicleType vt)
 
 TrackingGlue::TrackingGlue()
   :last_timestamp(0),
+   queue_saved(false),
    flying(false)
 {
   settings.SetDefaults();
   LiveTrack24::SetServer(settings.livetrack24.server);
 
+  /* pick up the positions which could not be submitted before the
+     last shutdown */
+  LocalPath(queue_path, _T("livetrack24.queue"));
+  LoadQueue();
+  queue_saved = !queue.IsEmpty();
+
 #ifdef HAVE_SKYLINES_TRACKING_HANDLER
   skylines.SetHandler(this);
 #endif
@@ -67,8 +79,14 @@ TrackingGlue::StopAsync()
 void
 TrackingGlue::WaitStopped()
 {
-  ScopeLock protect(mutex);
-  StandbyThread::WaitStopped();
+  {
+    ScopeLock protect(mutex);
+    StandbyThread::WaitStopped();
+  }
+
+  /* the thread has finished; keep the positions which have not been
+     submitted for the next start */
+  SaveQueue();
 }
 
 void
@@ -114,34 +132,135 @@ TrackingGlue::OnTimer(const MoreData &basic, const DerivedInfo &calculated)
     /* later */
     return;
 
-  ScopeLock protect(mutex);
-  if (IsBusy())
-    /* still running, skip this submission */
-    return;
-
-  date_time = basic.date_time_utc;
+  BrokenDateTime date_time = basic.date_time_utc;
   if (!basic.date_available)
     /* use "today" if the GPS didn't provide a date */
     (BrokenDate &)date_time = BrokenDate::TodayUTC();
 
-  location = basic.location;
+  LiveTrack24::Position position;
+  position.timestamp = date_time.ToUnixTimeUTC();
+  position.location = basic.location;
   /* XXX use nav_altitude? */
-  altitude = basic.NavAltitudeAvailable() && positive(basic.nav_altitude)
+  position.altitude = basic.NavAltitudeAvailable() &&
+    positive(basic.nav_altitude)
     ? (unsigned)basic.nav_altitude
     : 0u;
-  ground_speed = basic.ground_speed_available
+  position.ground_speed = basic.ground_speed_available
     ? (unsigned)Units::ToUserUnit(basic.ground_speed, Unit::KILOMETER_PER_HOUR)
     : 0u;
-  track = basic.track_available
+  position.track = basic.track_available
     ? basic.track
     : Angle::Zero();
 
-  last_flying = flying;
+  ScopeLock protect(mutex);
+
+  /* queue the position even if the thread is busy; it will be
+     submitted with the next batch */
+  if (calculated.flight.flying)
+    queue.Push(position);
+
+  if (IsBusy())
+    /* still running */
+    return;
+
   flying = calculated.flight.flying;
 
   Trigger();
 }
 
+void
+TrackingGlue::SaveQueue()
+{
+  mutex.Lock();
+  const bool empty = queue.IsEmpty();
+  mutex.Unlock();
+
+  if (empty) {
+    if (queue_saved) {
+      File::Delete(queue_path);
+      queue_saved = false;
+    }
+
+    return;
+  }
+
+  FILE *file = _tfopen(queue_path, _T("wb"));
+  if (file == NULL)
+    return;
+
+  mutex.Lock();
+  bool success = queue.Save(file);
+  mutex.Unlock();
+
+  fclose(file);
+
+  if (!success)
+    File::Delete(queue_path);
+
+  queue_saved = success;
+}
+
+void
+TrackingGlue::LoadQueue()
+{
+  FILE *file = _tfopen(queue_path, _T("rb"));
+  if (file == NULL)
+    return;
+
+  /* no locking: this is called by the constructor, before the
+     thread is started */
+  queue.Load(file);
+  fclose(file);
+}
+
+void
+TrackingGlue::SubmitQueue()
+{
+  Net::Session net_session;
+
+  while (true) {
+    mutex.Lock();
+    if (queue.IsEmpty()) {
+      mutex.Unlock();
+      break;
+    }
+
+    if (IsStopped()) {
+      /* shutting down: submit the rest after the next start */
+      mutex.Unlock();
+      SaveQueue();
+      return;
+    }
+
+    const LiveTrack24::Position position = queue.Peek();
+    mutex.Unlock();
+
+    if (net_session.Error() ||
+        !LiveTrack24::SendPosition(net_session,
+                                   state.session_id, state.packet_id,
+                                   position.location, position.altitude,
+                                   position.ground_speed, position.track,
+                                   position.timestamp)) {
+      /* the server is unreachable; keep the remaining positions on
+         disk, in case XCSoar is restarted before the next attempt */
+      SaveQueue();
+      return;
+    }
+
+    ++state.packet_id;
+
+    mutex.Lock();
+    /* the oldest position may have been discarded by an overflow
+       meanwhile */
+    if (!queue.IsEmpty() && queue.Peek().timestamp == position.timestamp)
+      queue.Shift();
+    mutex.Unlock();
+  }
+
+  /* everything was submitted: delete the file */
+  SaveQueue();
+}
+
 void
 TrackingGlue::Tick()
 {
@@ -152,10 +271,15 @@ TrackingGlue::Tick()
   unsigned tracking_interval = settings.interval;
   LiveTrack24Settings copy = this->settings.livetrack24;
 
+  const bool has_positions = !queue.IsEmpty();
+  const int64_t current_timestamp = has_positions
+    ? queue.Last().timestamp
+    : last_timestamp;
+
   mutex.Unlock();
 
-  if (!flying) {
-    if (last_flying && state.HasSession()) {
+  if (!flying && !has_positions) {
+    if (state.HasSession()) {
       /* landing: end tracking session */
       LiveTrack24::EndTracking(state.session_id, state.packet_id);
       state.ResetSession();
@@ -167,8 +291,6 @@ TrackingGlue::Tick()
     return;
   }
 
-  const int64_t current_timestamp = date_time.ToUnixTimeUTC();
-
   if (state.HasSession() && current_timestamp + 60 < last_timestamp) {
     /* time warp: create a new session */
     LiveTrack24::EndTracking(state.session_id, state.packet_id);
@@ -193,7 +315,10 @@ TrackingGlue::Tick()
     if (!LiveTrack24::StartTracking(state.session_id, copy.username,
                                     copy.password, tracking_interval,
                                     MapVehicleTypeToLifetrack24(settings.vehicleType))) {
+      /* offline: keep the queued positions on disk, as SubmitQueue()
+         does */
       state.ResetSession();
+      SaveQueue();
       mutex.Lock();
       return;
     }
@@ -201,9 +326,7 @@ TrackingGlue::Tick()
     state.packet_id = 2;
   }
 
-  LiveTrack24::SendPosition(state.session_id, state.packet_id++,
-                            location, altitude, ground_speed, track,
-                            current_timestamp);
+  SubmitQueue();
 
   mutex.Lock();
 }
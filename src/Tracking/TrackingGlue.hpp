@@ -34,9 +34,10 @@ Copyright_License {
 #include "Tracking/SkyLines/Data.hpp"
 #include "Thread/StandbyThread.hpp"
 #include "Tracking/LiveTrack24.hpp"
+#include "Tracking/LiveTrack24Queue.hpp"
 #include "Time/PeriodClock.hpp"
 #include "Geo/GeoPoint.hpp"
-#include "Time/BrokenDateTime.hpp"
+#include <windef.h> /* for MAX_PATH */
 
 struct MoreData;
 struct DerivedInfo;
@@ -79,12 +80,26 @@ class TrackingGlue gcc_final
    */
   int64_t last_timestamp;
 
-  BrokenDateTime date_time;
-  GeoPoint location;
-  unsigned altitude;
-  unsigned ground_speed;
-  Angle track;
-  bool flying, last_flying;
+  /**
+   * Positions which have not been submitted yet.  New positions are
+   * queued even while the background thread is busy; it submits all
+   * of them in one batch.  Protected by the mutex.
+   */
+  LiveTrack24::PositionQueue queue;
+
+  /**
+   * Does #queue_path exist?  Only accessed by the background
+   * thread (and by the constructor and WaitStopped()).
+   */
+  bool queue_saved;
+
+  /**
+   * The file where pending positions are saved while the server is
+   * unreachable.
+   */
+  TCHAR queue_path[MAX_PATH];
+
+  bool flying;
 
 public:
   TrackingGlue();
@@ -97,6 +112,24 @@ public:
 protected:
   virtual void Tick();
 
+private:
+  /**
+   * Submit all queued positions.  Stops at the first error, and
+   * saves the remaining positions to #queue_path.
+   *
+   * Caller must not lock the mutex.
+   */
+  void SubmitQueue();
+
+  /**
+   * Write the queue to #queue_path, or delete the file if the queue
+   * is empty.
+   *
+   * Caller must not lock the mutex.
+   */
+  void SaveQueue();
+  void LoadQueue();
+
 #ifdef HAVE_SKYLINES_TRACKING_HANDLER
 private:
   /* virtual methods from SkyLinesTracking::Handler */
@@ -303,6 +303,59 @@ protected:
 
   typedef typename Alloc::template rebind<Leaf>::other LeafAllocator;
 
+  /**
+   * The result of a k-nearest search: an array of values sorted by
+   * distance, nearest first.  When it is full, the search range
+   * shrinks to the distance of the farthest value, so buckets which
+   * cannot contribute anymore are skipped.
+   */
+  struct NearestList {
+    const Point location;
+
+    const T **const values;
+    const unsigned capacity;
+    unsigned size;
+
+    /**
+     * The maximum square distance of values which may be added.
+     */
+    distance_type square_range;
+
+    NearestList(const Point _location, distance_type _square_range,
+                const T **_values, unsigned _capacity)
+      :location(_location), values(_values), capacity(_capacity), size(0),
+       square_range(_square_range) {
+      assert(capacity > 0);
+    }
+
+    gcc_pure
+    distance_type SquareDistanceAt(unsigned i) const {
+      assert(i < size);
+
+      return QuadTree<T,Accessor,Alloc>::GetPosition(*values[i])
+        .SquareDistanceTo(location);
+    }
+
+    /**
+     * Insert a value which is within #square_range; if the list is
+     * full, the farthest value is dropped.
+     */
+    void Add(const T &value, distance_type square_distance) {
+      assert(square_distance <= square_range);
+
+      unsigned i = size < capacity ? size++ : size - 1;
+      while (i > 0 && SquareDistanceAt(i - 1) > square_distance) {
+        values[i] = values[i - 1];
+        --i;
+      }
+
+      values[i] = &value;
+
+      if (size == capacity)
+        square_range = SquareDistanceAt(size - 1);
+    }
+  };
+
   struct LeafList {
     /* a linked list of values, or nullptr if this is a splitted bucket */
     Leaf *head;
@@ -458,6 +511,15 @@ protected:
       return std::make_pair(nearest, nearest_square_distance);
     }
 
+    template<class P>
+    void FindNearestIf(NearestList &list, const P &predicate) const {
+      for (const Leaf *i = head; i != nullptr; i = i->next) {
+        distance_type square_distance = i->SquareDistanceTo(list.location);
+        if (square_distance <= list.square_range && predicate(i->value))
+          list.Add(i->value, square_distance);
+      }
+    }
+
     template<class V>
     void VisitWithinRange(const Point location, distance_type square_range,
                           V &visitor) const {
@@ -746,6 +808,18 @@ protected:
       }
     }
 
+    template<class P>
+    void FindNearestIf(const Rectangle &bounds, NearestList &list,
+                       const P &predicate) const {
+      if (!bounds.IsWithinSquareRange(list.location, list.square_range))
+        return;
+
+      if (IsSplitted())
+        children->FindNearestIf(bounds, list, predicate);
+      else
+        leaves.FindNearestIf(list, predicate);
+    }
+
     template<class V>
     void VisitWithinRange(const Rectangle &bounds,
                           const Point location, distance_type square_range,
@@ -833,54 +907,69 @@ protected:
       buckets[3].Optimise(GetBottomRight(bounds, middle), bucket_allocator);
     }
 
+    /**
+     * Calculate the bounds of all child buckets, and determine the
+     * order in which the nearest searches visit them: the one closest
+     * to the location first, because it is the most likely one to
+     * shrink the search range early.
+     */
+    static void GetNearestOrder(const Rectangle &bounds, const Point location,
+                                Rectangle child_bounds[N], unsigned order[N]) {
+      const Point middle = bounds.GetMiddle();
+      child_bounds[0] = GetTopLeft(bounds, middle);
+      child_bounds[1] = GetTopRight(bounds, middle);
+      child_bounds[2] = GetBottomLeft(bounds, middle);
+      child_bounds[3] = GetBottomRight(bounds, middle);
+
+      distance_type distances[N];
+      for (unsigned i = 0; i < N; ++i) {
+        distances[i] = child_bounds[i].SquareDistanceTo(location);
+
+        unsigned j = i;
+        for (; j > 0 && distances[order[j - 1]] > distances[i]; --j)
+          order[j] = order[j - 1];
+        order[j] = i;
+      }
+    }
+
     template<class P>
     gcc_pure
     std::pair<const_iterator, distance_type>
     FindNearestIf(const Rectangle &bounds,
                   const Point location, distance_type square_range,
                   const P &predicate) const {
-      const Point middle = bounds.GetMiddle();
-
-      auto result =
-        buckets[0].FindNearestIf(GetTopLeft(bounds, middle),
-                                 location, square_range,
-                                 predicate);
-
-      if (result.first != const_iterator()) {
-        assert(result.second <= square_range);
-        square_range = result.second;
-      }
-
-      auto tmp =
-        buckets[1].FindNearestIf(GetTopRight(bounds, middle),
-                                 location, square_range,
-                                 predicate);
-      if (tmp.second < result.second)
-        result = tmp;
-
-      if (result.first != const_iterator()) {
-        assert(result.second <= square_range);
-        square_range = result.second;
+      Rectangle child_bounds[N];
+      unsigned order[N];
+      GetNearestOrder(bounds, location, child_bounds, order);
+
+      std::pair<const_iterator, distance_type> result(const_iterator(),
+                                                      max_distance());
+
+      for (unsigned i = 0; i < N; ++i) {
+        const unsigned j = order[i];
+        const auto tmp = buckets[j].FindNearestIf(child_bounds[j],
+                                                  location, square_range,
+                                                  predicate);
+        if (tmp.second < result.second) {
+          assert(tmp.second <= square_range);
+          result = tmp;
+          square_range = result.second;
+        }
       }
 
-      tmp = buckets[2].FindNearestIf(GetBottomLeft(bounds, middle),
-                                     location, square_range,
-                                     predicate);
-      if (tmp.second < result.second)
-        result = tmp;
-
-      if (result.first != const_iterator()) {
-        assert(result.second <= square_range);
-        square_range = result.second;
-      }
+      return result;
+    }
 
-      tmp = buckets[3].FindNearestIf(GetBottomRight(bounds, middle),
-                                     location, square_range,
-                                     predicate);
-      if (tmp.second < result.second)
-        result = tmp;
+    template<class P>
+    void FindNearestIf(const Rectangle &bounds, NearestList &list,
+                       const P &predicate) const {
+      Rectangle child_bounds[N];
+      unsigned order[N];
+      GetNearestOrder(bounds, list.location, child_bounds, order);
 
-      return result;
+      for (unsigned i = 0; i < N; ++i)
+        buckets[order[i]].FindNearestIf(child_bounds[order[i]], list,
+                                        predicate);
     }
 
     template<class V>
@@ -1374,6 +1463,46 @@ public:
     return FindNearest(GetPosition(value), range);
   }
 
+  /**
+   * Find the values nearest to the location which match the
+   * predicate.
+   *
+   * @param range the maximum distance of the values
+   * @param dest an array which receives pointers to the values,
+   * sorted by distance (nearest first)
+   * @param max_results the size of the #dest array
+   * @return the number of values which were found
+   */
+  template<class P>
+  unsigned FindNearestIf(const Point location, distance_type range,
+                         const P &predicate,
+                         const T **dest, unsigned max_results) const {
+    if (max_results == 0)
+      return 0;
+
+    NearestList list(location, Square(range), dest, max_results);
+    root.FindNearestIf(bounds, list, predicate);
+    return list.size;
+  }
+
+  template<class P>
+  unsigned FindNearestIf(const T &value, distance_type range,
+                         const P &predicate,
+                         const T **dest, unsigned max_results) const {
+    return FindNearestIf(GetPosition(value), range, predicate,
+                         dest, max_results);
+  }
+
+  unsigned FindNearest(const Point location, distance_type range,
+                       const T **dest, unsigned max_results) const {
+    return FindNearestIf(location, range, AlwaysTrue(), dest, max_results);
+  }
+
+  unsigned FindNearest(const T &value, distance_type range,
+                       const T **dest, unsigned max_results) const {
+    return FindNearest(GetPosition(value), range, dest, max_results);
+  }
+
   template<class V>
   void VisitWithinRange(const Point location, distance_type range,
                         V &visitor) const {
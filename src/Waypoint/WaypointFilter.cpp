@@ -24,6 +24,7 @@ Copyright_License {
 #include "WaypointFilter.hpp"
 #include "Waypoint/Waypoint.hpp"
 #include "Engine/Task/Shapes/FAITrianglePointValidator.hpp"
+#include "Geo/GeoVector.hpp"
 
 bool
 WaypointFilter::CompareType(const Waypoint &waypoint, TypeFilter type,
@@ -95,6 +96,19 @@ WaypointFilter::CompareDirection(const Waypoint &waypoint,
   return CompareDirection(waypoint, direction, location);
 }
 
+bool
+WaypointFilter::CompareVector(const GeoVector &vector) const
+{
+  if (positive(distance) && vector.distance > distance)
+    return false;
+
+  if (negative(direction.Native()))
+    return true;
+
+  fixed direction_error = (vector.bearing - direction).AsDelta().AbsoluteDegrees();
+  return direction_error < fixed(18);
+}
+
 bool
 WaypointFilter::CompareName(const Waypoint &waypoint, const TCHAR *name)
 {
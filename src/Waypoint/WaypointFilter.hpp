@@ -33,6 +33,7 @@ Copyright_License {
 
 struct Waypoint;
 struct GeoPoint;
+struct GeoVector;
 class FAITrianglePointValidator;
 
 enum class TypeFilter: uint8_t {
@@ -72,6 +73,20 @@ struct WaypointFilter
 
   bool CompareDirection(const Waypoint &waypoint, GeoPoint location) const;
 
+  /**
+   * Are the distance or the direction filter enabled?  Then
+   * CompareVector() needs to be checked.
+   */
+  bool HasVectorFilter() const {
+    return positive(distance) || !negative(direction.Native());
+  }
+
+  /**
+   * Check the distance and the direction filter, given the vector
+   * from the reference location to the waypoint.
+   */
+  bool CompareVector(const GeoVector &vector) const;
+
   static bool CompareName(const Waypoint &waypoint, const TCHAR *name);
 
   bool CompareName(const Waypoint &waypoint) const;
@@ -47,6 +47,9 @@ public:
   explicit WaypointListItem(const Waypoint &_waypoint):
     waypoint(&_waypoint), vec(GeoVector::Invalid()) {}
 
+  WaypointListItem(const Waypoint &_waypoint, const GeoVector &_vec):
+    waypoint(&_waypoint), vec(_vec) {}
+
   void ResetVector();
   const GeoVector &GetVector(const GeoPoint &location) const;
 };
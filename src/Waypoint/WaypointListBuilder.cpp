@@ -27,13 +27,27 @@ Copyright_License {
 #include "Engine/Waypoint/Waypoints.hpp"
 
 void WaypointListBuilder::Visit(const Waypoints &waypoints) {
-  if (positive(filter.distance))
+  if (positive(filter.distance) && filter.name.empty())
     waypoints.VisitWithinRange(location, filter.distance, *this);
   else
+    /* the name prefix lookup in the RadixTree is much cheaper than
+       comparing the name of each waypoint within range; the distance
+       is checked by CompareVector() */
     waypoints.VisitNamePrefix(filter.name, *this);
 }
 
 void WaypointListBuilder::Visit(const Waypoint &waypoint) {
-  if (filter.Matches(waypoint, location, triangle_validator))
+  if (!filter.CompareType(waypoint, triangle_validator))
+    return;
+
+  if (!filter.HasVectorFilter()) {
     list.push_back(WaypointListItem(waypoint));
+    return;
+  }
+
+  /* calculate the vector only once; it is needed by the filter and
+     is kept in the list item for sorting and drawing */
+  const GeoVector vector(location, waypoint.location);
+  if (filter.CompareVector(vector))
+    list.push_back(WaypointListItem(waypoint, vector));
 }
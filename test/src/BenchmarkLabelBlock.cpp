@@ -0,0 +1,217 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Benchmark for LabelBlock: places the labels of all waypoints (and
+ * optionally of all topography shapes) on a virtual screen at
+ * several map scales, similar to what the map window does.
+ */
+
+#include "Renderer/LabelBlock.hpp"
+#include "Projection/Projection.hpp"
+#include "Waypoint/WaypointReader.hpp"
+#include "Waypoint/Waypoints.hpp"
+#include "Engine/Waypoint/WaypointVisitor.hpp"
+#include "Topography/TopographyStore.hpp"
+#include "Topography/TopographyFile.hpp"
+#include "Topography/XShape.hpp"
+#include "IO/ZipLineReader.hpp"
+#include "OS/PathName.hpp"
+#include "OS/Args.hpp"
+#include "Operation/Operation.hpp"
+#include "Screen/Layout.hpp"
+
+#include <zzip/zzip.h>
+
+#include <vector>
+#include <algorithm>
+
+#include <stdio.h>
+#include <time.h>
+#include <tchar.h>
+
+unsigned Layout::scale_1024 = 1024;
+
+static constexpr int SCREEN_WIDTH = 1024, SCREEN_HEIGHT = 768;
+
+/* rough size of a label in pixels, like WaypointRenderer draws it */
+static constexpr int LABEL_CHAR_WIDTH = 8, LABEL_HEIGHT = 14;
+
+struct Label {
+  GeoPoint location;
+  unsigned length;
+
+  Label(const GeoPoint &_location, unsigned _length)
+    :location(_location), length(_length) {}
+};
+
+static std::vector<Label> labels;
+
+class LabelCollector : public WaypointVisitor {
+public:
+  void Visit(const Waypoint &wp) {
+    labels.push_back(Label(wp.location, wp.name.length()));
+  }
+};
+
+static bool
+LoadWaypoints(const char *path)
+{
+  Waypoints way_points;
+
+  WaypointReader parser(PathName(path), 0);
+  NullOperationEnvironment operation;
+  if (parser.Error() || !parser.Parse(way_points, operation)) {
+    fprintf(stderr, "Failed to load %s\n", path);
+    return false;
+  }
+
+  way_points.Optimise();
+
+  LabelCollector collector;
+  way_points.VisitNamePrefix(_T(""), collector);
+  return true;
+}
+
+static bool
+LoadTopography(const char *path)
+{
+  ZZIP_DIR *dir = zzip_dir_open(path, NULL);
+  if (dir == NULL) {
+    fprintf(stderr, "Failed to open %s\n", path);
+    return false;
+  }
+
+  ZipLineReaderA reader(dir, "topology.tpl");
+  if (reader.error()) {
+    zzip_dir_close(dir);
+    fprintf(stderr, "Failed to open %s\n", path);
+    return false;
+  }
+
+  TopographyStore topography;
+  NullOperationEnvironment operation;
+  topography.Load(operation, reader, NULL, dir);
+  zzip_dir_close(dir);
+
+  topography.LoadAll();
+
+  for (unsigned i = 0; i < topography.size(); ++i)
+    for (const XShape &shape : topography[i])
+      if (shape.get_label() != NULL)
+        labels.push_back(Label(shape.get_bounds().GetCenter(),
+                               _tcslen(shape.get_label())));
+
+  return true;
+}
+
+/**
+ * Returns the median location of all labels, which is in a dense
+ * area even if the files contain some far-away points.
+ */
+static GeoPoint
+GetCenter()
+{
+  std::vector<Angle> longitudes, latitudes;
+  for (auto i = labels.begin(), end = labels.end(); i != end; ++i) {
+    longitudes.push_back(i->location.longitude);
+    latitudes.push_back(i->location.latitude);
+  }
+
+  const unsigned middle = labels.size() / 2;
+  std::nth_element(longitudes.begin(), longitudes.begin() + middle,
+                   longitudes.end());
+  std::nth_element(latitudes.begin(), latitudes.begin() + middle,
+                   latitudes.end());
+  return GeoPoint(longitudes[middle], latitudes[middle]);
+}
+
+static void
+Benchmark(const GeoPoint center, fixed screen_width_m, unsigned iterations)
+{
+  Projection projection;
+  projection.SetScreenOrigin(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+  projection.SetGeoLocation(center);
+  projection.SetScale(fixed(SCREEN_WIDTH) / screen_width_m);
+
+  /* project once, the benchmark is about LabelBlock only */
+  std::vector<PixelRect> rects;
+  for (auto i = labels.begin(), end = labels.end(); i != end; ++i) {
+    const RasterPoint pt = projection.GeoToScreen(i->location);
+    if (pt.x < 0 || pt.x >= SCREEN_WIDTH ||
+        pt.y < 0 || pt.y >= SCREEN_HEIGHT)
+      continue;
+
+    PixelRect rc;
+    rc.left = pt.x + 2;
+    rc.top = pt.y;
+    rc.right = rc.left + i->length * LABEL_CHAR_WIDTH;
+    rc.bottom = rc.top + LABEL_HEIGHT;
+    rects.push_back(rc);
+  }
+
+  static LabelBlock label_block;
+  unsigned accepted = 0;
+
+  const clock_t start = clock();
+  for (unsigned j = 0; j < iterations; ++j) {
+    label_block.reset();
+    accepted = 0;
+    for (auto i = rects.begin(), end = rects.end(); i != end; ++i)
+      if (label_block.check(*i))
+        ++accepted;
+  }
+
+  const double seconds = double(clock() - start) / CLOCKS_PER_SEC;
+  printf("%6.0f km: %5u labels, %5u drawn, %8.2f us/frame\n",
+         (double)screen_width_m / 1000,
+         (unsigned)rects.size(), accepted,
+         seconds * 1e6 / iterations);
+}
+
+int main(int argc, char **argv)
+{
+  Args args(argc, argv, "WAYPOINTFILE [MAPFILE]");
+  const char *waypoint_path = args.ExpectNext();
+  const char *map_path = args.IsEmpty() ? NULL : args.ExpectNext();
+  args.ExpectEnd();
+
+  if (!LoadWaypoints(waypoint_path))
+    return EXIT_FAILURE;
+
+  if (map_path != NULL && !LoadTopography(map_path))
+    return EXIT_FAILURE;
+
+  if (labels.empty()) {
+    fprintf(stderr, "No labels\n");
+    return EXIT_FAILURE;
+  }
+
+  const GeoPoint center = GetCenter();
+
+  static constexpr unsigned widths[] = { 20, 50, 100, 200, 500, 1000 };
+  for (unsigned i = 0; i < sizeof(widths) / sizeof(widths[0]); ++i)
+    Benchmark(center, fixed(widths[i] * 1000), 1000);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Benchmark for the MacCready solvers: single glide problems like in
+ * test_mc, and the iterating task solvers (auto MacCready, AAT
+ * target optimisation) on a multi-point AAT task like in
+ * test_automc.
+ */
+
+#include "Engine/GlideSolvers/GlideSettings.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Engine/GlideSolvers/GlideState.hpp"
+#include "Engine/GlideSolvers/GlideResult.hpp"
+#include "Engine/GlideSolvers/MacCready.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Engine/Task/Ordered/OrderedTaskBehaviour.hpp"
+#include "Engine/Task/Ordered/Points/StartPoint.hpp"
+#include "Engine/Task/Ordered/Points/AATPoint.hpp"
+#include "Engine/Task/Ordered/Points/FinishPoint.hpp"
+#include "Engine/Task/ObservationZones/LineSectorZone.hpp"
+#include "Engine/Task/ObservationZones/CylinderZone.hpp"
+#include "Engine/Waypoint/Waypoint.hpp"
+#include "Navigation/Aircraft.hpp"
+#include "Compiler.h"
+
+#include <stdio.h>
+
+static fixed
+BenchmarkGlide(const GlideSettings &settings, const GlidePolar &polar)
+{
+  fixed sum = fixed(0);
+
+  for (int h = -1000; h <= 1000; h += 100) {
+    for (unsigned w = 0; w <= 20; w += 5) {
+      for (unsigned angle = 0; angle < 360; angle += 15) {
+        const SpeedVector wind(Angle::Degrees(angle), fixed(w));
+        const GlideState state(GeoVector(fixed(50000), Angle::Degrees(30)),
+                               fixed(0), fixed(h), wind);
+        const GlideResult result = MacCready::Solve(settings, polar, state);
+        sum += result.time_elapsed;
+      }
+    }
+  }
+
+  return sum;
+}
+
+static Waypoint
+MakeWaypoint(double longitude, double latitude)
+{
+  Waypoint wp(GeoPoint(Angle::Degrees(longitude), Angle::Degrees(latitude)));
+  wp.elevation = fixed(200);
+  return wp;
+}
+
+static void
+BuildAATTask(OrderedTask &task, const TaskBehaviour &task_behaviour,
+             const OrderedTaskBehaviour &ordered_task_behaviour)
+{
+  static const double points[][2] = {
+    { 7.7, 51.05 }, { 8.4, 51.4 }, { 9.1, 51.2 }, { 9.5, 50.7 },
+    { 9.0, 50.3 }, { 8.3, 50.2 }, { 7.8, 50.6 },
+  };
+  static constexpr unsigned n = sizeof(points) / sizeof(points[0]);
+
+  const Waypoint start = MakeWaypoint(points[0][0], points[0][1]);
+  task.Append(StartPoint(new LineSectorZone(start.location), start,
+                         task_behaviour,
+                         ordered_task_behaviour.start_constraints));
+
+  for (unsigned i = 1; i < n; ++i) {
+    const Waypoint wp = MakeWaypoint(points[i][0], points[i][1]);
+    task.Append(AATPoint(new CylinderZone(wp.location, fixed(20000)), wp,
+                         task_behaviour));
+  }
+
+  task.Append(FinishPoint(new LineSectorZone(start.location), start,
+                          task_behaviour,
+                          ordered_task_behaviour.finish_constraints, false));
+}
+
+static fixed
+BenchmarkTask(const GlidePolar &glide_polar, unsigned iterations)
+{
+  TaskBehaviour task_behaviour;
+  task_behaviour.SetDefaults();
+  task_behaviour.auto_mc = true;
+  task_behaviour.auto_mc_mode = TaskBehaviour::AutoMCMode::FINALGLIDE;
+
+  OrderedTaskBehaviour ordered_task_behaviour;
+  ordered_task_behaviour.SetDefaults();
+  ordered_task_behaviour.aat_min_time = fixed(4 * 3600);
+
+  OrderedTask task(task_behaviour);
+  task.SetOrderedTaskBehaviour(ordered_task_behaviour);
+  BuildAATTask(task, task_behaviour, ordered_task_behaviour);
+  task.SetActiveTaskPoint(1);
+
+  if (!task.CheckTask()) {
+    fprintf(stderr, "Invalid task\n");
+    return fixed(0);
+  }
+
+  AircraftState aircraft;
+  aircraft.Reset();
+  aircraft.location = GeoPoint(Angle::Degrees(8.0), Angle::Degrees(51.2));
+  aircraft.altitude = fixed(1500);
+  aircraft.wind = SpeedVector(Angle::Degrees(240), fixed(8));
+
+  fixed sum = fixed(0);
+  for (unsigned i = 0; i < iterations; ++i) {
+    GlidePolar polar = glide_polar;
+    task.Update(aircraft, aircraft, polar);
+    task.UpdateAutoMC(polar, aircraft, fixed(1));
+    task.UpdateIdle(aircraft, polar);
+    sum += polar.GetMC();
+  }
+
+  return sum;
+}
+
+int
+main(gcc_unused int argc, gcc_unused char **argv)
+{
+  GlideSettings settings;
+  settings.SetDefaults();
+
+  GlidePolar polar(fixed(0));
+
+  fixed sum = fixed(0);
+  for (unsigned i = 0; i < 200; ++i) {
+    polar.SetMC(fixed(i % 5));
+    sum += BenchmarkGlide(settings, polar);
+  }
+
+  polar.SetMC(fixed(1.5));
+  sum += BenchmarkTask(polar, 2000);
+
+  /* print the result to prevent the compiler from optimising the
+     loops away */
+  printf("%f\n", (double)sum);
+
+  return 0;
+}
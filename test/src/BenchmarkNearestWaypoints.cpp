@@ -0,0 +1,180 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Benchmark for the k-nearest waypoint search: looks up the nearest
+ * waypoints around each waypoint of the given file (like
+ * NearestWaypoints does for each line on stdin), once with the
+ * QuadTree k-nearest search and once by emulating it with a range
+ * visit followed by sorting.
+ */
+
+#include "Waypoint/WaypointReader.hpp"
+#include "Waypoint/Waypoints.hpp"
+#include "Engine/Waypoint/WaypointVisitor.hpp"
+#include "Geo/GeoVector.hpp"
+#include "OS/PathName.hpp"
+#include "OS/Args.hpp"
+#include "Operation/Operation.hpp"
+
+#include <vector>
+#include <algorithm>
+
+#include <stdio.h>
+#include <time.h>
+
+static bool
+LoadWaypoints(const char *_path, Waypoints &waypoints)
+{
+  PathName path(_path);
+  WaypointReader parser(path, 0);
+  if (parser.Error()) {
+    fprintf(stderr, "WayPointParser::SetFile() has failed\n");
+    return false;
+  }
+
+  NullOperationEnvironment operation;
+  if (!parser.Parse(waypoints, operation)) {
+    fprintf(stderr, "WayPointParser::Parse() has failed\n");
+    return false;
+  }
+
+  waypoints.Optimise();
+  return true;
+}
+
+struct Candidate {
+  const Waypoint *waypoint;
+  fixed distance;
+
+  Candidate(const Waypoint &_waypoint, fixed _distance)
+    :waypoint(&_waypoint), distance(_distance) {}
+
+  bool operator<(const Candidate &other) const {
+    return distance < other.distance;
+  }
+};
+
+class CandidateCollector : public WaypointVisitor {
+  const GeoPoint location;
+  std::vector<Candidate> &candidates;
+
+public:
+  CandidateCollector(const GeoPoint &_location,
+                     std::vector<Candidate> &_candidates)
+    :location(_location), candidates(_candidates) {}
+
+  void Visit(const Waypoint &wp) {
+    candidates.push_back(Candidate(wp, location.Distance(wp.location)));
+  }
+};
+
+/**
+ * The old way: visit all waypoints within range, and sort them.
+ */
+static unsigned
+FindNearestSorted(const Waypoints &waypoints, const GeoPoint &location,
+                  fixed range, unsigned k)
+{
+  static std::vector<Candidate> candidates;
+  candidates.clear();
+
+  CandidateCollector collector(location, candidates);
+  waypoints.VisitWithinRange(location, range, collector);
+
+  const unsigned n = std::min((unsigned)candidates.size(), k);
+  std::partial_sort(candidates.begin(), candidates.begin() + n,
+                    candidates.end());
+  return n;
+}
+
+static unsigned
+FindNearestTree(const Waypoints &waypoints, const GeoPoint &location,
+                fixed range, unsigned k)
+{
+  const Waypoint *nearest[64];
+  return waypoints.GetNearest(location, range, nearest, k);
+}
+
+static bool
+Run(const Waypoints &waypoints, const std::vector<GeoPoint> &locations,
+    fixed range, unsigned k)
+{
+  unsigned sum_sorted = 0, sum_tree = 0;
+
+  clock_t start = clock();
+  for (const auto &location : locations)
+    sum_sorted += FindNearestSorted(waypoints, location, range, k);
+  const double seconds_sorted = double(clock() - start) / CLOCKS_PER_SEC;
+
+  start = clock();
+  for (const auto &location : locations)
+    sum_tree += FindNearestTree(waypoints, location, range, k);
+  const double seconds_tree = double(clock() - start) / CLOCKS_PER_SEC;
+
+  printf("%4.0f km, k=%2u: range+sort %8.2f us/query, "
+         "k-nearest %8.2f us/query\n",
+         (double)range / 1000, k,
+         seconds_sorted * 1e6 / locations.size(),
+         seconds_tree * 1e6 / locations.size());
+
+  if (sum_sorted != sum_tree) {
+    fprintf(stderr, "Result mismatch: %u != %u\n", sum_sorted, sum_tree);
+    return false;
+  }
+
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  Args args(argc, argv, "PATH");
+  const char *path = args.ExpectNext();
+  args.ExpectEnd();
+
+  Waypoints waypoints;
+  if (!LoadWaypoints(path, waypoints))
+    return EXIT_FAILURE;
+
+  /* query next to each waypoint, so the results are not dominated
+     by exact hits */
+  std::vector<GeoPoint> locations;
+  for (const auto &wp : waypoints)
+    locations.push_back(GeoVector(fixed(1500), Angle::Degrees(45))
+                        .EndPoint(wp.location));
+
+  if (locations.empty()) {
+    fprintf(stderr, "No waypoints\n");
+    return EXIT_FAILURE;
+  }
+
+  static constexpr unsigned ranges[] = { 20000, 100000, 300000 };
+  static constexpr unsigned ks[] = { 1, 10, 32 };
+
+  bool success = true;
+  for (unsigned range : ranges)
+    for (unsigned k : ks)
+      success &= Run(waypoints, locations, fixed(range), k);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
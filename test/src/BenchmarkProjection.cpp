@@ -21,9 +21,17 @@ Copyright_License {
 }
 */
 
+/*
+ * Benchmark for Projection::GeoToScreen(), comparing the
+ * single-point version with the batch version.
+ */
+
 #include "Projection/Projection.hpp"
 #include "Screen/Layout.hpp"
 
+#include <stdio.h>
+#include <time.h>
+
 unsigned Layout::scale_1024 = 1024;
 
 class TestProjection : public Projection {
@@ -36,20 +44,55 @@ public:
   }
 };
 
+static constexpr unsigned N_POINTS = 1024;
+static constexpr unsigned N_ITERATIONS = 64 * 1024;
+
+static GeoPoint geo_points[N_POINTS];
+static RasterPoint screen_points[N_POINTS];
+
+static long
+Checksum()
+{
+  long sum = 0;
+  for (unsigned i = 0; i < N_POINTS; ++i)
+    sum += screen_points[i].x + screen_points[i].y;
+  return sum;
+}
+
+static void
+Report(const char *name, clock_t start, long checksum)
+{
+  const double seconds = double(clock() - start) / CLOCKS_PER_SEC;
+  const double n = double(N_POINTS) * N_ITERATIONS;
+  printf("%-6s %6.3f s  %8.1f Mpoints/s  (checksum %ld)\n",
+         name, seconds, seconds > 0 ? n / seconds / 1e6 : 0., checksum);
+}
+
 int main(int argc, char **argv)
 {
   TestProjection projection;
 
-  GeoPoint gp = GeoPoint(Angle::Degrees(7.7061111111111114),
-                         Angle::Degrees(51.051944444444445));
-  long x = 0, y = 0;
-  for (unsigned i = 64 * 1024 * 1024; i-- > 0;) {
-    RasterPoint rp = projection.GeoToScreen(gp);
+  for (unsigned i = 0; i < N_POINTS; ++i)
+    geo_points[i] = GeoPoint(Angle::Degrees(7.5 + 0.0004 * i),
+                             Angle::Degrees(51.2 - 0.0003 * i));
 
-    /* prevent gcc from optimizing this loop away */
-    x += rp.x;
-    y += rp.y;
-  }
+  long result = 0;
+
+  clock_t start = clock();
+  for (unsigned j = 0; j < N_ITERATIONS; ++j)
+    for (unsigned i = 0; i < N_POINTS; ++i)
+      screen_points[i] = projection.GeoToScreen(geo_points[i]);
+  long checksum = Checksum();
+  Report("scalar", start, checksum);
+  result += checksum;
+
+  start = clock();
+  for (unsigned j = 0; j < N_ITERATIONS; ++j)
+    projection.GeoToScreen(geo_points, screen_points, N_POINTS);
+  checksum = Checksum();
+  Report("batch", start, checksum);
+  result -= checksum;
 
-  return x + y;
+  /* both versions must produce the same results */
+  return result != 0;
 }
@@ -0,0 +1,167 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Loopback benchmark for the audio vario: a fake PCM sink consumes
+ * the VarioSynthesiser output in real time, like the PCMPlayer
+ * callback does, and the latency between SetVario() and the moment
+ * the tone would become audible is measured.
+ */
+
+#include "Audio/VarioSynthesiser.hpp"
+#include "Thread/Thread.hpp"
+#include "OS/Clock.hpp"
+#include "OS/Sleep.h"
+#include "OS/Args.hpp"
+
+#include <atomic>
+#include <algorithm>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static constexpr unsigned sample_rate = 44100;
+static constexpr unsigned MAX_BUFFER_SIZE = 16384;
+
+/**
+ * Emulates an audio device with one buffer in flight: the next buffer
+ * is requested when the previous one starts playing.
+ */
+class FakePCMSink : public Thread {
+  PCMSynthesiser &synthesiser;
+  const unsigned buffer_size;
+
+  std::atomic<bool> stop;
+
+  /**
+   * The time [us] when the first audible sample since the last
+   * ResetOnset() call gets played, or 0 if there was none yet.
+   */
+  std::atomic<uint64_t> onset;
+
+public:
+  FakePCMSink(PCMSynthesiser &_synthesiser, unsigned _buffer_size)
+    :synthesiser(_synthesiser), buffer_size(_buffer_size),
+     stop(false), onset(0) {}
+
+  void Stop() {
+    stop = true;
+    Join();
+  }
+
+  void ResetOnset() {
+    onset = 0;
+  }
+
+  uint64_t GetOnset() const {
+    return onset;
+  }
+
+protected:
+  virtual void Run() {
+    static int16_t buffer[MAX_BUFFER_SIZE];
+
+    const uint64_t start = MonotonicClockUS();
+    uint64_t position = 0;
+
+    while (!stop) {
+      /* wait until the device requests the next buffer */
+      const uint64_t request = start + position * 1000000 / sample_rate;
+      const uint64_t now = MonotonicClockUS();
+      if (request > now)
+        Sleep((request - now) / 1000);
+
+      synthesiser.Synthesise(buffer, buffer_size);
+
+      /* this buffer gets played after the previous one */
+      position += buffer_size;
+      const uint64_t play = start + position * 1000000 / sample_rate;
+
+      if (onset == 0) {
+        for (unsigned i = 0; i < buffer_size; ++i) {
+          if (buffer[i] != 0) {
+            onset = play + uint64_t(i) * 1000000 / sample_rate;
+            break;
+          }
+        }
+      }
+    }
+  }
+};
+
+int
+main(int argc, char **argv)
+{
+  Args args(argc, argv, "[BUFFER_SIZE]");
+  unsigned buffer_size = 1024;
+  if (!args.IsEmpty())
+    buffer_size = strtoul(args.ExpectNext(), NULL, 10);
+  args.ExpectEnd();
+
+  if (buffer_size == 0 || buffer_size > MAX_BUFFER_SIZE) {
+    fprintf(stderr, "Invalid buffer size\n");
+    return EXIT_FAILURE;
+  }
+
+  VarioSynthesiser synthesiser(sample_rate);
+  synthesiser.SetDeadBand(true);
+  synthesiser.SetVario(fixed(0));
+
+  FakePCMSink sink(synthesiser, buffer_size);
+  sink.Start();
+
+  const unsigned buffer_ms = buffer_size * 1000 / sample_rate;
+
+  static constexpr unsigned n = 20;
+  uint64_t min = UINT64_MAX, max = 0, sum = 0;
+
+  for (unsigned i = 0; i < n; ++i) {
+    /* silence (inside the dead band), and wait until it is audible;
+       the varying delay spreads the measurements over the buffer
+       period */
+    synthesiser.SetVario(fixed(0));
+    Sleep(3 * buffer_ms + 50 + (i * 7) % (buffer_ms + 1));
+    sink.ResetOnset();
+
+    /* a new value arrives from the sensor */
+    const uint64_t submitted = MonotonicClockUS();
+    synthesiser.SetVario(fixed(3));
+
+    while (sink.GetOnset() == 0)
+      Sleep(1);
+
+    const uint64_t latency = sink.GetOnset() - submitted;
+    min = std::min(min, latency);
+    max = std::max(max, latency);
+    sum += latency;
+  }
+
+  sink.Stop();
+
+  printf("buffer=%u samples (%.1f ms)\n", buffer_size,
+         buffer_size * 1000. / sample_rate);
+  printf("latency min=%.1f ms avg=%.1f ms max=%.1f ms\n",
+         min / 1000., sum / 1000. / n, max / 1000.);
+
+  return EXIT_SUCCESS;
+}
@@ -36,7 +36,7 @@ int main(int argc, char **argv)
   FlarmNetReader::LoadFile(path.c_str(), database);
 
   for (auto i = database.begin(), end = database.end(); i != end; ++i) {
-    const FlarmRecord &record = i->second;
+    const FlarmRecord &record = *i;
 
     _tprintf(_T("%s\t%s\t%s\t%s\n"),
              record.id.c_str(), record.pilot.c_str(),
@@ -47,7 +47,7 @@ main(int argc, char **argv)
 
   const unsigned sample_rate = 44100;
 
-  VarioSynthesiser synthesiser;
+  VarioSynthesiser synthesiser(sample_rate);
 
   if (!player.Start(synthesiser, sample_rate)) {
     fprintf(stderr, "Failed to start PCMPlayer\n");
@@ -57,7 +57,7 @@ main(int argc, char **argv)
   while (replay->Next()) {
     fixed vario = replay->Basic().brutto_vario;
     printf("%2.1f\n", (double)vario);
-    synthesiser.SetVario(sample_rate, vario);
+    synthesiser.SetVario(vario);
     Sleep(1000);
   }
 
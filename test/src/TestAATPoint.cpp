@@ -134,15 +134,62 @@ TestAATPoint()
   }
 }
 
+static void
+TestIsolineCache()
+{
+  OrderedTaskBehaviour otb = ordered_task_behaviour;
+  otb.aat_min_time = fixed(3 * 3600);
+
+  OrderedTask task(task_behaviour);
+  task.SetOrderedTaskBehaviour(otb);
+  task.Append(StartPoint(new CylinderZone(wp1.location, fixed(500)), wp1,
+                         task_behaviour,
+                         ordered_task_behaviour.start_constraints));
+  task.Append(AATPoint(new CylinderZone(wp2.location, fixed(20000)), wp2,
+                       task_behaviour));
+  task.Append(FinishPoint(new CylinderZone(wp3.location, fixed(500)), wp3,
+                          task_behaviour,
+                          ordered_task_behaviour.finish_constraints));
+  task.SetActiveTaskPoint(1);
+  ok1(task.CheckTask());
+
+  AircraftState aircraft;
+  aircraft.Reset();
+  aircraft.location = MakeGeoPoint(0.1, 45.1);
+  aircraft.altitude = fixed(1500);
+  task.Update(aircraft, aircraft, glide_polar);
+
+  AATPoint &ap = (AATPoint &)task.GetPoint(1);
+  ok1(ap.GetIsolineCache() == NULL);
+
+  /* the first call searches the target range and postpones the
+     bearing optimisation, the second one optimises the bearing */
+  task.UpdateIdle(aircraft, glide_polar);
+  task.UpdateIdle(aircraft, glide_polar);
+  ok1(ap.GetIsolineCache() != NULL);
+
+  const GeoPoint target = ap.GetTargetLocation();
+
+  /* nothing has changed, so the cached solution is confirmed */
+  task.UpdateIdle(aircraft, glide_polar);
+  ok1(ap.GetIsolineCache() != NULL);
+  ok1(ap.GetTargetLocation() == target);
+
+  /* moving the target invalidates the cache */
+  ap.SetTarget(MakeGeoPoint(0.05, 45.3));
+  ok1(ap.GetIsolineCache() == NULL);
+}
+
 static void
 TestAll()
 {
   TestAATPoint();
+  TestIsolineCache();
 }
 
 int main(int argc, char **argv)
 {
-  plan_tests(717);
+  plan_tests(723);
 
   task_behaviour.SetDefaults();
   ordered_task_behaviour.SetDefaults();
@@ -26,7 +26,7 @@
 
 int main(int argc, char **argv)
 {
-  plan_tests(15);
+  plan_tests(21);
 
   int count = FlarmNet::LoadFile(_T("test/data/flarmnet/data.fln"));
   ok1(count == 6);
@@ -73,6 +73,17 @@ int main(int argc, char **argv)
   ok1(foundDDA85C);
   ok1(foundDDA896);
 
+  /* the result size is limited */
+  ok1(FlarmNet::FindRecordsByCallSign(_T("TH"), array, 1) == 1);
+  ok1(FlarmNet::FindIdsByCallSign(_T("TH"), ids, 1) == 1);
+
+  record = FlarmNet::FindFirstRecordByCallSign(_T("TH"));
+  ok1(record != NULL);
+  ok1(record != NULL && _tcscmp(record->callsign, _T("TH")) == 0);
+
+  ok1(FlarmNet::FindFirstRecordByCallSign(_T("XYZ")) == NULL);
+  ok1(FlarmNet::FindRecordById(FlarmId::Parse("123456", NULL)) == NULL);
+
   FlarmNet::Destroy();
 
   return exit_status();
@@ -22,10 +22,19 @@
 
 #include "TestUtil.hpp"
 #include "GlideSolvers/GlidePolar.hpp"
+#include "GlideSolvers/GlideResult.hpp"
+#include "Navigation/Aircraft.hpp"
 #include "Units/System.hpp"
 
+#include <algorithm>
 #include <cstdio>
 
+/**
+ * Maximum allowed deviation of GlidePolar::SpeedToFly() from a
+ * numerical search on the polar (m/s).
+ */
+static constexpr double STF_TOLERANCE = 0.01;
+
 class GlidePolarTest
 {
   GlidePolar polar;
@@ -39,6 +48,10 @@ private:
   void TestBallast();
   void TestBugs();
   void TestMC();
+  void TestSpeedToFly();
+
+  fixed ScanSpeedToFly(fixed net_sink_rate, fixed head_wind) const;
+  bool CheckSpeedToFly(fixed head_wind);
 };
 
 void
@@ -163,6 +176,95 @@ GlidePolarTest::TestMC()
   ok1(equals(polar.GetVBestLD(), 25.830434162));
 }
 
+/**
+ * Find the speed to fly by scanning the whole speed range of the
+ * polar in small steps.
+ */
+fixed
+GlidePolarTest::ScanSpeedToFly(fixed net_sink_rate, fixed head_wind) const
+{
+  const fixed v_min = std::max(polar.GetVMin(), head_wind + fixed(1));
+
+  fixed best_v = v_min, best_f = fixed(1000);
+  for (fixed v = v_min; v <= polar.GetVMax(); v += fixed(0.001)) {
+    const fixed f = (polar.MSinkRate(v) + net_sink_rate) / (v - head_wind);
+    if (f < best_f) {
+      best_v = v;
+      best_f = f;
+    }
+  }
+
+  return best_v;
+}
+
+/**
+ * Compare block and dolphin speed to fly with the numerical search
+ * for a range of netto vario values.
+ */
+bool
+GlidePolarTest::CheckSpeedToFly(fixed head_wind)
+{
+  AircraftState state;
+  state.g_load = fixed(1);
+  state.netto_vario = fixed(0);
+
+  GlideResult solution;
+  solution.Reset();
+  solution.validity = GlideResult::Validity::OK;
+  solution.head_wind = head_wind;
+
+  /* the head wind is considered only at MacCready zero */
+  if (positive(polar.GetMC()))
+    head_wind = fixed(0);
+
+  const fixed block = polar.SpeedToFly(state, solution, true);
+  if (fabs(block - ScanSpeedToFly(fixed(0), head_wind)) > fixed(STF_TOLERANCE))
+    return false;
+
+  for (fixed netto = fixed(-3); netto <= fixed(3); netto += fixed(0.25)) {
+    state.netto_vario = netto;
+
+    const fixed expected = netto > polar.GetMC() + polar.GetSMin()
+      ? polar.GetVMin()
+      : ScanSpeedToFly(-netto, head_wind);
+
+    const fixed dolphin = polar.SpeedToFly(state, solution, false);
+    if (fabs(dolphin - expected) > fixed(STF_TOLERANCE))
+      return false;
+  }
+
+  return true;
+}
+
+void
+GlidePolarTest::TestSpeedToFly()
+{
+  static const double bugs[] = { 1, 0.75 };
+  static const double ballast[] = { 0, 0.5 };
+  static const double mc[] = { 0, 1, 2, 4 };
+
+  for (auto b : bugs) {
+    polar.SetBugs(fixed(b));
+
+    for (auto bal : ballast) {
+      polar.SetBallast(fixed(bal));
+
+      for (auto m : mc) {
+        polar.SetMC(fixed(m));
+        ok1(CheckSpeedToFly(fixed(0)));
+      }
+    }
+  }
+
+  polar.SetBugs(fixed(1));
+  polar.SetBallast(fixed(0));
+  polar.SetMC(fixed(0));
+
+  static const double head_wind[] = { -10, -5, 5, 10, 20 };
+  for (auto w : head_wind)
+    ok1(CheckSpeedToFly(fixed(w)));
+}
+
 void
 GlidePolarTest::Run()
 {
@@ -171,11 +273,12 @@ GlidePolarTest::Run()
   TestBallast();
   TestBugs();
   TestMC();
+  TestSpeedToFly();
 }
 
 int main(int argc, char **argv)
 {
-  plan_tests(46);
+  plan_tests(67);
 
   GlidePolarTest test;
   test.Run();
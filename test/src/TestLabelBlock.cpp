@@ -0,0 +1,119 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Renderer/LabelBlock.hpp"
+#include "TestUtil.hpp"
+
+#include <vector>
+
+#include <stdlib.h>
+
+static PixelRect
+MakeRect(int left, int top, int width, int height)
+{
+  PixelRect rc;
+  SetRect(rc, left, top, left + width, top + height);
+  return rc;
+}
+
+/**
+ * The reference implementation: compare with every rectangle that
+ * was accepted so far.
+ */
+class BruteForceLabelBlock {
+  std::vector<PixelRect> blocks;
+
+public:
+  bool check(const PixelRect rc) {
+    for (auto i = blocks.begin(), end = blocks.end(); i != end; ++i)
+      if (rc.left < i->right && rc.right > i->left &&
+          rc.top < i->bottom && rc.bottom > i->top)
+        return false;
+
+    blocks.push_back(rc);
+    return true;
+  }
+};
+
+static void
+TestBasic()
+{
+  static LabelBlock lb;
+
+  ok1(lb.check(MakeRect(100, 100, 50, 10)));
+  /* same rectangle */
+  ok1(!lb.check(MakeRect(100, 100, 50, 10)));
+  /* touching edges do not overlap */
+  ok1(lb.check(MakeRect(150, 100, 50, 10)));
+  ok1(lb.check(MakeRect(100, 110, 50, 10)));
+  /* overlap across a cell boundary */
+  ok1(!lb.check(MakeRect(120, 95, 200, 100)));
+  /* partly off-screen, clipped to the grid */
+  ok1(lb.check(MakeRect(-30, -20, 40, 30)));
+  ok1(!lb.check(MakeRect(-100, -100, 95, 85)));
+  ok1(lb.check(MakeRect(10000, 10000, 50, 10)));
+  ok1(!lb.check(MakeRect(10040, 10005, 50, 10)));
+
+  lb.reset();
+  ok1(lb.check(MakeRect(100, 100, 50, 10)));
+}
+
+static constexpr unsigned N_ROUNDS = 20;
+
+/**
+ * Compare the grid with the brute-force implementation for random
+ * rectangles.  The number of rectangles stays below the capacity of
+ * #LabelBlock, because it stops blocking when it is full.
+ */
+static void
+TestRandom()
+{
+  static LabelBlock lb;
+
+  for (unsigned round = 0; round < N_ROUNDS; ++round) {
+    lb.reset();
+    BruteForceLabelBlock reference;
+
+    unsigned mismatches = 0;
+    for (unsigned i = 0; i < 300; ++i) {
+      const PixelRect rc = MakeRect(rand() % 1400 - 100, rand() % 1100 - 100,
+                                    1 + rand() % 200, 1 + rand() % 30);
+      if (lb.check(rc) != reference.check(rc))
+        ++mismatches;
+    }
+
+    ok1(mismatches == 0);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(10 + N_ROUNDS);
+
+  srand(42);
+
+  TestBasic();
+  TestRandom();
+
+  return exit_status();
+}
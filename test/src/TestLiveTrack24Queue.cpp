@@ -0,0 +1,110 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Tracking/LiveTrack24Queue.hpp"
+#include "TestUtil.hpp"
+
+using namespace LiveTrack24;
+
+static Position
+MakePosition(int64_t timestamp)
+{
+  Position position;
+  position.timestamp = timestamp;
+  position.location = GeoPoint(Angle::Degrees(7), Angle::Degrees(51));
+  position.altitude = 1000 + timestamp;
+  position.ground_speed = 100;
+  position.track = Angle::Degrees(90);
+  return position;
+}
+
+static void
+TestQueue()
+{
+  PositionQueue queue;
+  ok1(queue.IsEmpty());
+  ok1(queue.GetSize() == 0);
+
+  for (unsigned i = 0; i < 10; ++i)
+    queue.Push(MakePosition(i));
+
+  ok1(queue.GetSize() == 10);
+  ok1(queue.Peek().timestamp == 0);
+  ok1(queue.Last().timestamp == 9);
+
+  queue.Shift();
+  ok1(queue.GetSize() == 9);
+  ok1(queue.Peek().timestamp == 1);
+
+  /* overflow discards the oldest positions */
+  for (unsigned i = 10; i < 2000; ++i)
+    queue.Push(MakePosition(i));
+
+  ok1(queue.GetSize() == 1024);
+  ok1(queue.Peek().timestamp == 2000 - 1024);
+  ok1(queue.Last().timestamp == 1999);
+}
+
+static void
+TestSaveLoad()
+{
+  PositionQueue queue;
+  for (unsigned i = 0; i < 5; ++i)
+    queue.Push(MakePosition(100 + i));
+
+  FILE *file = tmpfile();
+  ok1(file != NULL);
+  if (file == NULL)
+    return;
+
+  ok1(queue.Save(file));
+  rewind(file);
+
+  PositionQueue loaded;
+  ok1(loaded.Load(file));
+  ok1(loaded.GetSize() == 5);
+  ok1(loaded.Peek().timestamp == 100);
+  ok1(loaded.Peek().altitude == 1100);
+  ok1(loaded.Last().timestamp == 104);
+  ok1(equals(loaded.Last().location.latitude, Angle::Degrees(51)));
+
+  /* a corrupt header is rejected */
+  rewind(file);
+  fputc(0x42, file);
+  rewind(file);
+  PositionQueue broken;
+  ok1(!broken.Load(file));
+
+  fclose(file);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(19);
+
+  TestQueue();
+  TestSaveLoad();
+
+  return exit_status();
+}
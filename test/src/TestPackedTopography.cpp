@@ -0,0 +1,287 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Topography/TopographyStore.hpp"
+#include "Topography/TopographyFile.hpp"
+#include "Topography/XShape.hpp"
+#include "Topography/PackedTopography.hpp"
+#include "Topography/PackedTopographyWriter.hpp"
+#include "IO/ZipLineReader.hpp"
+#include "Operation/Operation.hpp"
+#include "TestUtil.hpp"
+
+#include <zzip/zzip.h>
+
+#include <vector>
+
+#include <stdio.h>
+#include <string.h>
+#include <tchar.h>
+
+static const char *map_path = "test/data/benalla9.xcm";
+static const char *packed_path = "output/TestPackedTopography.xtp";
+static const char *corrupt_path = "output/TestPackedTopography-corrupt.xtp";
+
+static bool
+Equals(Angle a, Angle b)
+{
+  /* the file stores angles in steps of 10^-7 degrees */
+  return fabs(a.Degrees() - b.Degrees()) < fixed(2e-7);
+}
+
+static bool
+Equals(const GeoPoint &a, const GeoPoint &b)
+{
+  return Equals(a.longitude, b.longitude) && Equals(a.latitude, b.latitude);
+}
+
+static bool
+Equals(const GeoBounds &a, const GeoBounds &b)
+{
+  return Equals(a.GetNorthWest(), b.GetNorthWest()) &&
+    Equals(a.GetSouthEast(), b.GetSouthEast());
+}
+
+static bool
+EqualsIndices(const TopographyFile &file, const XShape &a, const XShape &b,
+              unsigned level)
+{
+  const unsigned min_distance = file.GetMinimumPointDistance(level);
+
+  const unsigned short *a_count, *b_count;
+  const unsigned short *a_indices = a.get_indices(level, min_distance,
+                                                  a_count);
+  const unsigned short *b_indices = b.get_indices(level, min_distance,
+                                                  b_count);
+  if (a_indices == NULL || b_indices == NULL)
+    return a_indices == b_indices;
+
+  const unsigned num_counts = a.get_type() == MS_SHAPE_LINE
+    ? a.get_number_of_lines()
+    : 1;
+  if (memcmp(a_count, b_count, num_counts * sizeof(*a_count)) != 0)
+    return false;
+
+  unsigned num_indices = 0;
+  for (unsigned i = 0; i < num_counts; ++i)
+    num_indices += a_count[i];
+
+  return memcmp(a_indices, b_indices, num_indices * sizeof(*a_indices)) == 0;
+}
+
+static bool
+Equals(const TopographyFile &file, const XShape &a, const XShape &b)
+{
+  if (a.get_type() != b.get_type() ||
+      a.get_number_of_lines() != b.get_number_of_lines() ||
+      memcmp(a.get_lines(), b.get_lines(),
+             a.get_number_of_lines() * sizeof(*a.get_lines())) != 0 ||
+      !Equals(a.get_bounds(), b.get_bounds()) ||
+      !Equals(a.get_center(), b.get_center()))
+    return false;
+
+  if (a.get_label() == NULL || b.get_label() == NULL
+      ? a.get_label() != b.get_label()
+      : _tcscmp(a.get_label(), b.get_label()) != 0)
+    return false;
+
+  unsigned num_points = 0;
+  for (unsigned i = 0; i < a.get_number_of_lines(); ++i)
+    num_points += a.get_lines()[i];
+
+  for (unsigned i = 0; i < num_points; ++i)
+    if (a.get_points()[i].x != b.get_points()[i].x ||
+        a.get_points()[i].y != b.get_points()[i].y)
+      return false;
+
+  if (a.get_type() == MS_SHAPE_LINE || a.get_type() == MS_SHAPE_POLYGON)
+    for (unsigned level = 0; level < XShape::THINNING_LEVELS; ++level)
+      if (!EqualsIndices(file, a, b, level))
+        return false;
+
+  return true;
+}
+
+/**
+ * Compare the shapes and settings of two layers.  Returns the number
+ * of shapes, or -1 on mismatch.
+ */
+static int
+CompareLayer(const TopographyFile &a, const TopographyFile &b)
+{
+  if (a.GetScaleThreshold() != b.GetScaleThreshold() ||
+      a.GetLabelThreshold() != b.GetLabelThreshold() ||
+      a.GetImportantLabelThreshold() != b.GetImportantLabelThreshold() ||
+      a.GetIcon() != b.GetIcon() ||
+      a.GetPenWidth() != b.GetPenWidth() ||
+      a.GetColor() != b.GetColor())
+    return -1;
+
+  int n = 0;
+  auto i = a.begin(), j = b.begin();
+  for (; i != a.end() && j != b.end(); ++i, ++j, ++n)
+    if (!Equals(a, *i, *j))
+      return -1;
+
+  return i == a.end() && j == b.end() ? n : -1;
+}
+
+static unsigned
+CountShapes(const TopographyFile &file)
+{
+  unsigned n = 0;
+  for (auto i = file.begin(); i != file.end(); ++i)
+    ++n;
+  return n;
+}
+
+static std::vector<uint8_t>
+ReadFile(const char *path)
+{
+  std::vector<uint8_t> buffer;
+
+  FILE *file = fopen(path, "rb");
+  if (file == NULL)
+    return buffer;
+
+  uint8_t chunk[4096];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0)
+    buffer.insert(buffer.end(), chunk, chunk + n);
+
+  fclose(file);
+  return buffer;
+}
+
+static bool
+WriteFile(const char *path, const std::vector<uint8_t> &buffer, size_t size)
+{
+  FILE *file = fopen(path, "wb");
+  if (file == NULL)
+    return false;
+
+  const bool success = fwrite(buffer.data(), 1, size, file) == size;
+  return fclose(file) == 0 && success;
+}
+
+/**
+ * Replace the first byte of the first label in the specified layer
+ * with a continuation byte, which is not valid at the start of a
+ * UTF-8 sequence.
+ */
+static bool
+CorruptLabel(std::vector<uint8_t> &buffer, unsigned layer_index)
+{
+  using namespace PackedTopography;
+
+  const void *data = buffer.data();
+  const Header &header = *At<Header>(data, 0);
+  const Layer &layer = At<Layer>(data, header.layers_offset)[layer_index];
+  const Shape *shapes = At<Shape>(data, layer.shapes_offset);
+
+  for (unsigned i = 0; i < layer.num_shapes; ++i) {
+    if (shapes[i].label_offset != 0) {
+      buffer[shapes[i].label_offset] = 0x80;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(17);
+
+  ZZIP_DIR *dir = zzip_dir_open(map_path, NULL);
+  ok1(dir != NULL);
+  if (dir == NULL)
+    return exit_status();
+
+  TopographyStore original;
+  {
+    ZipLineReaderA reader(dir, "topology.tpl");
+    NullOperationEnvironment operation;
+    original.Load(operation, reader, NULL, dir);
+  }
+
+  original.LoadAll();
+  ok1(original.size() == 6);
+  ok1(WritePackedTopography(original, packed_path));
+
+  /* pack, load and compare with the shapefile reader */
+  TopographyStore packed;
+  ok1(packed.LoadPacked(_T("output/TestPackedTopography.xtp")));
+  packed.LoadAll();
+  ok1(packed.size() == original.size());
+
+  /* the last layer (places) has labels */
+  int num_places = -1;
+  unsigned num_shapes = 0;
+  for (unsigned i = 0; i < 6; ++i) {
+    const int n = i < packed.size()
+      ? CompareLayer(original[i], packed[i])
+      : -1;
+    ok(n > 0, "layer %u shapes=%d", i, n);
+    if (n > 0)
+      num_shapes += n;
+    if (i == 5)
+      num_places = n;
+  }
+
+  std::vector<uint8_t> buffer = ReadFile(packed_path);
+  ok1(buffer.size() > sizeof(PackedTopography::Header));
+
+  /* an invalid label drops its shape, and only that one */
+  std::vector<uint8_t> corrupt = buffer;
+  TopographyStore store;
+  ok1(CorruptLabel(corrupt, 5) &&
+      WriteFile(corrupt_path, corrupt, corrupt.size()) &&
+      store.LoadPacked(_T("output/TestPackedTopography-corrupt.xtp")) &&
+      store.size() == 6);
+  store.LoadAll();
+  ok1(store.size() == 6 && (int)CountShapes(store[5]) == num_places - 1);
+
+  /* a truncated file is rejected: strings may be unterminated */
+  size_t size = buffer.size() / 2;
+  while (buffer[size - 1] == 0)
+    --size;
+  ok1(WriteFile(corrupt_path, buffer, size) &&
+      !store.LoadPacked(_T("output/TestPackedTopography-corrupt.xtp")));
+
+  /* if it happens to end with a null byte, the layers and shapes
+     pointing beyond the end are dropped */
+  corrupt = buffer;
+  corrupt[size] = 0;
+  ok1(WriteFile(corrupt_path, corrupt, size + 1) &&
+      store.LoadPacked(_T("output/TestPackedTopography-corrupt.xtp")));
+  store.LoadAll();
+  unsigned total = 0;
+  for (unsigned i = 0; i < store.size(); ++i)
+    total += CountShapes(store[i]);
+  ok1(total < num_shapes);
+
+  zzip_dir_close(dir);
+
+  return exit_status();
+}
@@ -45,12 +45,37 @@ test_simple()
                                     Angle::Zero()), 0, 0);
 }
 
+static void
+test_batch()
+{
+  Projection prj;
+  prj.SetScreenOrigin(160, 120);
+  prj.SetScale(fixed(0.01));
+  prj.SetGeoLocation(GeoPoint(Angle::Degrees(7.7), Angle::Degrees(51.05)));
+  prj.SetScreenAngle(Angle::Degrees(30));
+
+  static constexpr unsigned n = 16;
+  GeoPoint geo[n];
+  for (unsigned i = 0; i < n; ++i)
+    geo[i] = GeoPoint(Angle::Degrees(7.6 + 0.013 * i),
+                      Angle::Degrees(51.1 - 0.007 * i));
+
+  RasterPoint screen[n];
+  prj.GeoToScreen(geo, screen, n);
+
+  for (unsigned i = 0; i < n; ++i) {
+    const RasterPoint expected = prj.GeoToScreen(geo[i]);
+    ok1(screen[i].x == expected.x && screen[i].y == expected.y);
+  }
+}
+
 int
 main(int argc, char **argv)
 {
-  plan_tests(4);
+  plan_tests(4 + 16);
 
   test_simple();
+  test_batch();
 
   return exit_status();
 }
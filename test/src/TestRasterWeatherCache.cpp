@@ -0,0 +1,154 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Terrain/RasterWeatherCache.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+
+/**
+ * Returns a fake map pointer; the cache never dereferences it.
+ */
+static RasterMap *
+MakeMap(unsigned i)
+{
+  static char maps[RasterWeatherCache::MAX_TIMES * 2];
+  return reinterpret_cast<RasterMap *>(maps + i);
+}
+
+static void
+TestTimeRank()
+{
+  ok1(RasterWeatherCache::TimeRank(5, 5) == 0);
+  ok1(RasterWeatherCache::TimeRank(7, 5) == 2);
+  ok1(RasterWeatherCache::TimeRank(47, 5) == 42);
+  /* the preceding time steps come after all following ones, the
+     nearest first */
+  ok1(RasterWeatherCache::TimeRank(4, 5) == 43);
+  ok1(RasterWeatherCache::TimeRank(0, 5) == 47);
+}
+
+/**
+ * Add the specified time steps of parameter 1 without eviction.
+ */
+static bool
+Fill(RasterWeatherCache &cache, unsigned first, unsigned n)
+{
+  for (unsigned t = first; t < first + n; ++t) {
+    RasterMap *evicted;
+    if (!cache.Add(1, t, MakeMap(t), 1, first, NULL, evicted) ||
+        evicted != NULL)
+      return false;
+  }
+
+  return true;
+}
+
+static void
+TestAdd()
+{
+  RasterWeatherCache cache;
+  RasterMap *evicted;
+
+  ok1(cache.Find(1, 10) == NULL);
+  ok1(cache.Add(1, 10, MakeMap(10), 1, 10, NULL, evicted));
+  ok1(evicted == NULL);
+  ok1(cache.Find(1, 10) != NULL);
+  ok1(cache.Find(1, 10)->map == MakeMap(10));
+
+  /* duplicate */
+  ok1(!cache.Add(1, 10, MakeMap(11), 1, 10, NULL, evicted));
+  ok1(evicted == NULL);
+
+  /* not the selected parameter */
+  ok1(!cache.Add(2, 11, MakeMap(11), 1, 10, NULL, evicted));
+  ok1(evicted == NULL);
+  ok1(cache.size() == 1);
+}
+
+static void
+TestEviction()
+{
+  RasterWeatherCache cache;
+  RasterMap *evicted;
+
+  ok1(Fill(cache, 10, RasterWeatherCache::MAX_SIZE));
+  ok1(cache.size() == RasterWeatherCache::MAX_SIZE);
+
+  /* all cached maps are more useful than the new one */
+  ok1(!cache.Add(1, 22, MakeMap(22), 1, 10, NULL, evicted));
+  ok1(evicted == NULL);
+
+  /* the user has stepped forward: the maps before the current time
+     step go first, the oldest first */
+  ok1(cache.Add(1, 22, MakeMap(22), 1, 14, NULL, evicted));
+  ok1(evicted == MakeMap(10));
+  ok1(cache.Find(1, 10) == NULL);
+  ok1(cache.Add(1, 23, MakeMap(23), 1, 14, NULL, evicted));
+  ok1(evicted == MakeMap(11));
+
+  /* another parameter was selected: its maps go first, but never
+     the current one */
+  ok1(cache.Add(2, 14, MakeMap(14), 2, 14, MakeMap(12), evicted));
+  ok1(evicted != NULL && evicted != MakeMap(12));
+  ok1(cache.Find(1, 12) != NULL);
+  ok1(cache.size() == RasterWeatherCache::MAX_SIZE);
+}
+
+static void
+TestFindPreloadTime()
+{
+  bool available[RasterWeatherCache::MAX_TIMES];
+  std::fill(available, available + RasterWeatherCache::MAX_TIMES, true);
+
+  RasterWeatherCache cache;
+  ok1(cache.FindPreloadTime(1, 10, available) == 10);
+
+  ok1(Fill(cache, 10, 2));
+  ok1(cache.FindPreloadTime(1, 10, available) == 12);
+  ok1(cache.FindPreloadTime(2, 10, available) == 10);
+
+  available[12] = false;
+  ok1(cache.FindPreloadTime(1, 10, available) == 13);
+
+  /* enough maps around the current time step */
+  ok1(Fill(cache, 13, RasterWeatherCache::MAX_SIZE - 2));
+  ok1(cache.FindPreloadTime(1, 10, available) == -1);
+
+  /* at the end of the day, the preceding time steps are preloaded */
+  cache.clear();
+  ok1(Fill(cache, 40, 8));
+  ok1(cache.FindPreloadTime(1, 40, available) == 39);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(37);
+
+  TestTimeRank();
+  TestAdd();
+  TestEviction();
+  TestFindPreloadTime();
+
+  return exit_status();
+}
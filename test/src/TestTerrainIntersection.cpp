@@ -0,0 +1,224 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Terrain/RasterTileCache.hpp"
+#include "Terrain/RasterLocation.hpp"
+#include "TestUtil.hpp"
+
+#include <stdlib.h>
+
+static constexpr unsigned N_ROUNDS = 25;
+
+static constexpr unsigned SIZE = 1024, TILE = 256;
+
+/**
+ * The low terrain is random noise below this height.
+ */
+static constexpr short GROUND = 200;
+
+/**
+ * A square block of this height and size is the only obstacle the
+ * glide line may hit.  It is aligned to the finest pyramid blocks,
+ * so the line enters it right where a clear block ends, and it is
+ * wider than the sampling interval of the searches, so they cannot
+ * step over it.
+ */
+static constexpr short MESA_HEIGHT = 4000;
+static constexpr unsigned MESA_SIZE = 3u << RasterTile::PYRAMID_BITS;
+
+/**
+ * The searches sample the terrain only every 16 steps (plus one for
+ * a diagonal step), so their result may be that much short of the
+ * exact first intersection.
+ */
+static constexpr int TOLERANCE = 17;
+
+/**
+ * A terrain map built in memory, with all tiles loaded.
+ */
+class SyntheticTerrain : public RasterTileCache {
+public:
+  SyntheticTerrain() {
+    const unsigned n = SIZE / TILE;
+    SetSize(SIZE, SIZE, TILE, TILE, n, n);
+
+    for (unsigned i = 0; i < n * n; ++i) {
+      const unsigned x = (i % n) * TILE, y = (i / n) * TILE;
+      SetTile(i, x, y, x + TILE, y + TILE);
+      tiles.GetLinear(i).Enable();
+    }
+  }
+
+  /**
+   * Fill the map with random ground and a mesa whose upper left
+   * corner is at the specified pixel.
+   */
+  void Generate(unsigned mx, unsigned my) {
+    for (auto it = tiles.begin(), end = tiles.end(); it != end; ++it) {
+      short *p = it->GetImageBuffer();
+      for (unsigned y = it->ystart; y < it->yend; ++y) {
+        for (unsigned x = it->xstart; x < it->xend; ++x) {
+          *p++ = x - mx < MESA_SIZE && y - my < MESA_SIZE
+            ? MESA_HEIGHT
+            : (short)(rand() % GROUND);
+        }
+      }
+    }
+  }
+
+  /**
+   * Build or discard the min/max pyramids.  Without them, the
+   * searches sample the terrain at regular intervals.
+   */
+  void SetPyramid(bool enable) {
+    for (auto it = tiles.begin(), end = tiles.end(); it != end; ++it) {
+      if (enable)
+        it->UpdatePyramid();
+      else
+        for (unsigned level = 0; level < RasterTile::PYRAMID_LEVELS; ++level)
+          it->pyramid[level].Reset();
+    }
+  }
+};
+
+static short
+LineHeight(short h_origin, int slope_fact, int steps)
+{
+  return h_origin + (short)((steps * slope_fact) >> RASTER_SLOPE_FACT);
+}
+
+/**
+ * Walk the line one step at a time, the same way the searches do,
+ * and return the number of steps until the line is below the
+ * terrain first, or -1 if it never is.
+ */
+static int
+ReferenceWalk(const RasterTileCache &terrain,
+              int x0, int y0, int x1, int y1,
+              short h_origin, int slope_fact)
+{
+  const int dx = abs(x1 - x0), dy = abs(y1 - y0);
+  const int sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+  int err = dx - dy;
+  int x = x0, y = y0;
+
+  for (int steps = 0;; ) {
+    if (LineHeight(h_origin, slope_fact, steps) <
+        terrain.GetHeight(x, y))
+      return steps;
+
+    if (steps >= dx + dy)
+      return -1;
+
+    const int e2 = 2 * err;
+    if (e2 > -dy) {
+      err -= dy;
+      x += sx;
+      ++steps;
+    }
+    if (e2 < dx) {
+      err += dx;
+      y += sy;
+      ++steps;
+    }
+  }
+}
+
+static int
+Distance(int x0, int y0, unsigned x, unsigned y)
+{
+  return abs((int)x - x0) + abs((int)y - y0);
+}
+
+/**
+ * @param axis 0 for a line in any direction, 1 for a horizontal
+ * line, 2 for a vertical line; along an axis, the sample after
+ * skipping a clear block is exactly the first pixel of the mesa
+ */
+static void
+TestRound(SyntheticTerrain &terrain, unsigned axis)
+{
+  /* the line ends in the centre of the mesa */
+  const unsigned n_blocks = (SIZE - MESA_SIZE) >> RasterTile::PYRAMID_BITS;
+  const unsigned mx = (rand() % n_blocks) << RasterTile::PYRAMID_BITS;
+  const unsigned my = (rand() % n_blocks) << RasterTile::PYRAMID_BITS;
+  const int cx = mx + MESA_SIZE / 2, cy = my + MESA_SIZE / 2;
+
+  int x0, y0;
+  do {
+    x0 = axis == 2 ? cx : rand() % SIZE;
+    y0 = axis == 1 ? cy : rand() % SIZE;
+  } while (Distance(cx, cy, x0, y0) < 300);
+
+  terrain.Generate(mx, my);
+
+  /* descend 1500 m over the whole line; the line stays well above
+     the ground and below the ceiling */
+  const short h_origin = 2000;
+  const int slope_fact = (1500 << RASTER_SLOPE_FACT) / Distance(cx, cy, x0, y0);
+  const short h_ceiling = 3000;
+
+  const int first_hit = ReferenceWalk(terrain, x0, y0, cx, cy,
+                                      h_origin, -slope_fact);
+
+  for (unsigned i = 0; i < 2; ++i) {
+    terrain.SetPyramid(i > 0);
+
+    /* the first intersection; the refinement walks a slightly
+       different line, and may return the point where it found the
+       intersection, therefore it may be off in both directions */
+    const RasterLocation l =
+      terrain.Intersection(x0, y0, cx, cy, h_origin, slope_fact);
+    const int d = Distance(x0, y0, l.x, l.y);
+    ok(first_hit > 0 && abs(d - first_hit) <= TOLERANCE,
+       "Intersection pyramid=%u first_hit=%d result=%d", i, first_hit, d);
+
+    /* the mesa reaches above the ceiling, so this returns the last
+       clear point before it */
+    unsigned x = 0, y = 0;
+    short h = 0;
+    const bool found =
+      terrain.FirstIntersection(x0, y0, cx, cy, h_origin, h_origin,
+                                -slope_fact, h_ceiling, 0,
+                                x, y, h, false);
+    const int d2 = Distance(x0, y0, x, y);
+    ok(found && d2 < first_hit && d2 + TOLERANCE >= first_hit &&
+       terrain.GetHeight(x, y) < GROUND &&
+       h == LineHeight(h_origin, -slope_fact, d2),
+       "FirstIntersection pyramid=%u first_hit=%d result=%d h=%d",
+       i, first_hit, d2, h);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(4 * N_ROUNDS);
+
+  srand(42);
+
+  SyntheticTerrain terrain;
+  for (unsigned i = 0; i < N_ROUNDS; ++i)
+    TestRound(terrain, i % 3);
+
+  return exit_status();
+}
@@ -0,0 +1,135 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "CrossSection/TerrainXSProfile.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Operation/Operation.hpp"
+#include "TestUtil.hpp"
+
+static constexpr unsigned NUM_SLICES = TerrainXSProfile::NUM_SLICES;
+
+static constexpr unsigned N_BEARINGS = 8;
+
+/**
+ * The distances the aircraft advances along the line [samples],
+ * measured from the initial start point.  Some are whole samples, so
+ * the shifted profile is not resampled.
+ */
+static constexpr double ADVANCES[] = { 2.5, 5, 11.25, 20, 32.6, 45 };
+static constexpr unsigned N_ADVANCES = sizeof(ADVANCES) / sizeof(ADVANCES[0]);
+
+/**
+ * Are all cached samples equal to a fresh sample along the initial
+ * line, which begins at #start with #bearing?
+ */
+static bool
+CheckProfile(const RasterMap &map, const TerrainXSProfile &profile,
+             const GeoPoint &start, Angle bearing)
+{
+  const fixed step = profile.GetStep();
+  const fixed shifted = start.Distance(profile.GetOrigin());
+
+  const short *samples = profile.GetProfile();
+  for (unsigned i = 0; i <= NUM_SLICES; ++i) {
+    const GeoPoint p = GeoVector(shifted + step * i, bearing).EndPoint(start);
+    if (samples[i] != map.GetHeight(p))
+      return false;
+  }
+
+  return true;
+}
+
+/**
+ * Does the (shifted) profile have the same elevations as a profile
+ * sampled from scratch at #start, along the same line?
+ */
+static bool
+CheckElevations(const RasterMap &map, const TerrainXSProfile &profile,
+                const GeoPoint &start, fixed range)
+{
+  TerrainXSProfile fresh;
+  fresh.Move(start, GeoVector(range, profile.GetBearing()));
+  fresh.Update(map);
+
+  const short *a = profile.GetElevations(), *b = fresh.GetElevations();
+  for (unsigned i = 0; i < NUM_SLICES; ++i)
+    if (a[i] != b[i])
+      return false;
+
+  return true;
+}
+
+static void
+TestBearing(const RasterMap &map, Angle bearing)
+{
+  const fixed range(20000);
+  const fixed step = range / (NUM_SLICES - 1);
+  const GeoPoint start =
+    GeoVector(range, bearing.Reciprocal()).EndPoint(map.GetMapCenter());
+
+  TerrainXSProfile profile;
+  profile.Move(start, GeoVector(range, bearing));
+  profile.Update(map);
+  ok1(CheckProfile(map, profile, start, bearing));
+
+  for (unsigned i = 0; i < N_ADVANCES; ++i) {
+    const fixed distance = step * fixed(ADVANCES[i]);
+    const GeoPoint location = GeoVector(distance, bearing).EndPoint(start);
+
+    /* the aircraft keeps its track, the cache must follow the great
+       circle */
+    profile.Move(location, GeoVector(range, bearing));
+    profile.Update(map);
+
+    const fixed behind = location.Distance(profile.GetOrigin());
+    ok(behind < step && CheckProfile(map, profile, start, bearing),
+       "bearing=%d advance=%g", (int)bearing.Degrees(), ADVANCES[i]);
+
+    if (ADVANCES[i] == (double)(unsigned)ADVANCES[i])
+      ok(CheckElevations(map, profile, location, range),
+         "bearing=%d advance=%g elevations",
+         (int)bearing.Degrees(), ADVANCES[i]);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  NullOperationEnvironment operation;
+  RasterMap map(_T("test/data/benalla9.xcm/terrain.jp2"),
+                _T("test/data/benalla9.xcm/terrain.j2w"), NULL, operation);
+  if (!map.IsDefined()) {
+    fprintf(stderr, "failed to load test/data/benalla9.xcm/terrain.jp2\n");
+    return EXIT_FAILURE;
+  }
+
+  do {
+    map.SetViewCenter(map.GetMapCenter(), fixed(100000));
+  } while (map.IsDirty());
+
+  plan_tests(N_BEARINGS * (1 + N_ADVANCES + 3));
+
+  for (unsigned i = 0; i < N_BEARINGS; ++i)
+    TestBearing(map, Angle::Degrees(fixed(360 * i / N_BEARINGS + 10)));
+
+  return exit_status();
+}
@@ -0,0 +1,168 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FLARM/TrafficPredictor.hpp"
+#include "FLARM/List.hpp"
+#include "Math/Angle.hpp"
+#include "TestUtil.hpp"
+
+static FlarmTraffic &
+AddTraffic(TrafficList &list, double north, double east, double altitude,
+           double track, double speed, double turn_rate, double climb_rate)
+{
+  FlarmTraffic &traffic = *list.AllocateTraffic();
+  traffic.Clear();
+  traffic.valid.Update(fixed(1));
+  traffic.id = FlarmId::Undefined();
+  traffic.relative_north = fixed(north);
+  traffic.relative_east = fixed(east);
+  traffic.relative_altitude = fixed(altitude);
+  traffic.track = Angle::Degrees(track);
+  traffic.track_received = true;
+  traffic.speed = fixed(speed);
+  traffic.speed_received = true;
+  traffic.turn_rate = fixed(turn_rate);
+  traffic.turn_rate_received = true;
+  traffic.climb_rate = fixed(climb_rate);
+  traffic.climb_rate_received = true;
+  return traffic;
+}
+
+static void
+TestPredict()
+{
+  TrafficList list;
+  list.Clear();
+
+  /* straight, 30 m/s to the east, climbing */
+  AddTraffic(list, 1000, 0, 100, 90, 30, 0, 2);
+  /* full circle in 20 seconds */
+  AddTraffic(list, 0, 500, 0, 0, 25, 18, 0);
+
+  TrafficPredictor predictor;
+  predictor.Update(list, Angle::Zero(), fixed(0), fixed(0));
+  ok1(predictor.size() == 2);
+  ok1(equals(predictor.GetPredictedNorth(0), 1000));
+
+  predictor.Predict(fixed(10));
+  ok1(equals(predictor.GetPredictedNorth(0), 1000));
+  ok1(equals(predictor.GetPredictedEast(0), 300));
+  ok1(equals(predictor.GetPredictedAltitude(0), 120));
+
+  /* after half a circle, the target is one diameter east of its
+     start */
+  const fixed diameter = fixed(25 * 20) / fixed_pi;
+  ok1(fabs(predictor.GetPredictedNorth(1)) < fixed(1));
+  ok1(fabs(predictor.GetPredictedEast(1) - fixed(500) - diameter) < fixed(1));
+
+  predictor.Predict(fixed(20));
+  ok1(fabs(predictor.GetPredictedNorth(1)) < fixed(1));
+  ok1(fabs(predictor.GetPredictedEast(1) - fixed(500)) < fixed(1));
+
+  /* our own movement is subtracted */
+  predictor.Update(list, Angle::Degrees(90), fixed(30), fixed(0));
+  predictor.Predict(fixed(10));
+  ok1(equals(predictor.GetPredictedNorth(0), 1000));
+  ok1(fabs(predictor.GetPredictedEast(0)) < fixed(0.01));
+}
+
+static void
+TestClosestApproach()
+{
+  TrafficList list;
+  list.Clear();
+
+  /* head-on, 2 km north, 50 m higher */
+  AddTraffic(list, 2000, 0, 50, 180, 30, 0, 0);
+  /* parallel, 300 m east */
+  AddTraffic(list, 0, 300, 0, 0, 30, 0, 0);
+  /* crossing from the east, passing 100 m behind us */
+  AddTraffic(list, -100 + 30 * 40, 1000, 0, 270, 25, 0, 0);
+
+  TrafficPredictor predictor;
+  predictor.Update(list, Angle::Zero(), fixed(30), fixed(0));
+  predictor.UpdateClosestApproach(fixed(60));
+
+  ok1(equals(predictor.GetClosestApproachTime(0), fixed(2000) / 60));
+  ok1(equals(predictor.GetClosestApproachDistance(0), 50));
+
+  ok1(equals(predictor.GetClosestApproachTime(1), 0));
+  ok1(equals(predictor.GetClosestApproachDistance(1), 300));
+
+  ok1(predictor.GetClosestApproachDistance(2) < fixed(100));
+  ok1(predictor.FindMostCritical(fixed(200)) == 0);
+  ok1(predictor.FindMostCritical(fixed(10)) == -1);
+
+  /* limited look-ahead */
+  predictor.UpdateClosestApproach(fixed(10));
+  ok1(equals(predictor.GetClosestApproachTime(0), 10));
+  ok1(equals(predictor.GetClosestApproachDistance(0),
+             hypot(fixed(1400), fixed(50))));
+}
+
+static void
+TestMissingData()
+{
+  TrafficList list;
+  list.Clear();
+
+  /* no track: stationary */
+  AddTraffic(list, 1000, 0, 0, 90, 30, 0, 0).track_received = false;
+  /* no speed: stationary */
+  AddTraffic(list, 0, 1000, 0, 90, 30, 0, 0).speed_received = false;
+  /* no turn rate: straight */
+  AddTraffic(list, 0, 0, 0, 90, 30, 18, 0).turn_rate_received = false;
+  /* no climb rate: level */
+  AddTraffic(list, 0, 0, 100, 0, 0, 0, 5).climb_rate_received = false;
+
+  TrafficPredictor predictor;
+  predictor.Update(list, Angle::Zero(), fixed(0), fixed(0));
+  ok1(predictor.size() == 4);
+
+  predictor.Predict(fixed(10));
+  ok1(equals(predictor.GetPredictedNorth(0), 1000));
+  ok1(fabs(predictor.GetPredictedEast(0)) < fixed(0.01));
+  ok1(fabs(predictor.GetPredictedNorth(1)) < fixed(0.01));
+  ok1(equals(predictor.GetPredictedEast(1), 1000));
+  ok1(fabs(predictor.GetPredictedNorth(2)) < fixed(1));
+  ok1(equals(predictor.GetPredictedEast(2), 300));
+  ok1(equals(predictor.GetPredictedAltitude(3), 100));
+
+  /* a stationary target ahead is approached by our own movement */
+  predictor.Update(list, Angle::Zero(), fixed(50), fixed(0));
+  predictor.UpdateClosestApproach(fixed(60));
+  ok1(equals(predictor.GetClosestApproachTime(0), 20));
+  ok1(fabs(predictor.GetClosestApproachDistance(0)) < fixed(0.1));
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(30);
+
+  TestPredict();
+  TestClosestApproach();
+  TestMissingData();
+
+  return exit_status();
+}
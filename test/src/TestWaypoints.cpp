@@ -233,6 +233,39 @@ TestGetNearest(const Waypoints &waypoints, const GeoPoint &center)
   ok1(waypoint->original_id == 6);
 }
 
+static bool
+IsLandable(const Waypoint &waypoint)
+{
+  return waypoint.IsLandable();
+}
+
+static void
+TestGetNearestList(const Waypoints &waypoints, const GeoPoint &center)
+{
+  const Waypoint *nearest[8];
+
+  ok1(waypoints.GetNearest(center, fixed(1000000), nearest, 0) == 0);
+
+  ok1(waypoints.GetNearest(center, fixed(1000000), nearest, 5) == 5);
+  ok1(nearest[0]->original_id == 0 && nearest[1]->original_id == 1 &&
+      nearest[2]->original_id == 2 && nearest[3]->original_id == 3 &&
+      nearest[4]->original_id == 4);
+
+  ok1(waypoints.GetNearest(center, fixed(2500), nearest, 8) == 3);
+  ok1(nearest[0]->original_id == 0 && nearest[1]->original_id == 1 &&
+      nearest[2]->original_id == 2);
+
+  ok1(waypoints.GetNearest(center, fixed(1000000), nearest, 4,
+                           IsLandable) == 4);
+  ok1(nearest[0]->original_id == 0 && nearest[1]->original_id == 3 &&
+      nearest[2]->original_id == 6 && nearest[3]->original_id == 7);
+
+  const GeoPoint far = GeoVector(fixed(750), Angle::Degrees(15))
+    .EndPoint(center);
+  ok1(waypoints.GetNearest(far, fixed(10000), nearest, 2) == 2);
+  ok1(nearest[0]->original_id == 1 && nearest[1]->original_id == 0);
+}
+
 static void
 TestIterator(const Waypoints &waypoints)
 {
@@ -300,7 +333,7 @@ main(int argc, char** argv)
   if (!ParseArgs(argc, argv))
     return 0;
 
-  plan_tests(52);
+  plan_tests(61);
 
   Waypoints waypoints;
   GeoPoint center(Angle::Degrees(51.4), Angle::Degrees(7.85));
@@ -316,6 +349,7 @@ main(int argc, char** argv)
   TestNamePrefixVisitor(waypoints);
   TestRangeVisitor(waypoints, center);
   TestGetNearest(waypoints, center);
+  TestGetNearestList(waypoints, center);
   TestIterator(waypoints);
 
   ok(TestCopy(waypoints), "waypoint copy", 0);
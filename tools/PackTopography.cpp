@@ -0,0 +1,81 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program converts the topography of a map file (topology.tpl
+ * and the shapefiles it refers to) into the preprocessed format
+ * described in src/Topography/PackedTopography.hpp.  XCSoar loads
+ * it instead of the shapefiles if it is stored next to the map file,
+ * with the extension ".xtp" instead of ".xcm".
+ *
+ * The thinning levels are computed for Layout::Scale(1)==1, i.e. for
+ * displays with normal pixel density.
+ */
+
+#include "Topography/TopographyStore.hpp"
+#include "Topography/PackedTopographyWriter.hpp"
+#include "IO/ZipLineReader.hpp"
+#include "Operation/Operation.hpp"
+
+#include <zzip/zzip.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+int
+main(int argc, char **argv)
+{
+  if (argc != 3) {
+    fprintf(stderr, "Usage: %s MAPFILE.xcm OUTPUT.xtp\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  const char *map_path = argv[1], *output_path = argv[2];
+
+  ZZIP_DIR *dir = zzip_dir_open(map_path, NULL);
+  if (dir == NULL) {
+    fprintf(stderr, "Failed to open %s\n", map_path);
+    return EXIT_FAILURE;
+  }
+
+  ZipLineReaderA reader(dir, "topology.tpl");
+  if (reader.error()) {
+    fprintf(stderr, "No topography in %s\n", map_path);
+    zzip_dir_close(dir);
+    return EXIT_FAILURE;
+  }
+
+  TopographyStore topography;
+  NullOperationEnvironment operation;
+  topography.Load(operation, reader, NULL, dir);
+  zzip_dir_close(dir);
+
+  topography.LoadAll();
+
+  if (!WritePackedTopography(topography, output_path)) {
+    fprintf(stderr, "Failed to write %s\n", output_path);
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}